@@ -1,4 +1,5 @@
 const runSuites = require("./run-benchmarks");
+const validateFastMath = runSuites.validateFastMath;
 const barChart = require("./chart.ts");
 
 const output = document.querySelector("#output");
@@ -34,7 +35,8 @@ function printSummary() {
 
 const runButton = document.querySelector("#run");
 const run5TimesButton = document.querySelector("#run-5x");
-const buttons = [runButton,  run5TimesButton];
+const validateFastMathButton = document.querySelector("#validate-fast-math");
+const buttons = [runButton,  run5TimesButton, validateFastMathButton];
 const progress = document.querySelector("#progress-bar");
 
 function progressHandler(current, total) {
@@ -92,6 +94,26 @@ run5TimesButton.addEventListener("click", function () {
     startBenchmark(5);
 });
 
+validateFastMathButton.addEventListener("click", function () {
+    buttons.forEach(button => button.disabled = "disabled");
+    output.textContent = json.textContent = "";
+    progress.style.width = "0%";
+    progress.parentNode.attributes.removeNamedItem("hidden");
+
+    validateFastMath(progressHandler)
+        .then(drifts => {
+            for (const drift of drifts) {
+                output.innerHTML += `${drift.name}: strict ${drift.strict}, fast math ${drift.relaxed} (relative drift ${drift.relativeDrift.toExponential(2)})<br/>`;
+            }
+
+            progress.style.width = "100%";
+            output.innerHTML += "Done!";
+            json.textContent = JSON.stringify(drifts, undefined, "  ");
+            buttons.forEach(button => button.disabled = undefined);
+        })
+        .catch(error => console.error(error));
+});
+
 function benchmarkToChartResults(result) {
     const browserId = result.platform.description;
     const browsers = [ { id: browserId, name: result.platform.name + " " + result.platform.version }];
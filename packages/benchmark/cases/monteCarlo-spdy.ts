@@ -1,5 +1,38 @@
+/**
+ * Simulates the development of a portfolio over the given number of years. The yearly performance is
+ * normal distributed (approximated by the sum of 12 uniform distributed random numbers).
+ * @param numRuns the number of simulations
+ * @param numYears the number of years to simulate
+ * @return the mean of the simulated portfolio values at the end of the last year
+ */
+export async function monteCarlo(numRuns: int, numYears: int) {
+    "use speedyjs";
+
+    speedyJsSeedRandom(10);
+
+    const investmentAmount = 1000000.0;
+    let sum = 0.0;
+
+    for (let run = 0; run < numRuns; ++run) {
+        let value = investmentAmount;
+
+        for (let year = 0; year < numYears; ++year) {
+            value = Math.round(value * (1.0 + normal(0.02, 0.1)));
+        }
 
-export async function monteCarlo() {
+        sum += value;
+    }
+
+    return sum / numRuns;
+}
+
+function normal(mean: number, standardDeviation: number) {
     "use speedyjs";
-    return 0;
+
+    let sum = 0.0;
+    for (let i = 0; i < 12; ++i) {
+        sum += Math.random();
+    }
+
+    return mean + (sum - 6.0) * standardDeviation;
 }
@@ -0,0 +1,50 @@
+#include <cmath>
+#include <cstdint>
+
+// xorshift128+ generator, the initial state is equal to speedyJsSeedRandom(10)
+static uint64_t state0 = 0x088712be8a582fcaULL;
+static uint64_t state1 = 0xbbff7c596e26ce46ULL;
+
+static double nextRandom() {
+    uint64_t s1 = state0;
+    const uint64_t s0 = state1;
+
+    state0 = s0;
+    s1 ^= s1 << 23;
+    state1 = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+
+    return static_cast<double>((state1 + s0) >> 11) * (1.0 / 9007199254740992.0);
+}
+
+static double normal(double mean, double standardDeviation) {
+    double sum = 0.0;
+    for (int i = 0; i < 12; ++i) {
+        sum += nextRandom();
+    }
+
+    return mean + (sum - 6.0) * standardDeviation;
+}
+
+extern "C" {
+
+    double monteCarlo(int numRuns, int numYears) {
+        state0 = 0x088712be8a582fcaULL;
+        state1 = 0xbbff7c596e26ce46ULL;
+
+        const double investmentAmount = 1000000.0;
+        double sum = 0.0;
+
+        for (int run = 0; run < numRuns; ++run) {
+            double value = investmentAmount;
+
+            for (int year = 0; year < numYears; ++year) {
+                // equal to Math.round for positive values
+                value = std::floor(value * (1.0 + normal(0.02, 0.1)) + 0.5);
+            }
+
+            sum += value;
+        }
+
+        return sum / numRuns;
+    }
+}
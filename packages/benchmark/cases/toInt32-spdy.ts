@@ -0,0 +1,11 @@
+export async function toInt32(count: int) {
+    "use speedyjs";
+
+    let hash = 0;
+    for (let i = 0; i < count; ++i) {
+        const value = i * 0.75 - count * 0.5;
+        hash = (hash * 31 + (value | 0)) | 0;
+    }
+
+    return hash;
+}
@@ -0,0 +1,14 @@
+#include <cstdint>
+
+extern "C" {
+
+    int toInt32(int count) {
+        uint32_t hash = 0;
+        for (int i = 0; i < count; ++i) {
+            const double value = i * 0.75 - count * 0.5;
+            hash = hash * 31 + static_cast<uint32_t>(static_cast<int32_t>(value));
+        }
+
+        return static_cast<int32_t>(hash);
+    }
+}
@@ -21,6 +21,10 @@ const TEST_CASES = {
         args: [],
         result: 500074.11491760757
     },
+    "monteCarlo": {
+        args: [100000, 10],
+        result: 1219771.98323
+    },
     "simjs": {
         args: [10, 1000],
         result: 969.1866817441974
@@ -74,6 +78,10 @@ const TEST_CASES = {
         args: [2548965],
         result: 2548965
     },
+    "toInt32": {
+        args: [10000000],
+        result: -1978687958
+    },
     "arrayReverse": {
         args: [],
         result: 1248.9035770674525
@@ -95,11 +103,12 @@ function getJsFunctionForTestCase(caseName) {
 }
 
 const wasmModules = require.context("!speedyjs-loader?{speedyJS:{unsafe: true, exportGc: true, disableHeapNukeOnExit: true, optimizationLevel: 3, binaryenOpt: true}}!./cases", false, /.*-spdy\.ts/);
-function getWasmFunctionForTestCase(caseName) {
+const fastMathWasmModules = require.context("!speedyjs-loader?{speedyJS:{unsafe: true, exportGc: true, disableHeapNukeOnExit: true, optimizationLevel: 3, binaryenOpt: true, fastMath: true}}!./cases", false, /.*-spdy\.ts/);
+function getWasmFunctionForTestCase(caseName, modules = wasmModules) {
     const testCase = TEST_CASES[caseName];
     const fnName = testCase.fnName || caseName;
 
-    const wasmModule = wasmModules("./" + caseName + "-spdy.ts");
+    const wasmModule = modules("./" + caseName + "-spdy.ts");
     const fn = wasmModule[fnName];
     const gc = wasmModule["speedyJsGc"];
 
@@ -247,6 +256,42 @@ function runSuites(numRuns = 1, beforeRun, progress) {
     return Promise.resolve(1).then(processNext);
 }
 
+/**
+ * Runs each test case once with the strict and the fast math build of the wasm module and computes by how much the
+ * result of the fast math build drifts from the result of the strict build.
+ * @param progress callback that is called before a test case is validated
+ * @return {Promise<Array>} for each test case the results of both builds, the absolute and the relative drift
+ */
+async function validateFastMath(progress) {
+    const caseNames = Object.keys(TEST_CASES);
+    const drifts = [];
+
+    for (let i = 0; i < caseNames.length; ++i) {
+        const caseName = caseNames[i];
+        progress(i, caseNames.length);
+
+        const strictFn = getWasmFunctionForTestCase(caseName);
+        const strict = await strictFn.fn();
+        strictFn.gc();
+
+        const relaxedFn = getWasmFunctionForTestCase(caseName, fastMathWasmModules);
+        const relaxed = await relaxedFn.fn();
+        relaxedFn.gc();
+
+        if (typeof(strict) === "number") {
+            const absoluteDrift = Math.abs(relaxed - strict);
+            const relativeDrift = strict === 0 ? absoluteDrift : absoluteDrift / Math.abs(strict);
+            drifts.push({ name: caseName, strict, relaxed, absoluteDrift, relativeDrift });
+        } else {
+            const drift = deepEqual(strict, relaxed) ? 0 : Infinity;
+            drifts.push({ name: caseName, strict, relaxed, absoluteDrift: drift, relativeDrift: drift });
+        }
+    }
+
+    return drifts;
+}
+
 module.exports = runSuites;
+module.exports.validateFastMath = validateFastMath;
 
 
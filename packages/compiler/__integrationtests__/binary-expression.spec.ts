@@ -101,6 +101,21 @@ async function powInts(base: int, exponent: int) {
     return base ** exponent;
 }
 
+async function powNumberInt(base: number, exponent: int) {
+    "use speedyjs";
+    return base ** exponent;
+}
+
+async function powConstantExponent(base: number) {
+    "use speedyjs";
+    return base ** 5;
+}
+
+async function powSquare(base: number) {
+    "use speedyjs";
+    return base ** 2;
+}
+
 async function powNumbers(base: number, exponent: number) {
     "use speedyjs";
     return base ** exponent;
@@ -382,6 +397,66 @@ async function multipleNumberAssignment(value: number) {
     return x + y + z;
 }
 
+async function uintEqualInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintEqualInt(x, y);
+}
+
+function isUintEqualInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x === y;
+}
+
+async function uintNotEqualInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintNotEqualInt(x, y);
+}
+
+function isUintNotEqualInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x !== y;
+}
+
+async function uintGreaterThanInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintGreaterThanInt(x, y);
+}
+
+function isUintGreaterThanInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x > y;
+}
+
+async function uintGreaterThanEqualsInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintGreaterThanEqualsInt(x, y);
+}
+
+function isUintGreaterThanEqualsInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x >= y;
+}
+
+async function uintLessThanInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintLessThanInt(x, y);
+}
+
+function isUintLessThanInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x < y;
+}
+
+async function uintLessThanEqualsInt(x: int, y: int) {
+    "use speedyjs";
+    return isUintLessThanEqualsInt(x, y);
+}
+
+function isUintLessThanEqualsInt(x: uint, y: int): boolean {
+    "use speedyjs";
+    return x <= y;
+}
+
 describe("BinaryExpression", () => {
     describe("+", () => {
        it("adds two ints", async function(cb) {
@@ -494,6 +569,36 @@ describe("BinaryExpression", () => {
             cb();
         });
 
+        it("computes the power of an int with a zero, large or negative int exponent", async (cb) => {
+            expect(await powInts(7, 0)).toBe(1);
+            expect(await powInts(2, 62)).toBe(2 ** 62);
+            expect(await powInts(2, 100)).toBe(2 ** 100);
+            expect(await powInts(2, -3)).toBe(0.125);
+            cb();
+        });
+
+        it("computes the power of a number to the base of an int", async (cb) => {
+            expect(await powNumberInt(3.045091376480036, 39)).toBe(Math.pow(3.045091376480036, 39));
+            expect(await powNumberInt(0.1, 7)).toBe(Math.pow(0.1, 7));
+            expect(await powNumberInt(1.1, -5)).toBe(Math.pow(1.1, -5));
+            expect(await powNumberInt(-0.5, 3)).toBe(-0.125);
+            expect(await powNumberInt(NaN, 0)).toBe(1);
+            cb();
+        });
+
+        it("computes the power for a constant int exponent", async (cb) => {
+            expect(await powConstantExponent(2.718281828459045)).toBe(Math.pow(2.718281828459045, 5));
+            expect(await powConstantExponent(0.3)).toBe(Math.pow(0.3, 5));
+            expect(await powConstantExponent(-Infinity)).toBe(-Infinity);
+            cb();
+        });
+
+        it("computes the square of a number", async (cb) => {
+            expect(await powSquare(0.1)).toBe(Math.pow(0.1, 2));
+            expect(await powSquare(NaN)).toBeNaN();
+            cb();
+        });
+
         it("computes the power of a number to the base of a number", async (cb) => {
             const result = await powNumbers(5.0, 3.5);
             expect(result).toBe(5.0 ** 3.5);
@@ -812,6 +917,27 @@ describe("BinaryExpression", () => {
         });
     });
 
+    describe("uint compared to int", () => {
+        // -1 as uint is 4294967295 that is neither equal to nor less than the int -1
+        it("compares the mathematical values of the operands", async (cb) => {
+            expect(await uintEqualInt(-1, -1)).toBe(false);
+            expect(await uintNotEqualInt(-1, -1)).toBe(true);
+            expect(await uintGreaterThanInt(-1, -1)).toBe(true);
+            expect(await uintGreaterThanEqualsInt(-1, -1)).toBe(true);
+            expect(await uintLessThanInt(-1, -1)).toBe(false);
+            expect(await uintLessThanEqualsInt(-1, -1)).toBe(false);
+            cb();
+        });
+
+        it("orders negative ints before any uint", async (cb) => {
+            expect(await uintGreaterThanInt(0, -2147483648)).toBe(true);
+            expect(await uintLessThanEqualsInt(0, -2147483648)).toBe(false);
+            expect(await uintEqualInt(3, 3)).toBe(true);
+            expect(await uintLessThanInt(3, 4)).toBe(true);
+            cb();
+        });
+    });
+
     describe("x % y", () => {
         it("returns the int remainder", async (cb) => {
             expect(await intRemainder(5, 3)).toBe(5 % 3);
@@ -828,6 +954,15 @@ describe("BinaryExpression", () => {
             expect(await numberRemainder(-5, -1.4)).toBe(-5 % -1.4);
             cb();
         });
+
+        it("returns the floating point remainder for special values", async (cb) => {
+            expect(await numberRemainder(5, 0)).toBeNaN();
+            expect(await numberRemainder(Infinity, 2)).toBeNaN();
+            expect(await numberRemainder(5.5, Infinity)).toBe(5.5);
+            expect(Object.is(await numberRemainder(-4, 2), -0)).toBe(true);
+            expect(await numberRemainder(1e300, 3.7)).toBe(1e300 % 3.7);
+            cb();
+        });
     });
 
     describe("single assignment", () => {
@@ -65,6 +65,88 @@ class ClassWithFieldsOfDifferentSize {
     otherFlag: boolean;
 }
 
+class ClassWithFieldsNotOrderedByAlignment {
+    flag: boolean;
+    value: number;
+    count: int;
+    otherFlag: boolean;
+}
+
+abstract class Shape {
+    constructor(public scale: number) {
+        "use speedyjs";
+    }
+
+    area() {
+        "use speedyjs";
+
+        return 0.0;
+    }
+
+    scaledArea() {
+        "use speedyjs";
+
+        return this.area() * this.scale;
+    }
+}
+
+class Square extends Shape {
+    constructor(public side: number) {
+        "use speedyjs";
+
+        super(2.0);
+    }
+
+    area() {
+        "use speedyjs";
+
+        return this.side * this.side;
+    }
+}
+
+class Rectangle extends Shape {
+    constructor(public width: number, public height: number) {
+        "use speedyjs";
+
+        super(1.0);
+    }
+
+    area() {
+        "use speedyjs";
+
+        return this.width * this.height;
+    }
+}
+
+class Cube extends Square {
+    area() {
+        "use speedyjs";
+
+        return 6.0 * super.area();
+    }
+}
+
+class Pair<T> {
+    constructor(public first: T, public second: T) {}
+
+    swap(): Pair<T> {
+        "use speedyjs";
+        return new Pair(this.second, this.first);
+    }
+}
+
+class Vector {
+    x: number;
+    y: number;
+
+    constructor(x: number, y: number) {
+        "use value";
+
+        this.x = x;
+        this.y = y;
+    }
+}
+
 async function createInstanceOfClassWithoutConstructor() {
     "use speedyjs";
 
@@ -176,6 +258,16 @@ async function updateFieldsOfClassWithFieldsOfDifferentSize(instance: ClassWithF
     return instance;
 }
 
+async function updateFieldsOfClassWithFieldsNotOrderedByAlignment(instance: ClassWithFieldsNotOrderedByAlignment) {
+    "use speedyjs";
+
+    instance.flag = !instance.flag;
+    instance.value = instance.value * 2.0;
+    instance.count = instance.count + 1;
+    instance.otherFlag = !instance.otherFlag;
+    return instance;
+}
+
 async function updateInstance(instance: ClassWithFieldsOfDifferentSize) {
     "use speedyjs";
 
@@ -185,6 +277,88 @@ async function updateInstance(instance: ClassWithFieldsOfDifferentSize) {
     return instance.value;
 }
 
+function scaledAreaOf(shape: Shape) {
+    "use speedyjs";
+
+    return shape.scaledArea();
+}
+
+async function scaledAreaOfSquare(side: number) {
+    "use speedyjs";
+
+    return scaledAreaOf(new Square(side));
+}
+
+async function scaledAreaOfRectangle(width: number, height: number) {
+    "use speedyjs";
+
+    return scaledAreaOf(new Rectangle(width, height));
+}
+
+async function scaledAreaOfCube(side: number) {
+    "use speedyjs";
+
+    return scaledAreaOf(new Cube(side));
+}
+
+async function sideOfCube(side: number) {
+    "use speedyjs";
+
+    const cube = new Cube(side);
+    return cube.side * cube.scale;
+}
+
+async function swapNumberPair(first: number, second: number) {
+    "use speedyjs";
+
+    const swapped = new Pair(first, second).swap();
+    return swapped.first - swapped.second;
+}
+
+async function swapIntPair(first: int, second: int) {
+    "use speedyjs";
+
+    const swapped = new Pair<int>(first, second).swap();
+    return swapped.first - swapped.second;
+}
+
+function translate(vector: Vector, dx: number): Vector {
+    "use speedyjs";
+
+    vector.x += dx;
+    return vector;
+}
+
+async function modifyAssignedValueObject(x: number) {
+    "use speedyjs";
+
+    const original = new Vector(x, 0.0);
+    const copy = original;
+    copy.x = 100.0;
+
+    return [original.x, copy.x];
+}
+
+async function modifyValueObjectPassedAsArgument(x: number) {
+    "use speedyjs";
+
+    const original = new Vector(x, 0.0);
+    const translated = translate(original, 10.0);
+
+    return [original.x, translated.x];
+}
+
+async function modifyReturnedValueObject(x: number) {
+    "use speedyjs";
+
+    const original = new Vector(x, 0.0);
+    const returned = translate(original, 0.0);
+    returned.x = 100.0;
+    returned.y = 200.0;
+
+    return [original.x, original.y, returned.x, returned.y];
+}
+
 describe("Classes", () => {
     describe("new", () => {
         it("creates a new instance using the default constructor", async (cb) => {
@@ -261,6 +435,23 @@ describe("Classes", () => {
             cb();
         });
 
+        it("converts the fields of an object whose fields are reordered by their alignment", async (cb) => {
+            const instance = new ClassWithFieldsNotOrderedByAlignment();
+            instance.flag = true;
+            instance.value = 21.5;
+            instance.count = 4;
+            instance.otherFlag = false;
+
+            const returned = await updateFieldsOfClassWithFieldsNotOrderedByAlignment(instance);
+
+            expect(returned.flag).toBe(false);
+            expect(returned.value).toBe(43);
+            expect(returned.count).toBe(5);
+            expect(returned.otherFlag).toBe(true);
+
+            cb();
+        });
+
         it("returns the value as copy and does not exist an existing reference", async (cb) => {
             const instance = new ClassWithFieldsOfDifferentSize();
             const returned = await updateFieldsOfClassWithFieldsOfDifferentSize(instance);
@@ -346,6 +537,49 @@ describe("Classes", () => {
         });
     });
 
+    describe("inheritance", () => {
+        it("calls the constructor of the base class", async (cb) => {
+            expect(await sideOfCube(3)).toBe(6);
+            cb();
+        });
+
+        it("calls the implementation of the dynamic type of the object", async (cb) => {
+            expect(await scaledAreaOfSquare(3)).toBe(18);
+            expect(await scaledAreaOfRectangle(3, 2)).toBe(6);
+            cb();
+        });
+
+        it("calls the implementation of the base class for methods called on super", async (cb) => {
+            expect(await scaledAreaOfCube(3)).toBe(108);
+            cb();
+        });
+    });
+
+    describe("generic classes", () => {
+        it("instantiates the class for each type argument", async (cb) => {
+            expect(await swapNumberPair(1.5, 4)).toBe(2.5);
+            expect(await swapIntPair(1, 4)).toBe(3);
+            cb();
+        });
+    });
+
+    describe("value classes", () => {
+        it("copies the object on assignment", async (cb) => {
+            expect(await modifyAssignedValueObject(1.0)).toEqual([1.0, 100.0]);
+            cb();
+        });
+
+        it("passes the object as copy to the callee", async (cb) => {
+            expect(await modifyValueObjectPassedAsArgument(1.0)).toEqual([1.0, 11.0]);
+            cb();
+        });
+
+        it("returns the object as copy from the callee", async (cb) => {
+            expect(await modifyReturnedValueObject(1.0)).toEqual([1.0, 0.0, 100.0, 200.0]);
+            cb();
+        });
+    });
+
     describe("properties", () => {
         it("assigns values to the properties", async (cb) => {
             const instance = await createInstanceAndAssignValuesToAttributes(10, 20);
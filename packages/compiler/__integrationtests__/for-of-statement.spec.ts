@@ -0,0 +1,66 @@
+async function sumOf(values: number[]) {
+    "use speedyjs";
+
+    let sum = 0.0;
+    for (const value of values) {
+        sum += value;
+    }
+
+    return sum;
+}
+
+async function pushInBody(values: int[]) {
+    "use speedyjs";
+
+    let count = 0;
+    for (const value of values) {
+        if (value < 3) {
+            values.push(value + 3);
+        }
+        ++count;
+    }
+
+    return count;
+}
+
+async function pushInComparator(values: int[]) {
+    "use speedyjs";
+
+    const other = [3, 1, 2];
+    let sum = 0;
+
+    for (const value of values) {
+        let pushed = false;
+
+        // The comparator grows the iterated array and reallocates its elements
+        other.sort((a, b) => {
+            if (!pushed && values.length < 40) {
+                values.push(value + 10);
+                pushed = true;
+            }
+            return a - b as number;
+        });
+
+        sum += value;
+    }
+
+    return sum;
+}
+
+describe("ForOfStatement", () => {
+    it("iterates over all elements of the array", async (cb) => {
+        expect(await sumOf([1.5, 2.5, 3.5])).toBe(7.5);
+        expect(await sumOf([])).toBe(0);
+        cb();
+    });
+
+    it("visits the elements pushed by the loop body", async (cb) => {
+        expect(await pushInBody([1, 2, 3])).toBe(5);
+        cb();
+    });
+
+    it("visits the elements pushed by a closure called by the loop body", async (cb) => {
+        expect(await pushInComparator([1, 2, 3])).toBe(2549);
+        cb();
+    });
+});
@@ -73,12 +73,51 @@ async function forBreakToLabel() {
     return result;
 }
 
+async function forWithNumberCounter(values: number[]) {
+    "use speedyjs";
+
+    let sum = 0.0;
+    for (let i: number = 0; i < values.length; ++i) {
+        sum += values[i] + i / 2;
+    }
+
+    return sum;
+}
+
+async function forWithNumberCountdown(values: int[], end: int) {
+    "use speedyjs";
+
+    let result = 0;
+    for (let i: number = values.length - 1; i > end; --i) {
+        result = result * 10 + values[i];
+    }
+
+    return result;
+}
+
 describe("ForStatement", () => {
     it("loops till the condition is false", async (cb) => {
         expect(await simpleFor()).toBe(9);
         cb();
     });
 
+    describe("number counter", () => {
+        it("uses a number counter as array index", async (cb) => {
+            expect(await forWithNumberCounter([1.5, 2.5, 3.5])).toBe(9);
+            cb();
+        });
+
+        it("computes arithmetic with the counter as number", async (cb) => {
+            expect(await forWithNumberCounter([0, 0, 0, 0])).toBe(3);
+            cb();
+        });
+
+        it("counts down with a number counter", async (cb) => {
+            expect(await forWithNumberCountdown([1, 2, 3], -1)).toBe(321);
+            cb();
+        });
+    });
+
     describe("continue", () => {
         it("skips the succeeding for statements after a continue statement", async (cb) => {
             expect(await forContinue()).toBe(384);
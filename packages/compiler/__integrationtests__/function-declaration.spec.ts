@@ -32,6 +32,155 @@ function max(first: number, ...others: number[]) {
     return largest;
 }
 
+async function spreadAfterSideEffect() {
+    "use speedyjs";
+
+    const values = [1.5, 2.5];
+    return max(pushValue(values, 1000), ...values);
+}
+
+function pushValue(values: number[], value: number) {
+    "use speedyjs";
+
+    values.push(value);
+    return 0.0;
+}
+
+async function constantFunctionCalls() {
+    "use speedyjs";
+
+    return solarMass() * daysPerYear();
+}
+
+function solarMass() {
+    "use speedyjs";
+
+    return 4 * Math.PI * Math.PI;
+}
+
+function daysPerYear() {
+    "use speedyjs";
+
+    return 365.24;
+}
+
+async function constantIntOverflow(value: int) {
+    "use speedyjs";
+
+    return squareInt(100000) === squareInt(value);
+}
+
+function squareInt(value: int): int {
+    "use speedyjs";
+
+    return value * value;
+}
+
+async function constantLoop() {
+    "use speedyjs";
+
+    return sumTo(100);
+}
+
+function sumTo(end: int): int {
+    "use speedyjs";
+
+    let sum = 0;
+    for (let i = 1; i <= end; ++i) {
+        sum += i;
+    }
+
+    return sum;
+}
+
+async function constantUintComparison() {
+    "use speedyjs";
+
+    return isPositiveUint(-1 as int);
+}
+
+function isPositiveUint(value: uint): boolean {
+    "use speedyjs";
+
+    return value > 0;
+}
+
+async function constantUintConversion() {
+    "use speedyjs";
+
+    return uintToNumber(-1 as int);
+}
+
+function uintToNumber(value: uint): number {
+    "use speedyjs";
+
+    return value;
+}
+
+async function tailRecursiveGcd(a: int, b: int) {
+    "use speedyjs";
+
+    return gcd(a, b);
+}
+
+function gcd(a: int, b: int): int {
+    "use speedyjs";
+
+    if (b === 0) {
+        return a;
+    }
+
+    return gcd(b, a % b);
+}
+
+async function deepSelfRecursion(depth: int) {
+    "use speedyjs";
+
+    return sumRecursive(depth);
+}
+
+function sumRecursive(value: int): int {
+    "use speedyjs";
+
+    if (value === 0) {
+        return 0;
+    }
+
+    return sumRecursive(value - 1) + value;
+}
+
+async function recursiveFactorial(value: int) {
+    "use speedyjs";
+
+    return factorial(value);
+}
+
+function factorial(value: int): int {
+    "use speedyjs";
+
+    if (value <= 1) {
+        return 1;
+    }
+
+    return value * factorial(value - 1);
+}
+
+async function genericMinimum(a: number, b: int) {
+    "use speedyjs";
+
+    return min(a, 2.5) + min<int>(b, 3);
+}
+
+function min<T>(a: T, b: T): T {
+    "use speedyjs";
+
+    if (a < b) {
+        return a;
+    }
+
+    return b;
+}
+
 describe("FunctionDeclaration", () => {
     describe("passing arrays", () => {
        it("arrays can be passed between speedyJS functions", async (cb) => {
@@ -45,5 +194,58 @@ describe("FunctionDeclaration", () => {
             expect(await variadicFunctionCall()).toBe(3949.4);
             cb();
         });
+
+        it("evaluates the arguments in front of a spread array first", async (cb) => {
+            expect(await spreadAfterSideEffect()).toBe(1000);
+            cb();
+        });
+    });
+
+    describe("constant function calls", () => {
+        it("evaluates calls to pure functions with constant arguments", async (cb) => {
+            expect(await constantFunctionCalls()).toBe(4 * Math.PI * Math.PI * 365.24);
+            cb();
+        });
+
+        it("wraps around int arithmetic as the generated code does", async (cb) => {
+            expect(await constantIntOverflow(100000)).toBe(true);
+            cb();
+        });
+
+        it("evaluates loops", async (cb) => {
+            expect(await constantLoop()).toBe(5050);
+            cb();
+        });
+
+        it("converts int arguments to uint parameters as the generated code does", async (cb) => {
+            expect(await constantUintComparison()).toBe(true);
+            expect(await constantUintConversion()).toBe(4294967295);
+            cb();
+        });
+    });
+
+    describe("self recursion", () => {
+        it("replaces tail calls with a loop", async (cb) => {
+            expect(await tailRecursiveGcd(1071, 462)).toBe(21);
+            cb();
+        });
+
+        it("does not exhaust the stack for deep linear recursions", async (cb) => {
+            expect(await deepSelfRecursion(1000000)).toBe(1784293664); // wrapped around 500000500000
+            cb();
+        });
+
+        it("accumulates the result of multiplying recursions", async (cb) => {
+            expect(await recursiveFactorial(10)).toBe(3628800);
+            cb();
+        });
+    });
+
+    describe("generic functions", () => {
+        it("instantiates the function for each type argument", async (cb) => {
+            expect(await genericMinimum(1.5, 5)).toBe(4.5);
+            expect(await genericMinimum(4.5, 1)).toBe(3.5);
+            cb();
+        });
     });
 });
@@ -25,9 +25,40 @@ async function getEvenNumbers(array: int[]) {
     return filter(array, isEven);
 }
 
+function createAdders(count: int) {
+    "use speedyjs";
+
+    const adders = new Array<(value: int) => int>();
+    for (let i = 0; i < count; ++i) {
+        const offset = i * 10;
+        adders.push((value: int) => value + offset);
+    }
+
+    return adders;
+}
+
+async function callStoredClosures(count: int) {
+    "use speedyjs";
+
+    const adders = createAdders(count);
+    const results = new Array<int>();
+
+    // tslint:disable-next-line:prefer-for-of
+    for (let i = 0; i < adders.length; ++i) {
+        results.push(adders[i](1));
+    }
+
+    return results;
+}
+
 describe("Function References", () => {
     it("can invoke a function passed as argument", async (cb) => {
         expect(await getEvenNumbers([1, 2, 3, 4])).toEqual([2, 4]);
         cb();
     });
+
+    it("can call closures stored in an array after the function creating them returned", async (cb) => {
+        expect(await callStoredClosures(4)).toEqual([1, 11, 21, 31]);
+        cb();
+    });
 });
@@ -0,0 +1,125 @@
+// int64 values are passed to JavaScript as BigInts, not part of the es2015 lib
+declare function BigInt(value: number | string): any;
+
+async function addInt64(a: int64, b: int64) {
+    "use speedyjs";
+
+    return a + b;
+}
+
+async function multiplyInt64(a: int64, b: int64) {
+    "use speedyjs";
+
+    return a * b;
+}
+
+async function divideInt64(a: int64, b: int64) {
+    "use speedyjs";
+
+    return a / b;
+}
+
+async function int64ToNumber(value: int64) {
+    "use speedyjs";
+
+    return value as number;
+}
+
+async function sumInt64(values: int64[]) {
+    "use speedyjs";
+
+    let sum = 0 as int64;
+    for (let i = 0; i < values.length; ++i) {
+        sum += values[i];
+    }
+
+    return sum;
+}
+
+async function squareAll(values: int64[]) {
+    "use speedyjs";
+
+    const result = new Array<int64>();
+    for (let i = 0; i < values.length; ++i) {
+        result.push(values[i] * values[i]);
+    }
+
+    return result;
+}
+
+async function constantInt64Overflow() {
+    "use speedyjs";
+
+    return isProductZero(65536 as int, 65536 as int, 65536 as int, 65536 as int);
+}
+
+function isProductZero(a: int64, b: int64, c: int64, d: int64): boolean {
+    "use speedyjs";
+
+    return a * b * c * d === 0;
+}
+
+async function largeInt64Literals() {
+    "use speedyjs";
+
+    const greaterThan2Pow53: int64 = 9007199254740993;
+    const maxInt64: int64 = 0x7FFFFFFFFFFFFFFF;
+    return [greaterThan2Pow53, maxInt64];
+}
+
+describe("int64", () => {
+    describe("literals", () => {
+        it("keeps the exact value of literals greater than 2^53", async (cb) => {
+            expect((await largeInt64Literals()).map(String)).toEqual(["9007199254740993", "9223372036854775807"]);
+            cb();
+        });
+    });
+
+
+    describe("arithmetic", () => {
+        it("computes exact results beyond 2^53", async (cb) => {
+            expect(String(await addInt64(9007199254740992, 1))).toBe("9007199254740993");
+            expect(String(await multiplyInt64(BigInt("3037000499"), BigInt("3037000499")))).toBe("9223372030926249001");
+            cb();
+        });
+
+        it("truncates the fraction of the division", async (cb) => {
+            expect(String(await divideInt64(-7, 2))).toBe("-3");
+            cb();
+        });
+
+        it("wraps around on overflow", async (cb) => {
+            expect(String(await addInt64(BigInt("9223372036854775807"), 1))).toBe("-9223372036854775808");
+            expect(String(await multiplyInt64(BigInt("4611686018427387904"), 4))).toBe("0");
+            cb();
+        });
+
+        it("wraps around in calls evaluated at compile time", async (cb) => {
+            expect(await constantInt64Overflow()).toBe(true);
+            cb();
+        });
+    });
+
+    describe("JavaScript boundary", () => {
+        it("returns int64 values as BigInt", async (cb) => {
+            expect(typeof await addInt64(1, 2)).toBe("bigint");
+            cb();
+        });
+
+        it("accepts numbers and BigInts as arguments", async (cb) => {
+            expect(String(await addInt64(BigInt("-5"), 3))).toBe("-2");
+            cb();
+        });
+
+        it("converts int64 to number", async (cb) => {
+            expect(await int64ToNumber(BigInt("-42"))).toBe(-42);
+            cb();
+        });
+
+        it("passes int64 arrays in both directions", async (cb) => {
+            expect(String(await sumInt64([BigInt("9007199254740993"), 2, BigInt("-1")]))).toBe("9007199254740994");
+            expect((await squareAll([3, BigInt("-4294967296")])).map(String)).toEqual(["9", "0"]);
+            cb();
+        });
+    });
+});
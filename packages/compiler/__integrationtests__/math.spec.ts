@@ -16,6 +16,12 @@ async function pow(base: number, exp: number) {
     return Math.pow(base, exp);
 }
 
+async function round(value: number) {
+    "use speedyjs";
+
+    return Math.round(value);
+}
+
 async function log(value: number) {
     "use speedyjs";
 
@@ -46,6 +52,103 @@ async function maxInt(a: int, b: int, c: int) {
     return Math.max(a, b, c);
 }
 
+async function maxOfArray(values: number[]) {
+    "use speedyjs";
+
+    return Math.max(...values);
+}
+
+async function minOfArray(values: number[]) {
+    "use speedyjs";
+
+    return Math.min(...values);
+}
+
+async function maxOfIntArray(values: int[]) {
+    "use speedyjs";
+
+    return Math.max(...values);
+}
+
+async function random() {
+    "use speedyjs";
+
+    return Math.random();
+}
+
+async function seededRandom(seed: int) {
+    "use speedyjs";
+
+    speedyJsSeedRandom(seed);
+    return Math.random() + Math.random() * 2.0;
+}
+
+async function e() {
+    "use speedyjs";
+
+    return Math.E;
+}
+
+async function abs(value: number) {
+    "use speedyjs";
+
+    return Math.abs(value);
+}
+
+async function ceil(value: number) {
+    "use speedyjs";
+
+    return Math.ceil(value);
+}
+
+async function trunc(value: number) {
+    "use speedyjs";
+
+    return Math.trunc(value);
+}
+
+async function sign(value: number) {
+    "use speedyjs";
+
+    return Math.sign(value);
+}
+
+async function exp(value: number) {
+    "use speedyjs";
+
+    return Math.exp(value);
+}
+
+async function atan2(y: number, x: number) {
+    "use speedyjs";
+
+    return Math.atan2(y, x);
+}
+
+async function hypot(a: number, b: number, c: number) {
+    "use speedyjs";
+
+    return Math.hypot(a, b, c);
+}
+
+async function imul(a: number, b: number) {
+    "use speedyjs";
+
+    return Math.imul(a, b);
+}
+
+async function clz32(value: number) {
+    "use speedyjs";
+
+    return Math.clz32(value);
+}
+
+async function fround(value: number) {
+    "use speedyjs";
+
+    return Math.fround(value);
+}
+
 describe("Math", () => {
     describe("PI", () => {
         it("returns the value PI", async (cb) => {
@@ -66,6 +169,65 @@ describe("Math", () => {
             expect(await pow(2.34, 34.2)).toBe(Math.pow(2.34, 34.2));
             cb();
         });
+
+        it("computes integer powers", async (cb) => {
+            expect(await pow(2, 10)).toBe(1024);
+            expect(await pow(-3, 3)).toBe(-27);
+            expect(await pow(1.5, -2)).toBe(Math.pow(1.5, -2));
+            expect(await pow(NaN, 0)).toBe(1);
+            expect(await pow(-0, -1)).toBe(-Infinity);
+            cb();
+        });
+
+        it("computes the same integer powers of inexact bases as JavaScript", async (cb) => {
+            const bases = [3.045091376480036, 0.1, 1.0000001, -2.718281828459045, 123.456789, 1e-3];
+            const exponents = [-64, -17, -3, -2, -1, 2, 3, 7, 39, 64];
+
+            for (const base of bases) {
+                for (const exponent of exponents) {
+                    expect(await pow(base, exponent)).toBe(Math.pow(base, exponent));
+                }
+            }
+            cb();
+        });
+
+        it("returns NaN for a base of 1 and an infinite exponent", async (cb) => {
+            expect(await pow(1, Infinity)).toBeNaN();
+            cb();
+        });
+
+        it("computes non finite and large exponents without truncating them to int", async (cb) => {
+            expect(await pow(2, Infinity)).toBe(Infinity);
+            expect(await pow(2, -Infinity)).toBe(0);
+            expect(await pow(0.5, Infinity)).toBe(0);
+            expect(await pow(2, NaN)).toBeNaN();
+            expect(await pow(NaN, NaN)).toBeNaN();
+            expect(await pow(1.000001, 2147483648)).toBe(Math.pow(1.000001, 2147483648));
+            expect(await pow(-1, 4294967296)).toBe(1);
+            expect(await pow(2, -2147483649)).toBe(0);
+            cb();
+        });
+    });
+
+    describe("round", () => {
+        it("rounds ties towards positive infinity", async (cb) => {
+            expect(await round(2.5)).toBe(3);
+            expect(await round(-2.5)).toBe(-2);
+            expect(await round(3.5)).toBe(4);
+            expect(await round(-3.5)).toBe(-3);
+            cb();
+        });
+
+        it("preserves the sign of negative values rounded to zero", async (cb) => {
+            expect(Object.is(await round(-0.4), -0)).toBe(true);
+            expect(Object.is(await round(-0.5), -0)).toBe(true);
+            cb();
+        });
+
+        it("rounds values less than 0.5 down", async (cb) => {
+            expect(await round(0.49999999999999994)).toBe(0);
+            cb();
+        });
     });
 
     describe("log", () => {
@@ -99,5 +261,151 @@ describe("Math", () => {
             expect(await maxInt(11, 22, 100)).toBe(100);
             cb();
         });
+
+        it("returns the max of the elements of a spread array", async (cb) => {
+            const values = [3.5, -1, 8, 22.5, 7, 19, 0.5, 22.25, 4];
+            expect(await maxOfArray(values)).toBe(Math.max(...values));
+            expect(await maxOfIntArray([11, -7, 100, 4, 99, 3])).toBe(100);
+            cb();
+        });
+
+        it("returns -Infinity for an empty array", async (cb) => {
+            expect(await maxOfArray([])).toBe(-Infinity);
+            cb();
+        });
+
+        it("returns NaN if any value is NaN", async (cb) => {
+            expect(await maxOfArray([1, 2, 3, 4, NaN, 6, 7])).toBeNaN();
+            cb();
+        });
+
+        it("considers +0 to be larger than -0", async (cb) => {
+            expect(await maxOfArray([-0, -1, 0, -0, -2])).toBe(0);
+            expect(await maxOfArray([-0, -1, -0, -2])).toBe(-0);
+            cb();
+        });
+    });
+
+    describe("min", () => {
+        it("returns the min of the elements of a spread array", async (cb) => {
+            const values = [3.5, -1, 8, 22.5, 7, -19, 0.5, 22.25, 4];
+            expect(await minOfArray(values)).toBe(Math.min(...values));
+            cb();
+        });
+
+        it("returns NaN if any value is NaN", async (cb) => {
+            expect(await minOfArray([NaN, 2, 3])).toBeNaN();
+            cb();
+        });
+
+        it("considers -0 to be smaller than +0", async (cb) => {
+            expect(await minOfArray([0, 1, -0, 0, 2])).toBe(-0);
+            cb();
+        });
+    });
+
+    describe("random", () => {
+        it("returns a number in the range [0, 1)", async (cb) => {
+            for (let i = 0; i < 100; ++i) {
+                const value = await random();
+                expect(value).not.toBeLessThan(0);
+                expect(value).toBeLessThan(1);
+            }
+            cb();
+        });
+
+        it("returns the same sequence for the same seed", async (cb) => {
+            expect(await seededRandom(42)).toBe(await seededRandom(42));
+            expect(await seededRandom(42)).not.toBe(await seededRandom(43));
+            cb();
+        });
+    });
+
+    describe("E", () => {
+        it("returns the value E", async (cb) => {
+            expect(await e()).toBe(Math.E);
+            cb();
+        });
+    });
+
+    describe("abs", () => {
+        it("returns the absolute value", async (cb) => {
+            expect(await abs(-3.5)).toBe(3.5);
+            expect(await abs(2)).toBe(2);
+            cb();
+        });
+    });
+
+    describe("ceil", () => {
+        it("rounds towards positive infinity", async (cb) => {
+            expect(await ceil(1.2)).toBe(2);
+            expect(Object.is(await ceil(-0.5), -0)).toBe(true);
+            cb();
+        });
+    });
+
+    describe("trunc", () => {
+        it("removes the fractional digits", async (cb) => {
+            expect(await trunc(1.7)).toBe(1);
+            expect(await trunc(-1.7)).toBe(-1);
+            cb();
+        });
+    });
+
+    describe("sign", () => {
+        it("returns the sign of the value", async (cb) => {
+            expect(await sign(-3)).toBe(-1);
+            expect(await sign(3)).toBe(1);
+            expect(Object.is(await sign(-0), -0)).toBe(true);
+            expect(await sign(NaN)).toBeNaN();
+            cb();
+        });
+    });
+
+    describe("exp", () => {
+        it("computes e to the power of the value", async (cb) => {
+            expect(await exp(2.5)).toBeCloseTo(Math.exp(2.5), 12);
+            cb();
+        });
+    });
+
+    describe("atan2", () => {
+        it("computes the angle of the point", async (cb) => {
+            expect(await atan2(1, -1)).toBeCloseTo(Math.atan2(1, -1), 12);
+            cb();
+        });
+    });
+
+    describe("hypot", () => {
+        it("computes the square root of the sum of squares", async (cb) => {
+            expect(await hypot(3, 4, 12)).toBe(13);
+            expect(await hypot(1e300, 1e300, 0)).toBeCloseTo(Math.hypot(1e300, 1e300), -290);
+            expect(await hypot(NaN, Infinity, 1)).toBe(Infinity);
+            cb();
+        });
+    });
+
+    describe("imul", () => {
+        it("computes the 32 bit integer product", async (cb) => {
+            expect(await imul(0xffffffff, 5)).toBe(Math.imul(0xffffffff, 5));
+            expect(await imul(0x7fffffff, 3)).toBe(Math.imul(0x7fffffff, 3));
+            cb();
+        });
+    });
+
+    describe("clz32", () => {
+        it("counts the leading zero bits", async (cb) => {
+            expect(await clz32(1)).toBe(31);
+            expect(await clz32(0)).toBe(32);
+            expect(await clz32(-1)).toBe(0);
+            cb();
+        });
+    });
+
+    describe("fround", () => {
+        it("rounds to single precision", async (cb) => {
+            expect(await fround(5.05)).toBe(Math.fround(5.05));
+            cb();
+        });
     });
 });
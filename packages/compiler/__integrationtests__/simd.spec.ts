@@ -0,0 +1,126 @@
+async function float64x2Lanes(x: number, y: number) {
+    "use speedyjs";
+
+    const vector = Float64x2.div(Float64x2.sub(Float64x2.of(x, y), Float64x2.splat(1.0)), Float64x2.splat(2.0));
+    return [Float64x2.extractLane(vector, 0), Float64x2.extractLane(vector, 1)];
+}
+
+async function float64x2MinMaxSum(x: number, y: number) {
+    "use speedyjs";
+
+    const a = Float64x2.of(x, y);
+    const b = Float64x2.of(y, x);
+    return Float64x2.sum(Float64x2.mul(Float64x2.min(a, b), Float64x2.max(a, b)));
+}
+
+async function int32x4Lanes(x: int) {
+    "use speedyjs";
+
+    const vector = Int32x4.xor(Int32x4.mul(Int32x4.add(Int32x4.of(x, 1, 2, 3), Int32x4.splat(1)), Int32x4.of(1, 2, 3, 4)), Int32x4.splat(1));
+    return [Int32x4.extractLane(vector, 0), Int32x4.extractLane(vector, 1), Int32x4.extractLane(vector, 2), Int32x4.extractLane(vector, 3)];
+}
+
+async function int32x4ReplaceLane(lane: int, value: int) {
+    "use speedyjs";
+
+    const vector = Int32x4.replaceLane(Int32x4.splat(0), lane, value);
+    return [Int32x4.extractLane(vector, 0), Int32x4.extractLane(vector, 1), Int32x4.extractLane(vector, 2), Int32x4.extractLane(vector, 3)];
+}
+
+async function int32x4Shuffle(s0: int, s1: int, s2: int, s3: int) {
+    "use speedyjs";
+
+    const vector = Int32x4.shuffle(Int32x4.of(0, 1, 2, 3), Int32x4.of(10, 11, 12, 13), s0, s1, s2, s3);
+    return [Int32x4.extractLane(vector, 0), Int32x4.extractLane(vector, 1), Int32x4.extractLane(vector, 2), Int32x4.extractLane(vector, 3)];
+}
+
+async function int32x4Swizzle() {
+    "use speedyjs";
+
+    return Int32x4.extractLane(Int32x4.swizzle(Int32x4.of(0, 1, 2, 3), 3, 2, 1, 0), 0);
+}
+
+async function float64x2AddInPlace(values: number[], index: int) {
+    "use speedyjs";
+
+    Float64x2.store(values, index, Float64x2.add(Float64x2.load(values, index), Float64x2.splat(1.0)));
+    return values;
+}
+
+async function int32x4SumOf(values: int[]) {
+    "use speedyjs";
+
+    let sum = Int32x4.splat(0);
+    for (let i = 0; i < values.length; i += 4) {
+        sum = Int32x4.add(sum, Int32x4.load(values, i));
+    }
+
+    return Int32x4.sum(sum);
+}
+
+describe("SIMD", () => {
+    describe("float64x2", () => {
+        it("computes the lanes independently", async (cb) => {
+            expect(await float64x2Lanes(5.0, -3.0)).toEqual([2.0, -2.0]);
+            cb();
+        });
+
+        it("computes the lane-wise minimum and maximum", async (cb) => {
+            expect(await float64x2MinMaxSum(1.5, 4.0)).toBe(12.0);
+            cb();
+        });
+    });
+
+    describe("int32x4", () => {
+        it("computes the lanes independently", async (cb) => {
+            expect(await int32x4Lanes(4)).toEqual([4, 5, 8, 17]);
+            cb();
+        });
+
+        it("wraps around on overflow", async (cb) => {
+            expect((await int32x4Lanes(2147483647))[0]).toBe(-2147483647);
+            cb();
+        });
+    });
+
+    describe("lanes", () => {
+        it("replaces the selected lane", async (cb) => {
+            expect(await int32x4ReplaceLane(2, 42)).toEqual([0, 0, 42, 0]);
+            cb();
+        });
+
+        it("takes the lane index modulo the number of lanes", async (cb) => {
+            expect(await int32x4ReplaceLane(5, 42)).toEqual([0, 42, 0, 0]);
+            cb();
+        });
+
+        it("selects the lanes of both vectors by shuffle", async (cb) => {
+            expect(await int32x4Shuffle(7, 0, 5, 2)).toEqual([13, 0, 11, 2]);
+            cb();
+        });
+
+        it("reorders the lanes by swizzle", async (cb) => {
+            expect(await int32x4Swizzle()).toBe(3);
+            cb();
+        });
+    });
+
+    describe("load and store", () => {
+        it("loads and stores consecutive elements", async (cb) => {
+            expect(await float64x2AddInPlace([1.0, 2.0, 3.0], 1)).toEqual([1.0, 3.0, 4.0]);
+            expect(await int32x4SumOf([1, 2, 3, 4, 5, 6, 7, 8])).toBe(36);
+            cb();
+        });
+
+        it("loads a zero vector if the elements are out of bounds", async (cb) => {
+            expect(await int32x4SumOf([1, 2, 3, 4, 5, 6])).toBe(10);
+            cb();
+        });
+
+        it("does not store elements out of bounds", async (cb) => {
+            expect(await float64x2AddInPlace([1.0, 2.0, 3.0], 2)).toEqual([1.0, 2.0, 3.0]);
+            expect(await float64x2AddInPlace([1.0, 2.0, 3.0], -1)).toEqual([1.0, 2.0, 3.0]);
+            cb();
+        });
+    });
+});
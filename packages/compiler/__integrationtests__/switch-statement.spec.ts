@@ -0,0 +1,206 @@
+async function switchFallThrough(opcode: int) {
+    "use speedyjs";
+
+    let result = 0;
+
+    switch (opcode) {
+        case 0:
+        case 1:
+            result = 1;
+            break;
+        case 2:
+            result = 2;
+        default:
+            result += 10;
+    }
+
+    return result;
+}
+
+async function switchWithDefaultInTheMiddle(opcode: int) {
+    "use speedyjs";
+
+    let result = 0;
+
+    switch (opcode) {
+        case 1:
+            result = 1;
+            break;
+        default:
+            result = 10;
+        case 2:
+            result += 2;
+            break;
+        case 3:
+            result = 3;
+    }
+
+    return result;
+}
+
+async function switchWithLoopInCase(opcode: int, count: int) {
+    "use speedyjs";
+
+    let sum = 0;
+
+    switch (opcode) {
+        case 1:
+            for (let i = 0; i < 100; ++i) {
+                if (i === count) {
+                    break; // leaves the loop but not the switch
+                }
+
+                sum += i;
+            }
+
+            sum += 100;
+            break;
+        default:
+            sum = -1;
+    }
+
+    return sum;
+}
+
+async function switchInLoop(count: int) {
+    "use speedyjs";
+
+    let sum = 0;
+
+    for (let i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0:
+                continue; // continues the loop
+            case 1:
+                sum += i;
+                break;
+            default:
+                sum -= 1;
+        }
+
+        sum += 1;
+    }
+
+    return sum;
+}
+
+async function labeledBreakOutOfSwitch(opcode: int, count: int) {
+    "use speedyjs";
+
+    let sum = 0;
+
+    // tslint:disable-next-line
+    outer: switch (opcode) {
+        case 1:
+            for (let i = 0; i < 100; ++i) {
+                if (i === count) {
+                    break outer;
+                }
+
+                sum += i;
+            }
+
+            sum += 100;
+            break;
+        default:
+            sum = -1;
+    }
+
+    return sum;
+}
+
+async function intSwitchWithNumberCase(value: int, caseValue: number) {
+    "use speedyjs";
+
+    switch (value) {
+        case caseValue:
+            return 1;
+        case 2:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+async function numberSwitchWithIntCases(value: number) {
+    "use speedyjs";
+
+    switch (value) {
+        case 0:
+            return 1;
+        case 2:
+            return 2;
+        default:
+            return 0;
+    }
+}
+
+describe("SwitchStatement", () => {
+    describe("fall through", () => {
+        it("executes the statements of the matching case", async (cb) => {
+            expect(await switchFallThrough(0)).toBe(1);
+            expect(await switchFallThrough(1)).toBe(1);
+            cb();
+        });
+
+        it("falls through to the next clause if the clause does not end with a break", async (cb) => {
+            expect(await switchFallThrough(2)).toBe(12);
+            cb();
+        });
+
+        it("executes the default clause if no case matches", async (cb) => {
+            expect(await switchFallThrough(3)).toBe(10);
+            cb();
+        });
+    });
+
+    describe("default", () => {
+        it("tests all cases before executing a default clause in the middle", async (cb) => {
+            expect(await switchWithDefaultInTheMiddle(1)).toBe(1);
+            expect(await switchWithDefaultInTheMiddle(2)).toBe(2);
+            expect(await switchWithDefaultInTheMiddle(3)).toBe(3);
+            cb();
+        });
+
+        it("falls through from a default clause in the middle to the next clause", async (cb) => {
+            expect(await switchWithDefaultInTheMiddle(4)).toBe(12);
+            cb();
+        });
+    });
+
+    describe("break and continue", () => {
+        it("breaks out of a loop inside of a case without leaving the switch", async (cb) => {
+            expect(await switchWithLoopInCase(1, 4)).toBe(106);
+            expect(await switchWithLoopInCase(2, 4)).toBe(-1);
+            cb();
+        });
+
+        it("continues the enclosing loop from inside of a case", async (cb) => {
+            expect(await switchInLoop(7)).toBe(7);
+            cb();
+        });
+
+        it("breaks out of a labeled switch from a nested loop", async (cb) => {
+            expect(await labeledBreakOutOfSwitch(1, 4)).toBe(6);
+            expect(await labeledBreakOutOfSwitch(1, 200)).toBe(5050);
+            cb();
+        });
+    });
+
+    describe("int and number", () => {
+        it("compares an int value with a number case as number", async (cb) => {
+            expect(await intSwitchWithNumberCase(3, 3)).toBe(1);
+            expect(await intSwitchWithNumberCase(1, 1.5)).toBe(0);
+            expect(await intSwitchWithNumberCase(2, 2.5)).toBe(2);
+            cb();
+        });
+
+        it("compares a number value with int cases using strict equality", async (cb) => {
+            expect(await numberSwitchWithIntCases(2)).toBe(2);
+            expect(await numberSwitchWithIntCases(2.5)).toBe(0);
+            expect(await numberSwitchWithIntCases(-0)).toBe(1);
+            expect(await numberSwitchWithIntCases(NaN)).toBe(0);
+            cb();
+        });
+    });
+});
@@ -0,0 +1,6 @@
+async function arrayUnsafeElementAccess() {
+    "use speedyjs unsafe";
+
+    const array = [1, 2, 3, 4, 5];
+    array[2] = array[2] * 10;
+}
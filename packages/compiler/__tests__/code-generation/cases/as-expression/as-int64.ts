@@ -0,0 +1,7 @@
+export async function asInt64() {
+    "use speedyjs";
+
+    const intAsInt64 = 2 as int64;
+    const numberAsInt64 = 3.5 as int64;
+    const int64AsNumber = intAsInt64 as number;
+}
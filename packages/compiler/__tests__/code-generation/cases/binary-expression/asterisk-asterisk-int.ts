@@ -0,0 +1,5 @@
+async function asteriskAsteriskInt(base: int, exponent: int) {
+    "use speedyjs";
+
+    let power = base ** exponent;
+}
@@ -0,0 +1,8 @@
+async function uintOperations(x: uint, y: uint) {
+    "use speedyjs";
+
+    x / y;
+    x % y;
+    x < y;
+    x >> 1;
+}
@@ -0,0 +1,15 @@
+async function constantFunctionCall(value: int) {
+    "use speedyjs";
+
+    return factorial(5) + factorial(value);
+}
+
+function factorial(value: int): int {
+    "use speedyjs";
+
+    if (value <= 1) {
+        return 1;
+    }
+
+    return value * factorial(value - 1);
+}
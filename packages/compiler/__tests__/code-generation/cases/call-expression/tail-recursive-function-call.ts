@@ -0,0 +1,15 @@
+async function tailRecursiveFunctionCall(a: int, b: int) {
+    "use speedyjs";
+
+    return gcd(a, b);
+}
+
+function gcd(a: int, b: int): int {
+    "use speedyjs";
+
+    if (b === 0) {
+        return a;
+    }
+
+    return gcd(b, a % b);
+}
@@ -0,0 +1,14 @@
+class Parent<T> {
+    value: T;
+}
+
+class Child extends Parent<number> {
+}
+
+async function getValue() {
+    "use speedyjs";
+
+    const child = new Child();
+
+    return child.value;
+}
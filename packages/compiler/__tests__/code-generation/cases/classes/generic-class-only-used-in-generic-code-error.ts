@@ -0,0 +1,18 @@
+class Box<T> {
+    constructor(public value: T) {
+    }
+}
+
+function unbox<T>(value: T): T {
+    "use speedyjs";
+
+    // Box<int> is never created by the type checker as the type is only used inside of the generic function
+    const box = new Box<T>(value);
+    return box.value;
+}
+
+async function unboxInt() {
+    "use speedyjs";
+
+    return unbox<int>(1);
+}
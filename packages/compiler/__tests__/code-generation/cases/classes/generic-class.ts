@@ -0,0 +1,17 @@
+class Box<T> {
+    constructor(public value: T) {
+    }
+
+    get(): T {
+        "use speedyjs";
+
+        return this.value;
+    }
+}
+
+async function boxedValues() {
+    "use speedyjs";
+
+    const numberValue = new Box(1.5).get();
+    const intValue = new Box<int>(2).get();
+}
@@ -0,0 +1,28 @@
+class Vector {
+    x: number;
+    y: number;
+
+    constructor(x: number, y: number) {
+        "use value";
+
+        this.x = x;
+        this.y = y;
+    }
+}
+
+function add(a: Vector, b: Vector) {
+    "use speedyjs";
+
+    return new Vector(a.x + b.x, a.y + b.y);
+}
+
+export async function valueClass(x: number, y: number) {
+    "use speedyjs";
+
+    const a = new Vector(x, y);
+    const b = a;
+    b.x = 1.0;
+
+    const sum = add(a, b);
+    return sum.x + sum.y;
+}
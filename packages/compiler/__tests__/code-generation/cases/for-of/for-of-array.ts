@@ -0,0 +1,10 @@
+async function forOfArray() {
+    "use speedyjs";
+
+    const array = [1, 2, 3];
+    let sum = 0;
+
+    for (const value of array) {
+        sum += value;
+    }
+}
@@ -0,0 +1,11 @@
+async function forOfResizingArray() {
+    "use speedyjs";
+
+    const array = [1, 2, 3];
+
+    for (const value of array) {
+        if (value < 3) {
+            array.push(value + 3);
+        }
+    }
+}
@@ -0,0 +1,10 @@
+async function forWithNumberCounter() {
+    "use speedyjs";
+
+    const array = [1, 2, 3];
+    let x = 0;
+
+    for (let i: number = 0; i < array.length; ++i) {
+        x = array[i];
+    }
+}
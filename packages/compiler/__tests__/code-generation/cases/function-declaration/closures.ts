@@ -2,7 +2,6 @@ async function closures(arg: number) {
     "use speedyjs";
 
     function pow2() {
-        "use speedyjs";
         return arg + arg;
     }
 
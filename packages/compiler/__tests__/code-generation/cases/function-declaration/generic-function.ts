@@ -1,7 +1,8 @@
 async function entry() {
     "use speedyjs";
+
     const numberResult = min(10.0, 12.032);
-    const booleanResult = min(true, false);
+    const intResult = min<int>(10, 12);
 }
 
 function min<T>(a: T, b: T): T {
@@ -0,0 +1,3 @@
+async function unsupportedDirectiveOption() {
+    "use speedyjs fast";
+}
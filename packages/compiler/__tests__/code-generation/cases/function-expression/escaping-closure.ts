@@ -0,0 +1,12 @@
+export async function escapingClosure(x: number) {
+    "use speedyjs";
+
+    const addX = adder(x);
+    return addX(2);
+}
+
+function adder(x: number) {
+    "use speedyjs";
+
+    return (y: number) => x + y;
+}
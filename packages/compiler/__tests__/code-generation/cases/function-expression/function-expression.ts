@@ -1,8 +1,7 @@
-export async function functionExpressionUnsupported() {
+export async function functionExpression() {
     "use speedyjs";
 
     const add = function(x: number, y: number) {
-        "use speedyjs";
         return x + y;
     };
 
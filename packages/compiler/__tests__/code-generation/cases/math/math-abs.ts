@@ -0,0 +1,5 @@
+async function mathAbs() {
+    "use speedyjs";
+
+    Math.abs(2.5);
+}
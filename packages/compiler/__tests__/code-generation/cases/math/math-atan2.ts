@@ -0,0 +1,5 @@
+async function mathAtan2() {
+    "use speedyjs";
+
+    Math.atan2(1.5, 2.5);
+}
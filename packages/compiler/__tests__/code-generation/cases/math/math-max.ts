@@ -0,0 +1,7 @@
+async function mathMax() {
+    "use speedyjs";
+
+    const values: number[] = [];
+
+    Math.max(...values);
+}
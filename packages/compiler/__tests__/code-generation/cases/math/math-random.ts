@@ -0,0 +1,5 @@
+async function mathRandom() {
+    "use speedyjs";
+
+    Math.random();
+}
@@ -0,0 +1,6 @@
+async function float64x2LoadStore(array: number[], index: int) {
+    "use speedyjs";
+
+    const pair = Float64x2.load(array, index);
+    Float64x2.store(array, index + 2, pair);
+}
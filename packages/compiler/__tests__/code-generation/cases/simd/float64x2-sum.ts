@@ -0,0 +1,7 @@
+async function float64x2Sum(x: number, y: number) {
+    "use speedyjs";
+
+    const a = Float64x2.of(x, y);
+    const b = Float64x2.splat(2.5);
+    return Float64x2.sum(Float64x2.mul(a, b));
+}
@@ -0,0 +1,7 @@
+async function int32x4Arithmetic(x: int, y: int) {
+    "use speedyjs";
+
+    const a = Int32x4.of(x, y, 3, 4);
+    const b = Int32x4.splat(2);
+    return Int32x4.sum(Int32x4.min(Int32x4.mul(Int32x4.add(a, b), b), Int32x4.splat(10)));
+}
@@ -0,0 +1,7 @@
+async function int32x4Shuffle(x: int, selector: int) {
+    "use speedyjs";
+
+    const a = Int32x4.of(x, 1, 2, 3);
+    const b = Int32x4.swizzle(a, 3, 2, 1, 0);
+    return Int32x4.extractLane(Int32x4.shuffle(a, b, selector, 5, 6, 7), 3);
+}
@@ -0,0 +1,5 @@
+async function int32x4UnsafeLoadStore(array: int[], index: int) {
+    "use speedyjs unsafe";
+
+    Int32x4.store(array, index, Int32x4.add(Int32x4.load(array, index), Int32x4.splat(1)));
+}
@@ -0,0 +1,18 @@
+async function switchFallThrough(opcode: int) {
+    "use speedyjs";
+
+    let result = 0;
+
+    switch (opcode) {
+        case 0:
+        case 1:
+            result = 1;
+            break;
+        case 2:
+            result = 2;
+        default:
+            result += 10;
+    }
+
+    return result;
+}
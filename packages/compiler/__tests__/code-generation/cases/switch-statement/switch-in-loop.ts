@@ -0,0 +1,21 @@
+async function switchInLoop(count: int) {
+    "use speedyjs";
+
+    let sum = 0;
+
+    for (let i = 0; i < count; ++i) {
+        switch (i % 3) {
+            case 0:
+                continue;
+            case 1:
+                sum += i;
+                break;
+            default:
+                sum -= 1;
+        }
+
+        sum += 1;
+    }
+
+    return sum;
+}
@@ -0,0 +1,6 @@
+export async function int64ExponentLiteral() {
+    "use speedyjs";
+
+    const value: int64 = 1e18;
+    return value;
+}
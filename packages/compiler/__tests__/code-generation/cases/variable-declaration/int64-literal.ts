@@ -0,0 +1,7 @@
+export async function int64Literal() {
+    "use speedyjs";
+
+    const greaterThan2Pow53: int64 = 9007199254740993;
+    const maxInt64: int64 = 0x7FFFFFFFFFFFFFFF;
+    return greaterThan2Pow53 + maxInt64;
+}
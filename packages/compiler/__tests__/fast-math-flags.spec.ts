@@ -0,0 +1,35 @@
+import {addFastMathFlags} from "../src/code-generation/util/fast-math-flags";
+
+describe("addFastMathFlags", () => {
+    const llvmIR = [
+        "define hidden double @sum(double %x, double %y) {",
+        "entry:",
+        "  %add = fadd double %x, %y",
+        "  %cmpLT = fcmp olt double %add, %x",
+        "  %0 = fmul fast double %add, %add",
+        "  ret double %0",
+        "}",
+        "",
+        "define double @\"strict sum\"(double %x, double %y) {",
+        "entry:",
+        "  %add = fdiv double %x, %y",
+        "  ret double %add",
+        "}"
+    ].join("\n");
+
+    it("sets the fast math flags on the floating point instructions of the fast math functions", () => {
+        const lines = addFastMathFlags(llvmIR, name => name === "sum").split("\n");
+
+        expect(lines[2]).toBe("  %add = fadd fast double %x, %y");
+        expect(lines[3]).toBe("  %cmpLT = fcmp fast olt double %add, %x");
+        expect(lines[4]).toBe("  %0 = fmul fast double %add, %add");
+        expect(lines[10]).toBe("  %add = fdiv double %x, %y");
+    });
+
+    it("matches quoted function names", () => {
+        const lines = addFastMathFlags(llvmIR, name => name === "strict sum").split("\n");
+
+        expect(lines[2]).toBe("  %add = fadd double %x, %y");
+        expect(lines[10]).toBe("  %add = fdiv fast double %x, %y");
+    });
+});
@@ -0,0 +1,165 @@
+import * as fs from "fs";
+import * as path from "path";
+import * as ts from "typescript";
+
+const WASM_PAGE_SIZE = 64 * 1024;
+const GLOBAL_BASE = 1024;
+const STATIC_BUMP = 16;
+// the heap starts at the second page
+const TOTAL_STACK = WASM_PAGE_SIZE - GLOBAL_BASE - STATIC_BUMP;
+const DYNAMIC_TOP_PTR = GLOBAL_BASE + STATIC_BUMP;
+
+const loaderSource = ts.transpileModule(
+    fs.readFileSync(path.join(__dirname, "../src/code-generation/per-file/get-wasm-module-function.ts"), "utf-8"),
+    { compilerOptions: { target: ts.ScriptTarget.ES2015 } }
+).outputText;
+
+class ListNode {
+    value: int;
+    next?: ListNode;
+}
+
+const types = {
+    "i32": { primitive: true, fields: [], size: 4, typeArguments: [] },
+    "ListNode": {
+        primitive: false,
+        fields: [{ name: "value", type: "i32", offset: 0 }, { name: "next", type: "ListNode", offset: 4 }],
+        size: 8,
+        constructor: ListNode,
+        typeArguments: []
+    },
+    "Array<i32>": { primitive: false, fields: [], size: 12, constructor: Array, typeArguments: ["i32"] }
+};
+
+interface LoadedModule {
+    loader: any;
+    memory: WebAssemblyMemory;
+    sbrk(increment: number): number;
+}
+
+/**
+ * Evaluates the module loader in a browser like environment. WebAssembly.instantiate is stubbed and returns a module without
+ * exports, the imports passed by the loader (the memory and sbrk) are returned for inspection.
+ */
+function loadModule(options: { initialMemory: number, maximumMemory: number }, Memory: WebAssemblyMemoryConstructor = WebAssembly.Memory): Promise<LoadedModule> {
+    let imports: ImportObject;
+    const webAssembly = {
+        Memory,
+        instantiate(buffer: ArrayBuffer, importObject: ImportObject) {
+            imports = importObject;
+            return Promise.resolve({ instance: { exports: {} } });
+        }
+    };
+
+    const fetch = () => Promise.resolve({ ok: true, arrayBuffer: () => new ArrayBuffer(0) });
+    const moduleLoader = new Function("window", "fetch", "WebAssembly", `${loaderSource}\nreturn __moduleLoader;`)({}, fetch, webAssembly);
+    const loader = moduleLoader("test.wasm", {
+        totalStack: TOTAL_STACK,
+        initialMemory: options.initialMemory,
+        maximumMemory: options.maximumMemory,
+        memoryGrowthFactor: 2,
+        reserveMemory: 0,
+        globalBase: GLOBAL_BASE,
+        staticBump: STATIC_BUMP
+    });
+
+    return loader().then(() => ({ loader, memory: imports.env!.memory, sbrk: imports.env!.sbrk }));
+}
+
+describe("ModuleLoader", () => {
+    describe("maximum memory", () => {
+        it("aligns an unaligned maximum memory down to whole pages", async () => {
+            const { memory, sbrk } = await loadModule({ initialMemory: WASM_PAGE_SIZE, maximumMemory: 3 * WASM_PAGE_SIZE + 100 });
+
+            expect(sbrk(2 * WASM_PAGE_SIZE)).toBe(WASM_PAGE_SIZE);
+            expect(memory.buffer.byteLength).toBe(3 * WASM_PAGE_SIZE);
+            expect(() => sbrk(16)).toThrowError(`Out of memory: Cannot grow memory to ${3 * WASM_PAGE_SIZE + 16} bytes, the maximum memory is ${3 * WASM_PAGE_SIZE} bytes.`);
+        });
+    });
+
+    describe("memory above 2GB", () => {
+        const TWO_GB = 2 ** 31;
+
+        it("grows the memory beyond 2GB if the maximum memory is larger than 2GB", async () => {
+            const { memory, sbrk } = await loadModule({ initialMemory: WASM_PAGE_SIZE, maximumMemory: TWO_GB + 2 * WASM_PAGE_SIZE });
+
+            expect(sbrk(TWO_GB - 16)).toBe(WASM_PAGE_SIZE);
+            expect(sbrk(16)).toBe(TWO_GB + WASM_PAGE_SIZE - 16);
+            expect(memory.buffer.byteLength).toBe(TWO_GB + WASM_PAGE_SIZE);
+        });
+
+        it("reads objects at pointers above 2GB as unsigned pointers", async () => {
+            const { loader, memory } = await loadModule({ initialMemory: TWO_GB + WASM_PAGE_SIZE, maximumMemory: TWO_GB + WASM_PAGE_SIZE });
+            const heap32 = new Int32Array(memory.buffer);
+            const heapU32 = new Uint32Array(memory.buffer);
+
+            heap32[(TWO_GB + 16) >>> 2] = 1;
+            heapU32[(TWO_GB + 20) >>> 2] = TWO_GB + 32;
+            heap32[(TWO_GB + 32) >>> 2] = 2;
+
+            // wasm returns pointers as signed i32 values
+            const list = loader.toJSObject((TWO_GB + 16) | 0, "ListNode", types);
+
+            expect(list).toBeInstanceOf(ListNode);
+            expect(list.value).toBe(1);
+            expect(list.next.value).toBe(2);
+            expect(list.next.next).toBeUndefined();
+        });
+
+        it("reads arrays with elements above 2GB", async () => {
+            const { loader, memory } = await loadModule({ initialMemory: TWO_GB + WASM_PAGE_SIZE, maximumMemory: TWO_GB + WASM_PAGE_SIZE });
+            const heap32 = new Int32Array(memory.buffer);
+            const heapU32 = new Uint32Array(memory.buffer);
+
+            heapU32[(TWO_GB + 64) >>> 2] = TWO_GB + 128; // begin
+            heapU32[(TWO_GB + 68) >>> 2] = TWO_GB + 136; // back
+            heap32[(TWO_GB + 128) >>> 2] = 3;
+            heap32[(TWO_GB + 132) >>> 2] = 4;
+
+            expect(loader.toJSObject((TWO_GB + 64) | 0, "Array<i32>", types)).toEqual([3, 4]);
+        });
+    });
+
+    describe("sbrk", () => {
+        let consoleError: jest.SpyInstance<any>;
+
+        beforeEach(() => {
+            consoleError = jest.spyOn(console, "error").mockImplementation(() => undefined);
+        });
+
+        afterEach(() => {
+            consoleError.mockRestore();
+        });
+
+        it("fails if the heap would wrap around the 32-bit address space", async () => {
+            const { memory, sbrk } = await loadModule({ initialMemory: WASM_PAGE_SIZE, maximumMemory: 0 });
+            new Uint32Array(memory.buffer)[DYNAMIC_TOP_PTR >>> 2] = 2 ** 32 - 2 * WASM_PAGE_SIZE;
+
+            expect(sbrk(2 * WASM_PAGE_SIZE)).toBe(-1);
+            expect(consoleError).toHaveBeenCalledWith("Address space wrap around detected");
+        });
+
+        it("fails if the heap would shrink below zero", async () => {
+            const { sbrk } = await loadModule({ initialMemory: WASM_PAGE_SIZE, maximumMemory: 0 });
+
+            expect(sbrk(-(2 ** 31))).toBe(-1);
+            expect(consoleError).toHaveBeenCalledWith("Address space wrap around detected");
+        });
+
+        it("throws and keeps the heap top if the memory cannot be grown", async () => {
+            function FailingMemory(descriptor: { initial: number, maximum?: number }) {
+                const failingMemory = new WebAssembly.Memory(descriptor);
+                failingMemory.grow = () => { throw new RangeError("Maximum memory size exceeded"); };
+                return failingMemory;
+            }
+
+            const { memory, sbrk } = await loadModule({ initialMemory: WASM_PAGE_SIZE, maximumMemory: 0 }, FailingMemory as any);
+
+            expect(() => sbrk(WASM_PAGE_SIZE)).toThrowError(
+                `Out of memory: Failed to grow memory to ${2 * WASM_PAGE_SIZE} bytes (RangeError: Maximum memory size exceeded).`
+            );
+            expect(new Uint32Array(memory.buffer)[DYNAMIC_TOP_PTR >>> 2]).toBe(WASM_PAGE_SIZE);
+            expect(memory.buffer.byteLength).toBe(WASM_PAGE_SIZE);
+        });
+    });
+});
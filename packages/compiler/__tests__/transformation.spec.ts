@@ -41,6 +41,14 @@ describe("Transformation", () => {
         expectCompiledJSOutputMatchesSnapshot(fibSourceCode, "transform/fib.ts", { initialMemory: 10 * 1024 * 1024 });
     });
 
+    it("passes the configured maximum memory to the module loader", () => {
+        expectCompiledJSOutputMatchesSnapshot(fibSourceCode, "transform/fib.ts", { maximumMemory: 256 * 1024 * 1024 });
+    });
+
+    it("passes the configured memory growth factor and reserved memory to the module loader", () => {
+        expectCompiledJSOutputMatchesSnapshot(fibSourceCode, "transform/fib.ts", { memoryGrowthFactor: 1.5, reserveMemory: 64 * 1024 * 1024 });
+    });
+
     it("passes the configured total stack to the module loader", () => {
         expectCompiledJSOutputMatchesSnapshot(fibSourceCode, "transform/fib.ts", { totalStack: 1 * 1024 * 1024 });
     });
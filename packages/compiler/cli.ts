@@ -24,9 +24,14 @@ interface CommandLineArguments {
     disableHeapNukeOnExit?: boolean;
     exposeGc?: boolean;
     exportGc?: boolean;
+    warmHeap?: boolean;
     optimizationLevel?: "0" | "1" | "2" | "3" | "z" | "s";
+    fastMath?: boolean;
+    memoryGrowthFactor?: number;
     settings: {
         INITIAL_MEMORY?: number;
+        MAXIMUM_MEMORY?: number;
+        RESERVE_MEMORY?: number;
         TOTAL_STACK?: number;
         GLOBAL_BASE?: number;
     };
@@ -53,8 +58,11 @@ function parseCommandLine(): CommandLineArguments {
         .option("--binaryen-opt", "Optimize using Binaryen opt")
         .option("--expose-gc", "Exposes the speedy js garbage collector in the module as speedyJsGc")
         .option("--export-gc", "Exposes and exports the speedy js garbage collector as the symbol speedyJsGc")
+        .option("--warm-heap", "Allocates objects in a warm heap whose memory is reused by subsequent calls of the entry functions")
         .option("--disable-heap-nuke-on-exit", "Disables nuking of the heap before to the exit of the entry function (it's your responsible for calling the GC in this case!)")
         .option("--optimization-level [value]", "The optimization level to use. One of the following values: '0, 1, 2, 3, s or z'")
+        .option("--fast-math", "Optimize floating point operations without preserving the strict IEEE semantics, the results may differ from JavaScript")
+        .option("--memory-growth-factor <factor>", "The factor by which the memory is grown if more memory is needed", parseFloat)
         .option("-s --settings [value]", "additional settings", parseSettings, {})
         .parse(process.argv);
     // tslint:enable:max-line-length
@@ -100,10 +108,15 @@ function getCompilerOptions(commandLine: CommandLineArguments, tsConfigFileName:
     compilerOptions.globalBase = commandLine.settings.GLOBAL_BASE;
     compilerOptions.totalMemory = commandLine.settings.INITIAL_MEMORY;
     compilerOptions.totalStack = commandLine.settings.TOTAL_STACK;
+    compilerOptions.maximumMemory = commandLine.settings.MAXIMUM_MEMORY;
+    compilerOptions.reserveMemory = commandLine.settings.RESERVE_MEMORY;
+    compilerOptions.memoryGrowthFactor = commandLine.memoryGrowthFactor;
     compilerOptions.exposeGc = commandLine.exposeGc;
     compilerOptions.exportGc = commandLine.exportGc;
+    compilerOptions.warmHeap = commandLine.warmHeap;
     compilerOptions.disableHeapNukeOnExit = commandLine.disableHeapNukeOnExit;
     compilerOptions.optimizationLevel = commandLine.optimizationLevel;
+    compilerOptions.fastMath = commandLine.fastMath;
 
     return { rootFileNames, compilerOptions: initializeCompilerOptions(compilerOptions) };
 }
@@ -0,0 +1,107 @@
+/**
+ * Declarations of the intrinsics that are only available inside of speedy.js functions.
+ * The compiler adds this file to every program, there is no need to reference it explicitly.
+ */
+
+/**
+ * Seeds the random number generator used by Math.random. Math.random returns the same sequence of numbers
+ * for the same seed, allowing to reproduce the results of a simulation. The generator is seeded randomly
+ * when the module is loaded.
+ * @param seed the seed
+ */
+declare function speedyJsSeedRandom(seed: int): void;
+
+/**
+ * 64 bit signed integer, e.g. for exact integer arithmetic beyond 2^53. Arithmetic operations of int64 (and int) operands
+ * have an int64 result that wraps around on overflow, the division truncates the fraction. int values are implicitly
+ * converted to int64, number values require an explicit cast (value as int64). int64 values are passed to JavaScript as BigInt.
+ */
+declare type int64 = number & { readonly __int64?: never };
+
+/**
+ * Alias for int64
+ */
+declare type long = int64;
+
+/**
+ * 32 bit unsigned integer, e.g. for hashing and bit manipulations. Arithmetic and bitwise operations of uint (and int) operands
+ * have a uint result that wraps around on overflow, the division truncates the fraction and >> is an unsigned shift.
+ * Comparisons of uint operands are unsigned. Array elements accessed with a uint index require no check for negative indices.
+ * int values are implicitly converted to uint (keeping their bits), number values require an explicit cast (value as uint).
+ * uint values are implicitly converted to number and int64.
+ */
+declare type uint = number & { readonly __uint?: never };
+
+/**
+ * 128 bit vector of two number (float64) lanes, e.g. to process two elements of an array with a single operation.
+ * Vectors are values that are created and combined with the functions of Float64x2.
+ */
+declare interface float64x2 {
+    readonly __float64x2: never;
+}
+
+/**
+ * 128 bit vector of four int (32 bit signed integer) lanes. Arithmetic operations wrap around on overflow.
+ * Vectors are values that are created and combined with the functions of Int32x4.
+ */
+declare interface int32x4 {
+    readonly __int32x4: never;
+}
+
+/**
+ * Operations of the float64x2 vector type. The lane indices of extractLane, replaceLane, swizzle and shuffle are taken
+ * modulo the number of lanes (of both vectors for shuffle). load reads zeros and store is a no-op if the lanes are
+ * out of the array bounds, unless the function is unsafe.
+ */
+declare interface Float64x2Constructor {
+    of(x0: number, x1: number): float64x2;
+    splat(value: number): float64x2;
+    add(a: float64x2, b: float64x2): float64x2;
+    sub(a: float64x2, b: float64x2): float64x2;
+    mul(a: float64x2, b: float64x2): float64x2;
+    div(a: float64x2, b: float64x2): float64x2;
+    neg(a: float64x2): float64x2;
+    /** Lane wise b < a ? b : a */
+    min(a: float64x2, b: float64x2): float64x2;
+    /** Lane wise a < b ? b : a */
+    max(a: float64x2, b: float64x2): float64x2;
+    /** Sum of the lanes */
+    sum(a: float64x2): number;
+    extractLane(a: float64x2, lane: int): number;
+    replaceLane(a: float64x2, lane: int, value: number): float64x2;
+    swizzle(a: float64x2, s0: int, s1: int): float64x2;
+    /** Selects the lanes from the lanes of a (0, 1) followed by the lanes of b (2, 3) */
+    shuffle(a: float64x2, b: float64x2, s0: int, s1: int): float64x2;
+    /** Loads the elements array[index] and array[index + 1] */
+    load(array: number[], index: int): float64x2;
+    /** Stores the lanes of the value in array[index] and array[index + 1] */
+    store(array: number[], index: int, value: float64x2): void;
+}
+
+declare const Float64x2: Float64x2Constructor;
+
+/**
+ * Operations of the int32x4 vector type, see Float64x2Constructor.
+ */
+declare interface Int32x4Constructor {
+    of(x0: int, x1: int, x2: int, x3: int): int32x4;
+    splat(value: int): int32x4;
+    add(a: int32x4, b: int32x4): int32x4;
+    sub(a: int32x4, b: int32x4): int32x4;
+    mul(a: int32x4, b: int32x4): int32x4;
+    neg(a: int32x4): int32x4;
+    and(a: int32x4, b: int32x4): int32x4;
+    or(a: int32x4, b: int32x4): int32x4;
+    xor(a: int32x4, b: int32x4): int32x4;
+    min(a: int32x4, b: int32x4): int32x4;
+    max(a: int32x4, b: int32x4): int32x4;
+    sum(a: int32x4): int;
+    extractLane(a: int32x4, lane: int): int;
+    replaceLane(a: int32x4, lane: int, value: int): int32x4;
+    swizzle(a: int32x4, s0: int, s1: int, s2: int, s3: int): int32x4;
+    shuffle(a: int32x4, b: int32x4, s0: int, s1: int, s2: int, s3: int): int32x4;
+    load(array: int[], index: int): int32x4;
+    store(array: int[], index: int, value: int32x4): void;
+}
+
+declare const Int32x4: Int32x4Constructor;
@@ -1,7 +1,13 @@
+import * as path from "path";
 import * as ts from "typescript";
 
 /**
- * Resolves the symbols of built in Types like Array, string...
+ * Declaration file of the speedy.js intrinsics that is added to each program
+ */
+export const SPEEDYJS_LIB_FILE = path.resolve(__dirname, "../lib/speedyjs.d.ts");
+
+/**
+ * Resolves the symbols of built in Types like Array, string... and of the speedy.js intrinsics
  */
 export class BuiltInSymbols {
     private constructor(private stdLibSymbols: Map<string, ts.Symbol>) {
@@ -30,7 +36,8 @@ export class BuiltInSymbols {
     private static loadStdLibVariables(program: ts.Program, compilerHost: ts.CompilerHost): Map<string, ts.Symbol> {
         const defaultLibFileLocation = compilerHost.getDefaultLibLocation!();
         const symbols = new Map<string, ts.Symbol>();
-        const stdLibFiles = program.getSourceFiles().filter(file => file.fileName.startsWith(defaultLibFileLocation));
+        const speedyJsLibFile = program.getSourceFile(SPEEDYJS_LIB_FILE);
+        const stdLibFiles = program.getSourceFiles().filter(file => file.fileName.startsWith(defaultLibFileLocation) || file === speedyJsLibFile);
         const symbolKinds = ts.SymbolFlags.Variable | ts.SymbolFlags.Interface | ts.SymbolFlags.Function;
 
         for (const lib of stdLibFiles) {
@@ -0,0 +1,276 @@
+import * as ts from "typescript";
+import {TypeChecker} from "./type-checker";
+import {isSpeedyJSFunction} from "./util/speedyjs-function";
+
+/**
+ * A method implementation and the classes for which a call of the method dispatches to this implementation
+ */
+export interface MethodImplementation {
+    /**
+     * The declaration of the implementing method
+     */
+    declaration: ts.MethodDeclaration;
+
+    /**
+     * The symbol of the class that declares the method
+     */
+    declaringClass: ts.Symbol;
+
+    /**
+     * The instantiable classes that use this implementation
+     */
+    classes: ts.Symbol[];
+}
+
+/**
+ * Whole program class hierarchy analysis.
+ *
+ * Classes used by Speedy.js code cannot be extended by code outside of the compiled program. Therefore, all
+ * subclasses of a class are known and it can be computed to which implementations a method call may dispatch.
+ *
+ * Only subclasses that are Speedy.js classes are part of the analysed hierarchy, these are subclasses with a Speedy.js
+ * method or constructor or that are instantiated in a Speedy.js function. Instances of all other subclasses
+ * never reach Speedy.js code as entry functions only accept instances of the declared parameter class.
+ */
+export class ClassHierarchyAnalysis {
+    private baseClasses = new Map<ts.Symbol, ts.Symbol>();
+    private subclasses = new Map<ts.Symbol, ts.Symbol[]>();
+
+    constructor(program: ts.Program, private typeChecker: TypeChecker) {
+        const extendedClasses = new Map<ts.Symbol, ts.Symbol>();
+        const speedyJSClasses = new Set<ts.Symbol>();
+
+        for (const sourceFile of program.getSourceFiles()) {
+            if (!sourceFile.isDeclarationFile) {
+                this.collectClasses(sourceFile, false, extendedClasses, speedyJSClasses);
+            }
+        }
+
+        for (const [classSymbol, baseClass] of Array.from(extendedClasses.entries())) {
+            if (speedyJSClasses.has(classSymbol)) {
+                this.baseClasses.set(classSymbol, baseClass);
+            }
+        }
+
+        // The base classes of a Speedy.js class are part of the hierarchy as well, as instances of the subclass can be upcasted
+        for (const classSymbol of Array.from(this.baseClasses.keys())) {
+            for (let current = classSymbol; extendedClasses.has(current); current = extendedClasses.get(current)!) {
+                this.baseClasses.set(current, extendedClasses.get(current)!);
+            }
+        }
+
+        for (const [classSymbol, baseClass] of Array.from(this.baseClasses.entries())) {
+            this.subclasses.set(baseClass, [...this.getSubclasses(baseClass), classSymbol]);
+        }
+    }
+
+    /**
+     * Returns the class that the given class extends
+     * @param classSymbol the symbol of the class
+     * @return the symbol of the base class or undefined if the class has no base class
+     */
+    getBaseClass(classSymbol: ts.Symbol): ts.Symbol | undefined {
+        return this.baseClasses.get(classSymbol);
+    }
+
+    /**
+     * Returns the classes that directly extend the given class
+     * @param classSymbol the symbol of the class
+     */
+    getSubclasses(classSymbol: ts.Symbol): ts.Symbol[] {
+        return this.subclasses.get(classSymbol) || [];
+    }
+
+    /**
+     * Tests if the class is part of a class hierarchy and, therefore, its instances need to store their dynamic type
+     * @param classSymbol the symbol of the class
+     */
+    isPolymorphic(classSymbol: ts.Symbol): boolean {
+        return this.baseClasses.has(classSymbol) || this.subclasses.has(classSymbol);
+    }
+
+    /**
+     * Tests if the given class is the same as or a (transitive) subclass of the potential base class
+     */
+    isSubclassOf(classSymbol: ts.Symbol, potentialBaseClass: ts.Symbol): boolean {
+        for (let current: ts.Symbol | undefined = classSymbol; current; current = this.getBaseClass(current)) {
+            if (current === potentialBaseClass) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * Returns the instantiable classes an object with the given static type can be an instance of,
+     * the class itself followed by its (transitive) subclasses in declaration order.
+     * @param classSymbol the symbol of the static type
+     */
+    getInstantiableClasses(classSymbol: ts.Symbol): ts.Symbol[] {
+        const result: ts.Symbol[] = [];
+        const toVisit = [classSymbol];
+
+        while (toVisit.length > 0) {
+            const current = toVisit.shift()!;
+            if (!isAbstract(current)) {
+                result.push(current);
+            }
+
+            toVisit.push(...this.getSubclasses(current));
+        }
+
+        return result;
+    }
+
+    /**
+     * Returns the implementations a call of the given method on an object with the given static type may dispatch to
+     * @param classSymbol the static type of the object
+     * @param methodName the name of the called method
+     * @return the implementations, the first is the implementation used by instances of the class itself (if it is instantiable)
+     */
+    getMethodImplementations(classSymbol: ts.Symbol, methodName: string): MethodImplementation[] {
+        const implementations: MethodImplementation[] = [];
+
+        for (const instantiable of this.getInstantiableClasses(classSymbol)) {
+            const declaringClass = this.getDeclaringClass(instantiable, methodName);
+            if (!declaringClass) {
+                continue;
+            }
+
+            const existing = implementations.find(implementation => implementation.declaringClass === declaringClass);
+            if (existing) {
+                existing.classes.push(instantiable);
+            } else {
+                implementations.push(this.getMethodImplementation(instantiable, methodName)!);
+            }
+        }
+
+        return implementations;
+    }
+
+    /**
+     * Returns the implementation of the method used by instances of exactly the given class (e.g. for super.method())
+     * @param classSymbol the class of the object
+     * @param methodName the name of the method
+     * @return the implementation or undefined if the method is not implemented by the class or any base class
+     */
+    getMethodImplementation(classSymbol: ts.Symbol, methodName: string): MethodImplementation | undefined {
+        const declaringClass = this.getDeclaringClass(classSymbol, methodName);
+        if (!declaringClass) {
+            return undefined;
+        }
+
+        return {
+            classes: [classSymbol],
+            declaration: getMethodDeclaration(declaringClass, methodName)!,
+            declaringClass
+        };
+    }
+
+    /**
+     * Returns the class that declares the implementation of the method used by instances of the given class
+     * @param classSymbol the class of the object
+     * @param methodName the name of the method
+     * @return the class that declares the method or undefined if the method is not implemented by the class or any base class
+     */
+    getDeclaringClass(classSymbol: ts.Symbol, methodName: string): ts.Symbol | undefined {
+        for (let current: ts.Symbol | undefined = classSymbol; current; current = this.getBaseClass(current)) {
+            if (getMethodDeclaration(current, methodName)) {
+                return current;
+            }
+        }
+
+        return undefined;
+    }
+
+    private collectClasses(node: ts.Node, inSpeedyJSFunction: boolean, extendedClasses: Map<ts.Symbol, ts.Symbol>, speedyJSClasses: Set<ts.Symbol>) {
+        switch (node.kind) {
+            case ts.SyntaxKind.ClassDeclaration:
+                const classDeclaration = node as ts.ClassDeclaration;
+                const baseClass = this.getExtendedClass(classDeclaration);
+
+                // Extending built in classes is not supported
+                if (classDeclaration.name && baseClass && isClassDeclaredInProgram(baseClass)) {
+                    const classSymbol = this.typeChecker.getSymbolAtLocation(classDeclaration.name);
+                    extendedClasses.set(classSymbol, baseClass);
+
+                    if (classDeclaration.members.some(member => isFunctionWithBody(member) && isSpeedyJSFunction(member as ts.FunctionLikeDeclaration))) {
+                        speedyJSClasses.add(classSymbol);
+                    }
+                }
+                break;
+
+            case ts.SyntaxKind.NewExpression:
+                const instantiated = this.getClassSymbol((node as ts.NewExpression).expression);
+                if (inSpeedyJSFunction && instantiated) {
+                    speedyJSClasses.add(instantiated);
+                }
+                break;
+
+            default:
+                // Functions nested inside of a Speedy.js function are closures compiled as part of the enclosing function
+                if (isFunctionWithBody(node)) {
+                    inSpeedyJSFunction = inSpeedyJSFunction || isSpeedyJSFunction(node as ts.FunctionLikeDeclaration);
+                }
+        }
+
+        ts.forEachChild(node, child => this.collectClasses(child, inSpeedyJSFunction, extendedClasses, speedyJSClasses));
+    }
+
+    private getExtendedClass(classDeclaration: ts.ClassDeclaration): ts.Symbol | undefined {
+        const extendsClause = (classDeclaration.heritageClauses || [] as ts.HeritageClause[])
+            .find(clause => clause.token === ts.SyntaxKind.ExtendsKeyword);
+
+        if (!extendsClause || extendsClause.types.length === 0) {
+            return undefined;
+        }
+
+        return this.getClassSymbol(extendsClause.types[0].expression);
+    }
+
+    private getClassSymbol(expression: ts.Expression): ts.Symbol | undefined {
+        let symbol = this.typeChecker.getSymbolAtLocation(expression);
+        if (symbol && symbol.flags & ts.SymbolFlags.Alias) {
+            symbol = this.typeChecker.getAliasedSymbol(symbol);
+        }
+
+        return symbol;
+    }
+}
+
+function getMethodDeclaration(classSymbol: ts.Symbol, methodName: string): ts.MethodDeclaration | undefined {
+    const classDeclaration = classSymbol.valueDeclaration as ts.ClassDeclaration;
+
+    return classDeclaration.members.find(member => member.kind === ts.SyntaxKind.MethodDeclaration &&
+        !!(member as ts.MethodDeclaration).body &&
+        !hasModifier(member, ts.SyntaxKind.StaticKeyword) &&
+        !!member.name && (member.name as ts.Identifier).text === methodName
+    ) as ts.MethodDeclaration | undefined;
+}
+
+function isFunctionWithBody(node: ts.Node) {
+    switch (node.kind) {
+        case ts.SyntaxKind.FunctionDeclaration:
+        case ts.SyntaxKind.FunctionExpression:
+        case ts.SyntaxKind.ArrowFunction:
+        case ts.SyntaxKind.MethodDeclaration:
+        case ts.SyntaxKind.Constructor:
+            return !!(node as ts.FunctionLikeDeclaration).body;
+        default:
+            return false;
+    }
+}
+
+function isClassDeclaredInProgram(symbol: ts.Symbol) {
+    const declaration = symbol.valueDeclaration;
+    return !!declaration && declaration.kind === ts.SyntaxKind.ClassDeclaration && !declaration.getSourceFile().isDeclarationFile;
+}
+
+function isAbstract(classSymbol: ts.Symbol) {
+    return hasModifier(classSymbol.valueDeclaration!, ts.SyntaxKind.AbstractKeyword);
+}
+
+function hasModifier(node: ts.Node, modifierKind: ts.SyntaxKind) {
+    return (node.modifiers || [] as ts.Modifier[]).some(modifier => modifier.kind === modifierKind);
+}
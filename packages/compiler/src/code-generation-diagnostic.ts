@@ -91,6 +91,18 @@ export class CodeGenerationDiagnostics {
         return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedLiteralType, typeName);
     }
 
+    static unsupportedInt64Literal(node: ts.LiteralLikeNode) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedInt64Literal, node.getText());
+    }
+
+    static uninstantiatedGenericType(node: ts.Node, typeName: string) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UninstantiatedGenericType, typeName, typeName);
+    }
+
+    static unsupportedGenericUnionType(node: ts.Node, typeName: string) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedGenericUnionType, typeName);
+    }
+
     static unsupportedType(node: ts.Declaration, typeName: string) {
         return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedType, typeName);
     }
@@ -221,10 +233,6 @@ export class CodeGenerationDiagnostics {
         throw CodeGenerationDiagnostics.createException(declaration, diagnostics.UnsupportedFunctionDeclaration);
     }
 
-    static unsupportedGenericFunction(functionDeclaration: ts.FunctionLikeDeclaration) {
-        return CodeGenerationDiagnostics.createException(functionDeclaration, diagnostics.UnsupportedGenericFunction);
-    }
-
     static unsupportedStaticProperties(propertyExpression: ts.PropertyAccessExpression) {
         return CodeGenerationDiagnostics.createException(propertyExpression, diagnostics.UnsupportedStaticProperty);
     }
@@ -252,6 +260,50 @@ export class CodeGenerationDiagnostics {
     static entryFunctionWithCallbackNotSupported(parameter: ts.ParameterDeclaration) {
         return CodeGenerationDiagnostics.createException(parameter, diagnostics.UnsupportedEntryFunctionWithCallback);
     }
+
+    static unsupportedPolymorphicObjectInEntryFunction(node: ts.Node, className: string) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedPolymorphicObjectInEntryFunction, className);
+    }
+
+    static unsupportedMethodOverride(method: ts.MethodDeclaration) {
+        return CodeGenerationDiagnostics.createException(method, diagnostics.UnsupportedMethodOverride);
+    }
+
+    static unsupportedReassignmentOfCapturedVariable(assignment: ts.Node, variableName: string) {
+        return CodeGenerationDiagnostics.createException(assignment, diagnostics.UnsupportedReassignmentOfCapturedVariable, variableName);
+    }
+
+    static unsupportedSwitchExpressionType(expression: ts.Expression, typeName: string) {
+        return CodeGenerationDiagnostics.createException(expression, diagnostics.UnsupportedSwitchExpressionType, typeName);
+    }
+
+    static unsupportedForOfIterable(expression: ts.Expression, typeName: string) {
+        return CodeGenerationDiagnostics.createException(expression, diagnostics.UnsupportedForOfIterable, typeName);
+    }
+
+    static unsupportedValueClassInheritance(classDeclaration: ts.ClassDeclaration) {
+        return CodeGenerationDiagnostics.createException(classDeclaration, diagnostics.UnsupportedValueClassInheritance);
+    }
+
+    static unsupportedValueObjectArray(classDeclaration: ts.ClassDeclaration) {
+        return CodeGenerationDiagnostics.createException(classDeclaration, diagnostics.UnsupportedValueObjectArray);
+    }
+
+    static unsupportedValueObjectInEntryFunction(node: ts.Node, className: string) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedValueObjectInEntryFunction, className);
+    }
+
+    static unsupportedSpeedyJSDirectiveOption(directive: ts.ExpressionStatement, option: string) {
+        return CodeGenerationDiagnostics.createException(directive, diagnostics.UnsupportedSpeedyJSDirectiveOption, option);
+    }
+
+    static conflictingSpeedyJSDirectiveOptions(directive: ts.ExpressionStatement, option: string, otherOption: string) {
+        return CodeGenerationDiagnostics.createException(directive, diagnostics.ConflictingSpeedyJSDirectiveOptions, option, otherOption);
+    }
+
+    static unsupportedSIMDVectorInEntryFunction(node: ts.Node, typeName: string) {
+        return CodeGenerationDiagnostics.createException(node, diagnostics.UnsupportedSIMDVectorInEntryFunction, typeName);
+    }
 }
 
 /* tslint:disable:max-line-length */
@@ -356,16 +408,12 @@ const diagnostics = {
         message: "Unsupported implicit cast of value with the type '%s' to the expected type '%s'. An explicit cast of the value to the type '%s' is required.",
         code: 1000024
     },
-    UnsupportedGenericFunction: {
-        message: "Generic functions and methods are not yet supported.",
-        code: 1000025
-    },
     UnsupportedStaticProperty: {
         message: "Static methods and properties are not yet supported.",
         code: 1000026
     },
     UnsupportedNestedFunctionDeclaration: {
-        message: "Functions nested inside of other functions that potentially make use of a closure are not yet supported",
+        message: "Nested functions can only be referenced after their declaration.",
         code: 1000027
     },
     UnsupportedFunctionDeclaration: {
@@ -381,11 +429,11 @@ const diagnostics = {
         code: 1000030
     },
     UnsupportedGenericClass: {
-        message: "Generic classes are not yet supported.",
+        message: "Generic classes cannot be part of a class hierarchy.",
         code: 1000031
     },
     UnsupportedClassInheritance: {
-        message: "Class inheritance is not yet supported.",
+        message: "Classes can only extend non generic classes declared in a Speedy.js program.",
         code: 1000032
     },
     ReferenceToNonSpeedyJSFunctionFromSpeedyJS: {
@@ -395,5 +443,61 @@ const diagnostics = {
     UnsupportedEntryFunctionWithCallback: {
         message: "Passing callbacks to speedy.js entry functions is not yet supported",
         code: 1000034
+    },
+    UnsupportedPolymorphicObjectInEntryFunction: {
+        message: "Instances of the class '%s' cannot be passed to or returned from entry functions because the class is part of a class hierarchy.",
+        code: 1000035
+    },
+    UnsupportedMethodOverride: {
+        message: "Overriding methods need to have the same parameter types as the overridden method and a compatible return type.",
+        code: 1000036
+    },
+    UnsupportedReassignmentOfCapturedVariable: {
+        message: "The variable '%s' cannot be reassigned because it is captured by a function that is used after the enclosing function returns.",
+        code: 1000037
+    },
+    UnsupportedSwitchExpressionType: {
+        message: "Switch statements are only supported for int, number and boolean values but the value is of type '%s'.",
+        code: 1000038
+    },
+    UnsupportedForOfIterable: {
+        message: "for...of loops are only supported for arrays but the iterated value is of type '%s'.",
+        code: 1000039
+    },
+    UnsupportedValueClassInheritance: {
+        message: "Value classes (classes with the \"use value\" directive in the constructor) can neither extend nor be extended by another class.",
+        code: 1000040
+    },
+    UnsupportedValueObjectArray: {
+        message: "Arrays of value objects are not yet supported, the elements of an array are stored as pointers.",
+        code: 1000041
+    },
+    UnsupportedValueObjectInEntryFunction: {
+        message: "Instances of the value class '%s' cannot be passed to or returned from entry functions.",
+        code: 1000042
+    },
+    UnsupportedSpeedyJSDirectiveOption: {
+        message: "The option '%s' of the \"use speedyjs\" directive is not supported. Supported options are unsafe, inline, fastmath, O0, O1, O2, O3, Os and Oz.",
+        code: 1000043
+    },
+    ConflictingSpeedyJSDirectiveOptions: {
+        message: "The options '%s' and '%s' of the \"use speedyjs\" directive cannot be combined.",
+        code: 1000044
+    },
+    UnsupportedSIMDVectorInEntryFunction: {
+        message: "Values of the SIMD vector type '%s' cannot be passed to or returned from entry functions.",
+        code: 1000045
+    },
+    UnsupportedInt64Literal: {
+        message: "The int64 literal '%s' is not an integer or cannot be represented exactly, write it as an integer literal.",
+        code: 1000046
+    },
+    UninstantiatedGenericType: {
+        message: "The type '%s' is only used inside of generic code and, therefore, cannot be instantiated. Use the type outside of generic code, e.g. declare a variable of type '%s'.",
+        code: 1000047
+    },
+    UnsupportedGenericUnionType: {
+        message: "Union types with type parameters other than T | undefined are not supported but the type is '%s'.",
+        code: 1000048
     }
 };
@@ -2,7 +2,7 @@ import * as ts from "typescript";
 import {CompilationContext} from "../compilation-context";
 import {NameMangler, Parameter} from "./name-mangler";
 import {getTypeOfParentObject} from "./util/object-helper";
-import {getCallSignature, isFunctionType, isMaybeObjectType} from "./util/types";
+import {getCallSignature, isFunctionType, isInt64Type, isMaybeObjectType, isUintType} from "./util/types";
 import {createResolvedFunctionFromSignature} from "./value/resolved-function";
 
 /**
@@ -24,20 +24,20 @@ export abstract class BaseNameMangler implements NameMangler {
      */
     protected abstract get separator(): string;
 
-    mangleFunctionName(name: string | undefined, parameters: Parameter[], sourceFile?: ts.SourceFile): string {
+    mangleFunctionName(name: string | undefined, parameters: Parameter[], sourceFile?: ts.SourceFile, typeArguments: ts.Type[] = []): string {
         const parts = [
             this.getModulePrefix(sourceFile),
-            this.getFunctionName(name, parameters)
+            this.getFunctionName(name, parameters, typeArguments)
         ];
 
         return parts.filter(part => !!part).join(this.separator);
     }
 
-    mangleMethodName(clazz: ts.ObjectType, methodName: string, parameters: Parameter[], sourceFile?: ts.SourceFile): string {
+    mangleMethodName(clazz: ts.ObjectType, methodName: string, parameters: Parameter[], sourceFile?: ts.SourceFile, typeArguments: ts.Type[] = []): string {
         const parts = [
             this.getModulePrefix(sourceFile),
             this.getObjectName(clazz),
-            this.getFunctionName(methodName, parameters)
+            this.getFunctionName(methodName, parameters, typeArguments)
         ];
 
         return parts.filter(part => !!part).join(this.separator);
@@ -91,10 +91,11 @@ export abstract class BaseNameMangler implements NameMangler {
         return this.mangleMethodName(classType, name, parameters);
     }
 
-    private getFunctionName(name: string | undefined, parameters: Parameter[]) {
+    private getFunctionName(name: string | undefined, parameters: Parameter[], typeArguments: ts.Type[]) {
         const parameterPostfix = parameters.map(parameter => this.getParameterTypeCode(parameter)).join("");
+        const typeArgumentsPostfix = typeArguments.length > 0 ? `I${typeArguments.map(typeArgument => this.typeToCode(typeArgument)).join("")}E` : "";
         name = name || `$${++this.anonymousFunctionCounter}`;
-        return this.encodeName(name) + parameterPostfix;
+        return this.encodeName(name) + typeArgumentsPostfix + parameterPostfix;
     }
 
     private getObjectName(objectType: ts.ObjectType) {
@@ -122,6 +123,14 @@ export abstract class BaseNameMangler implements NameMangler {
             return "i";
         }
 
+        if (isInt64Type(type)) {
+            return "l";
+        }
+
+        if (isUintType(type)) {
+            return "j";
+        }
+
         if (type.flags & ts.TypeFlags.NumberLike) {
             return "d";
         }
@@ -2,13 +2,13 @@ import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "./code-generation-context";
-import {getCallSignature, isFunctionType, isMaybeObjectType} from "./util/types";
+import {getCallSignature, isFunctionType, isGenericType, isInt64Type, isMaybeObjectType, isSIMDVectorType, isUintType, isValueClassType} from "./util/types";
 import {TypePlace} from "./util/typescript-to-llvm-type-converter";
 import {AddressLValue} from "./value/address-lvalue";
+import {Allocation} from "./value/allocation";
 import {ClassReference} from "./value/class-reference";
-import {FunctionPointer} from "./value/function-reference";
+import {ClosureReference} from "./value/closure-reference";
 import {Primitive} from "./value/primitive";
-import {ResolvedFunctionReference} from "./value/resolved-function-reference";
 import {SpeedyJSClassReference} from "./value/speedy-js-class-reference";
 
 import {Value} from "./value/value";
@@ -50,7 +50,12 @@ export class CodeGenerationContextMixin {
     value(this: CodeGenerationContext, value: llvm.Value, type: ts.Type): Value {
         const symbol = type.getSymbol();
 
-        if (type.flags & (ts.TypeFlags.BooleanLike | ts.TypeFlags.NumberLike | ts.TypeFlags.IntLike)) {
+        if (type.flags & (ts.TypeFlags.BooleanLike | ts.TypeFlags.NumberLike | ts.TypeFlags.IntLike) || isInt64Type(type) || isUintType(type)) {
+            return new Primitive(value, type);
+        }
+
+        // SIMD vectors are first class values like numbers
+        if (isSIMDVectorType(type)) {
             return new Primitive(value, type);
         }
 
@@ -69,11 +74,19 @@ export class CodeGenerationContextMixin {
 
         if (isFunctionType(type)) {
             const signature = getCallSignature(type);
-            return ResolvedFunctionReference.createForSignature(value as FunctionPointer, signature, this);
+            return ClosureReference.createForSignature(value, signature, this);
         }
 
         if (type.flags & ts.TypeFlags.Object) {
             const classReference = this.resolveClass(type as ts.ObjectType);
+
+            // A value object returned by value is stored on the stack to reference it by its address
+            if (classReference && isValueClassType(type) && !value.type.isPointerTy()) {
+                const storage = Allocation.createAllocaInstInEntryBlock(value.type, this, "valueObject");
+                this.builder.createAlignedStore(value, storage, storage.alignment);
+                value = storage;
+            }
+
             if (classReference) {
                 return classReference.objectFor(new AddressLValue(value, type), type as ts.ObjectType, this);
             }
@@ -87,9 +100,15 @@ export class CodeGenerationContextMixin {
             return this.scope.getClass(symbol);
         }
 
+        // Each instantiation of a generic class has its own class reference as the types of the fields differ
+        const key = isGenericType(type) ? type : symbol;
+        if (this.scope.hasClass(key)) {
+            return this.scope.getClass(key);
+        }
+
         if (symbol.flags & ts.SymbolFlags.Class && isClassDefined(type)) {
             const reference = SpeedyJSClassReference.create(type as ts.ObjectType, this);
-            this.scope.addClass(symbol, reference);
+            this.scope.addClass(key, reference);
             return reference;
         }
 
@@ -81,6 +81,17 @@ export interface BaseCodeGenerationContext {
      */
     getEntryFunctionNames(): string[];
 
+    /**
+     * Adds the name of a function whose floating point instructions are emitted with the fast math flags
+     * @param name the name of the function
+     */
+    addFastMathFunction(name: string): void;
+
+    /**
+     * Returns the names of the functions whose floating point instructions are emitted with the fast math flags
+     */
+    getFastMathFunctionNames(): string[];
+
     /**
      * Enters a new child scope
      * @param fn the function to which this scope belongs
@@ -0,0 +1,18 @@
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {ClosureReference} from "../value/closure-reference";
+import {Value} from "../value/value";
+
+/**
+ * Code Generator for an arrow function, creates a closure that captures the referenced variables and the this object of the enclosing function
+ */
+class ArrowFunctionCodeGenerator implements SyntaxCodeGenerator<ts.ArrowFunction, Value> {
+    syntaxKind = ts.SyntaxKind.ArrowFunction;
+
+    generate(arrowFunction: ts.ArrowFunction, context: CodeGenerationContext): Value {
+        return ClosureReference.create(arrowFunction, context);
+    }
+}
+
+export default ArrowFunctionCodeGenerator;
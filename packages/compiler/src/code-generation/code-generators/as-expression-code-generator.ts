@@ -2,6 +2,7 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isInt64Type, isUintType} from "../util/types";
 import {Primitive} from "../value/primitive";
 import {Value} from "../value/value";
 
@@ -18,6 +19,10 @@ class AsExpressionCodeGenerator implements SyntaxCodeGenerator<ts.AsExpression,
             castedValue = new Primitive(Primitive.toBoolean(value, sourceType, context), targetType);
         } else if (targetType.flags & ts.TypeFlags.IntLike) {
             castedValue = Primitive.toInt32(value, sourceType, targetType, context);
+        } else if (isUintType(targetType)) {
+            castedValue = Primitive.toUint32(value, sourceType, targetType, context);
+        } else if (isInt64Type(targetType)) {
+            castedValue = Primitive.toInt64(value, sourceType, targetType, context);
         } else if (targetType.flags & ts.TypeFlags.NumberLike) {
             castedValue = Primitive.toNumber(value, sourceType, targetType, context);
         } else {
@@ -3,7 +3,8 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
-import {isMaybeObjectType} from "../util/types";
+import {FunctionDeclarationBuilder} from "../util/function-declaration-builder";
+import {isInt64Type, isMaybeObjectType, isUintType} from "../util/types";
 import {MathObjectReference} from "../value/math-object-reference";
 import {Primitive} from "../value/primitive";
 import {Value} from "../value/value";
@@ -24,6 +25,37 @@ function isAssignment(operatorToken: ts.BinaryOperatorToken) {
         operatorToken.kind === ts.SyntaxKind.GreaterThanGreaterThanEqualsToken;
 }
 
+function isArithmeticOperator(operator: ts.SyntaxKind) {
+    switch (operator) {
+        case ts.SyntaxKind.PlusToken:
+        case ts.SyntaxKind.PlusEqualsToken:
+        case ts.SyntaxKind.MinusToken:
+        case ts.SyntaxKind.MinusEqualsToken:
+        case ts.SyntaxKind.AsteriskToken:
+        case ts.SyntaxKind.AsteriskEqualsToken:
+        case ts.SyntaxKind.SlashToken:
+        case ts.SyntaxKind.SlashEqualsToken:
+        case ts.SyntaxKind.PercentToken:
+        case ts.SyntaxKind.PercentEqualsToken:
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Tests if the operation is performed with integer instructions, this is the case for int, uint and int64 operands
+ */
+function isIntegerType(type: ts.Type) {
+    return !!(type.flags & ts.TypeFlags.IntLike) || isInt64Type(type) || isUintType(type);
+}
+
+/**
+ * Largest constant exponent for which x ** n is computed by multiplications. The results of larger exponents are not
+ * correctly rounded if computed by squaring and are, therefore, computed by the runtime's pow function.
+ */
+const MAX_UNROLLED_EXPONENT = 2;
+
 /**
  * Code Generator for binary expressions, e.g. 5+3 but also x = 3, or x += 3
  */
@@ -43,8 +75,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // 10.12 & 0
             case ts.SyntaxKind.AmpersandToken:
             case ts.SyntaxKind.AmpersandEqualsToken: {
-                const leftInt = Primitive.toInt32(context.generateValue(binaryExpression.left), leftType, resultType, context).generateIR();
-                const rightInt = Primitive.toInt32(context.generateValue(binaryExpression.right), rightType, resultType, context).generateIR();
+                const [leftInt, rightInt] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
                 result = context.builder.createAnd(leftInt, rightInt, "and");
                 break;
@@ -85,7 +116,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
 
-                if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                if (isIntegerType(unifiedType)) {
                     result = context.builder.createMul(leftIr, rightIr, "mul");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFMul(leftIr, rightIr, "mul");
@@ -99,10 +130,17 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             case ts.SyntaxKind.AsteriskAsteriskEqualsToken: {
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
-                const left = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context);
-                const right = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context);
                 if (unifiedType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.NumberLike)) {
-                    result = MathObjectReference.pow(left, leftType, right, rightType, resultType, context).generateIR(context);
+                    const left = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context);
+                    const constantExponent = BinaryExpressionCodeGenerator.getConstantExponent(binaryExpression.right);
+
+                    if (typeof(constantExponent) !== "undefined") {
+                        const base = Primitive.toNumber(left, unifiedType, resultType, context).generateIR();
+                        result = BinaryExpressionCodeGenerator.unrolledPow(base, constantExponent, context);
+                    } else {
+                        const right = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context);
+                        result = MathObjectReference.pow(left, unifiedType, right, unifiedType, resultType, context).generateIR(context);
+                    }
                 }
 
                 break;
@@ -111,12 +149,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a | b
             case ts.SyntaxKind.BarToken:
             case ts.SyntaxKind.BarEqualsToken: {
-                const intType = resultType;
-                const left = context.generateValue(binaryExpression.left);
-                const lhsIntValue = Primitive.toInt32(left, leftType, intType, context).generateIR();
-
-                const right = context.generateValue(binaryExpression.right);
-                const rhsIntValue = Primitive.toInt32(right, rightType, intType, context).generateIR();
+                const [lhsIntValue, rhsIntValue] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
                 result = context.builder.createOr(lhsIntValue, rhsIntValue, "or");
 
@@ -153,8 +186,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a ^ b
             case ts.SyntaxKind.CaretEqualsToken:
             case ts.SyntaxKind.CaretToken: {
-                const leftInt = Primitive.toInt32(context.generateValue(binaryExpression.left), leftType, resultType, context).generateIR();
-                const rightInt = Primitive.toInt32(context.generateValue(binaryExpression.right), rightType, resultType, context).generateIR();
+                const [leftInt, rightInt] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
                 result = context.builder.createXor(leftInt, rightInt, "xor");
 
@@ -172,13 +204,19 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a === b, a == b
             case ts.SyntaxKind.EqualsEqualsToken:
             case ts.SyntaxKind.EqualsEqualsEqualsToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpEQ(mixedSignOperands[0], mixedSignOperands[1], "cmpEQ");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
 
                 // tslint:disable-next-line: max-line-length
-                if (unifiedType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike | ts.TypeFlags.Object | ts.TypeFlags.Undefined) || isMaybeObjectType(unifiedType)) {
+                if (unifiedType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike | ts.TypeFlags.Object | ts.TypeFlags.Undefined) || isIntegerType(unifiedType) || isMaybeObjectType(unifiedType)) {
                     result = context.builder.createICmpEQ(leftIr, rightIr, "cmpEQ");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpOEQ(leftIr, rightIr, "cmpEQ");
@@ -190,13 +228,19 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a != b, a !== b
             case ts.SyntaxKind.ExclamationEqualsToken:
             case ts.SyntaxKind.ExclamationEqualsEqualsToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpNE(mixedSignOperands[0], mixedSignOperands[1], "cmpNE");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
 
                 // tslint:disable-next-line: max-line-length
-                if (unifiedType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike | ts.TypeFlags.Object | ts.TypeFlags.Undefined) || isMaybeObjectType(unifiedType)) {
+                if (unifiedType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike | ts.TypeFlags.Object | ts.TypeFlags.Undefined) || isIntegerType(unifiedType) || isMaybeObjectType(unifiedType)) {
                     result = context.builder.createICmpNE(leftIr, rightIr, "cmpNE");
                 } else if (leftType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpONE(leftIr, rightIr, "cmpNE");
@@ -207,6 +251,12 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
             // a > b
             case ts.SyntaxKind.GreaterThanToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpSGT(mixedSignOperands[0], mixedSignOperands[1], "cmpGT");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
@@ -215,7 +265,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                     const leftInt = context.builder.createZExt(leftIr, llvm.Type.getInt32Ty(context.llvmContext));
                     const rightInt = context.builder.createZExt(rightIr, llvm.Type.getInt32Ty(context.llvmContext));
                     result = context.builder.createICmpSGT(leftInt, rightInt, "cmpGT");
-                } else if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                } else if (isUintType(unifiedType)) {
+                    result = context.builder.createICmpUGT(leftIr, rightIr, "cmpGT");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createICmpSGT(leftIr, rightIr, "cmpGT");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpOGT(leftIr, rightIr, "cmpGT");
@@ -226,6 +278,12 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
             // a >= b
             case ts.SyntaxKind.GreaterThanEqualsToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpSGE(mixedSignOperands[0], mixedSignOperands[1], "cmpGE");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
@@ -234,7 +292,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                     const leftInt = context.builder.createZExt(leftIr, llvm.Type.getInt32Ty(context.llvmContext));
                     const rightInt = context.builder.createZExt(rightIr, llvm.Type.getInt32Ty(context.llvmContext));
                     result = context.builder.createICmpSGE(leftInt, rightInt, "cmpGE");
-                } else if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                } else if (isUintType(unifiedType)) {
+                    result = context.builder.createICmpUGE(leftIr, rightIr, "cmpGE");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createICmpSGE(leftIr, rightIr, "cmpGE");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpOGE(leftIr, rightIr, "cmpGE");
@@ -246,11 +306,14 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a >> b
             case ts.SyntaxKind.GreaterThanGreaterThanToken:
             case ts.SyntaxKind.GreaterThanGreaterThanEqualsToken: {
-                const leftInt = Primitive.toInt32(context.generateValue(binaryExpression.left), leftType, resultType, context).generateIR();
-                const rightInt = Primitive.toInt32(context.generateValue(binaryExpression.right), rightType, resultType, context).generateIR();
+                const [leftInt, rightInt] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
-                // mask not needed, less than 32 guaranteed by wasm
-                result = context.builder.createAShr(leftInt, rightInt, "ashr");
+                // mask not needed, less than 32 (64 for int64) guaranteed by wasm, >> of a uint is an unsigned shift
+                if (isUintType(resultType)) {
+                    result = context.builder.createLShr(leftInt, rightInt, "lshr");
+                } else {
+                    result = context.builder.createAShr(leftInt, rightInt, "ashr");
+                }
 
                 break;
             }
@@ -258,8 +321,12 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a >>> b
             case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanEqualsToken:
             case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken: {
-                const leftInt = Primitive.toInt32(context.generateValue(binaryExpression.left), leftType, resultType, context).generateIR();
-                const rightInt = Primitive.toInt32(context.generateValue(binaryExpression.right), rightType, resultType, context).generateIR();
+                // BigInts have no unsigned right shift
+                if (isInt64Type(leftType) || isInt64Type(rightType)) {
+                    break;
+                }
+
+                const [leftInt, rightInt] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
                 // mask not needed, less than 32 guaranteed by wasm
                 result = context.builder.createLShr(leftInt, rightInt, "lshr");
@@ -269,6 +336,12 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
             // a < b
             case ts.SyntaxKind.LessThanToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpSLT(mixedSignOperands[0], mixedSignOperands[1], "cmpLT");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
@@ -278,7 +351,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                     const rightInt = context.builder.createZExt(rightIr, llvm.Type.getInt32Ty(context.llvmContext));
 
                     result = context.builder.createICmpSLT(leftInt, rightInt, "cmpLT");
-                } else if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                } else if (isUintType(unifiedType)) {
+                    result = context.builder.createICmpULT(leftIr, rightIr, "cmpLT");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createICmpSLT(leftIr, rightIr, "cmpLT");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpOLT(leftIr, rightIr, "cmpLT");
@@ -289,6 +364,12 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
             // a <= b
             case ts.SyntaxKind.LessThanEqualsToken: {
+                const mixedSignOperands = BinaryExpressionCodeGenerator.toMixedSignOperands(binaryExpression, context);
+                if (mixedSignOperands) {
+                    result = context.builder.createICmpSLE(mixedSignOperands[0], mixedSignOperands[1], "cmpLE");
+                    break;
+                }
+
                 const unifiedType = BinaryExpressionCodeGenerator.unifyTypes(binaryExpression, context);
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
@@ -298,7 +379,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                     const rightInt = context.builder.createZExt(rightIr, llvm.Type.getInt32Ty(context.llvmContext));
 
                     result = context.builder.createICmpSLE(leftInt, rightInt, "cmpLE");
-                } else if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                } else if (isUintType(unifiedType)) {
+                    result = context.builder.createICmpULE(leftIr, rightIr, "cmpLE");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createICmpSLE(leftIr, rightIr, "cmpLE");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFCmpOLE(leftIr, rightIr, "cmpLE");
@@ -310,10 +393,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
             // a << b
             case ts.SyntaxKind.LessThanLessThanToken:
             case ts.SyntaxKind.LessThanLessThanEqualsToken: {
-                const leftInt = Primitive.toInt32(context.generateValue(binaryExpression.left), leftType, resultType, context).generateIR();
-                const rightInt = Primitive.toInt32(context.generateValue(binaryExpression.right), rightType, resultType, context).generateIR();
+                const [leftInt, rightInt] = BinaryExpressionCodeGenerator.toIntegerOperands(binaryExpression, resultType, context);
 
-                // mask not needed, less than 32 guaranteed by wasm
+                // mask not needed, less than 32 (64 for int64) guaranteed by wasm
                 result = context.builder.createShl(leftInt, rightInt, "shl");
 
                 break;
@@ -326,7 +408,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
-                if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                if (isIntegerType(unifiedType)) {
                     result = context.builder.createSub(leftIr, rightIr, "sub");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFSub(leftIr, rightIr, "fsub");
@@ -341,10 +423,21 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
-                if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                if (isUintType(unifiedType)) {
+                    result = context.builder.createURem(leftIr, rightIr, "urem");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createSRem(leftIr, rightIr, "srem");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
-                    result = context.builder.createFRem(leftIr, rightIr, "frem");
+                    // frem is lowered to a call of the imported fmod function, use the in-module implementation of the runtime instead
+                    const fmod = FunctionDeclarationBuilder.create("fmoddd", [
+                        { name: "x", type: unifiedType },
+                        { name: "y", type: unifiedType }
+                    ], unifiedType, context)
+                        .withAttribute(llvm.Attribute.AttrKind.ReadNone)
+                        .withAttribute(llvm.Attribute.AttrKind.AlwaysInline)
+                        .externalLinkage()
+                        .declareIfNotExisting();
+                    result = context.builder.createCall(fmod, [leftIr, rightIr], "frem");
                 }
 
                 break;
@@ -357,7 +450,7 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
-                if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                if (isIntegerType(unifiedType)) {
                     result = context.builder.createAdd(leftIr, rightIr, "add");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFAdd(leftIr, rightIr, "fadd");
@@ -373,7 +466,9 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
                 const leftIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.left, binaryExpression, context).generateIR(context);
                 const rightIr = BinaryExpressionCodeGenerator.toUnified(binaryExpression.right, binaryExpression, context).generateIR(context);
-                if (unifiedType.flags & ts.TypeFlags.IntLike) {
+                if (isUintType(unifiedType)) {
+                    result = context.builder.createUDiv(leftIr, rightIr, "udiv");
+                } else if (isIntegerType(unifiedType)) {
                     result = context.builder.createSDiv(leftIr, rightIr, "sdiv");
                 } else if (unifiedType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFDiv(leftIr, rightIr, "div");
@@ -409,6 +504,79 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
         return resultValue;
     }
 
+    /**
+     * Returns the value of the exponent if it is a non negative integer literal for which the power is computed by multiplications
+     */
+    private static getConstantExponent(exponent: ts.Expression): number | undefined {
+        if (exponent.kind !== ts.SyntaxKind.NumericLiteral) {
+            return undefined;
+        }
+
+        const value = Number((exponent as ts.NumericLiteral).text);
+        return Number.isInteger(value) && value >= 0 && value <= MAX_UNROLLED_EXPONENT ? value : undefined;
+    }
+
+    /**
+     * Computes base ** exponent for a constant exponent in the range [0, MAX_UNROLLED_EXPONENT], e.g. x ** 2 = x * x.
+     * The results are exact or correctly rounded and therefore equal to the results of the runtime's pow function.
+     */
+    private static unrolledPow(base: llvm.Value, exponent: number, context: CodeGenerationContext): llvm.Value {
+        let result: llvm.Value | undefined;
+        let factor = base;
+
+        for (let remaining = exponent; remaining > 0; remaining = remaining >>> 1) {
+            if (remaining & 1) {
+                result = result ? context.builder.createFMul(result, factor, "mul") : factor;
+            }
+
+            if (remaining > 1) {
+                factor = context.builder.createFMul(factor, factor, "square");
+            }
+        }
+
+        // x ** 0 is 1 for any x, even NaN
+        return result || llvm.ConstantFP.get(context.llvmContext, 1);
+    }
+
+    /**
+     * Converts the operands of a bitwise operation to int32 values or to int64 (uint) values if the result is an int64 (uint)
+     */
+    private static toIntegerOperands(binaryExpression: ts.BinaryExpression, resultType: ts.Type, context: CodeGenerationContext) {
+        const convert = isInt64Type(resultType) ? Primitive.toInt64 : isUintType(resultType) ? Primitive.toUint32 : Primitive.toInt32;
+
+        return [binaryExpression.left, binaryExpression.right].map(operand => {
+            const operandType = context.typeChecker.getTypeAtLocation(operand);
+            return convert(context.generateValue(operand), operandType, resultType, context).generateIR();
+        });
+    }
+
+    /**
+     * Returns the operands of a comparison between a uint and an int sign extended (int) and zero extended (uint) to int64 values.
+     * Comparing these as uint would reinterpret negative ints as large uints (e.g. 4294967295 === -1).
+     * @return the int64 operands or undefined if the comparison is not between a uint and an int
+     */
+    private static toMixedSignOperands(binaryExpression: ts.BinaryExpression, context: CodeGenerationContext): [llvm.Value, llvm.Value] | undefined {
+        const leftType = context.typeChecker.getTypeAtLocation(binaryExpression.left);
+        const rightType = context.typeChecker.getTypeAtLocation(binaryExpression.right);
+
+        const isMixed = (isUintType(leftType) && rightType.flags & ts.TypeFlags.IntLike) || (leftType.flags & ts.TypeFlags.IntLike && isUintType(rightType));
+        if (!isMixed) {
+            return undefined;
+        }
+
+        const int64 = llvm.Type.getInt64Ty(context.llvmContext);
+        const toInt64 = (operand: ts.Expression, operandType: ts.Type) => {
+            const operandIr = context.generateValue(operand).generateIR(context);
+
+            if (isUintType(operandType)) {
+                return context.builder.createZExt(operandIr, int64, `${operandIr.name}AsInt64`);
+            }
+            return context.builder.createSExt(operandIr, int64, `${operandIr.name}AsInt64`);
+        };
+
+        return [toInt64(binaryExpression.left, leftType), toInt64(binaryExpression.right, rightType)];
+    }
+
     private static toUnified(node: ts.Node, binaryExpression: ts.BinaryExpression, context: CodeGenerationContext): Value {
         const unifiedType = this.unifyTypes(binaryExpression, context);
 
@@ -432,6 +600,19 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
                 return right;
             }
 
+            // cast int to int64 or uint, uint to int64 and int64 or uint to number
+            if (left.flags & ts.TypeFlags.IntLike && (isInt64Type(right) || isUintType(right))) {
+                return right;
+            }
+
+            if (isUintType(left) && isInt64Type(right)) {
+                return right;
+            }
+
+            if ((isInt64Type(left) || isUintType(left)) && right.flags & (ts.TypeFlags.NumberLike ^ ts.TypeFlags.IntLike)) {
+                return right;
+            }
+
             if ((left.flags & ts.TypeFlags.Object || isMaybeObjectType(left)) && right.flags & ts.TypeFlags.Undefined) {
                 return left;
             }
@@ -444,6 +625,15 @@ class BinaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.BinaryExpr
 
         const unified = unify(leftType, rightType) || unify(rightType, leftType);
 
+        // int operands of variables narrowed from number, e.g. i / 2, need to be computed as number to not change the semantics
+        if (unified && unified.flags & ts.TypeFlags.IntLike && isArithmeticOperator(binaryExpression.operatorToken.kind)) {
+            const resultType = context.typeChecker.getTypeAtLocation(binaryExpression);
+
+            if (resultType.flags & ts.TypeFlags.NumberLike && !(resultType.flags & ts.TypeFlags.IntLike)) {
+                return resultType;
+            }
+        }
+
         if (unified) {
             return unified;
         }
@@ -1,16 +1,39 @@
+import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
 import {FunctionReference} from "../value/function-reference";
+import {isInt64Type, isUintType} from "../util/types";
+import {Primitive} from "../value/primitive";
 import {Value} from "../value/value";
 
 class CallExpressionCodeGenerator implements SyntaxCodeGenerator<ts.CallExpression, Value | void> {
     syntaxKind = ts.SyntaxKind.CallExpression;
 
     generate(callExpression: ts.CallExpression, context: CodeGenerationContext): Value | void {
+        const constant = context.compilationContext.constantFunctionEvaluator.evaluateCall(callExpression);
+        if (typeof(constant) !== "undefined") {
+            return CallExpressionCodeGenerator.toPrimitive(constant, context.typeChecker.getTypeAtLocation(callExpression), context);
+        }
+
         const callee = context.generateValue(callExpression.expression).dereference(context) as FunctionReference;
         return callee.invoke(callExpression, context);
     }
+
+    /**
+     * Creates the llvm constant for the result of a call evaluated at compile time
+     */
+    private static toPrimitive(value: number | boolean, type: ts.Type, context: CodeGenerationContext) {
+        if (type.flags & ts.TypeFlags.BooleanLike) {
+            return value ? Primitive.true(context, type) : Primitive.false(context, type);
+        } else if (type.flags & ts.TypeFlags.IntLike || isUintType(type)) {
+            return new Primitive(llvm.ConstantInt.get(context.llvmContext, value as number), type);
+        } else if (isInt64Type(type)) {
+            return new Primitive(llvm.ConstantInt.get(context.llvmContext, value as number, 64), type);
+        }
+
+        return new Primitive(llvm.ConstantFP.get(context.llvmContext, value as number), type);
+    }
 }
 
 export default CallExpressionCodeGenerator;
@@ -2,6 +2,7 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isUintType} from "../util/types";
 import {ObjectIndexReference} from "../value/object-index-reference";
 
 /**
@@ -16,7 +17,7 @@ class ElementAccessExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Ele
         }
 
         const argumentExpressionType = context.typeChecker.getTypeAtLocation(node.argumentExpression);
-        if (!(argumentExpressionType.flags & ts.TypeFlags.IntLike)) {
+        if (!(argumentExpressionType.flags & ts.TypeFlags.IntLike) && !isUintType(argumentExpressionType)) {
             throw CodeGenerationDiagnostics.unsupportedElementAccessExpression(node, context.typeChecker.typeToString(argumentExpressionType));
         }
 
@@ -4,8 +4,40 @@ import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isInt64Type, isUintType} from "../util/types";
 import {Primitive} from "../value/primitive";
 
+const INTEGER_LITERAL = /^(?:0[xX]([0-9a-fA-F]+)|0[oO]([0-7]+)|0[bB]([01]+)|([0-9]+))$/;
+
+/**
+ * Parses the text of an integer literal into the high and low 32 bits of its value modulo 2^64 (BigInt.asUintN(64, x)).
+ * The text is parsed digit by digit into 16 bit limbs as the number value of the literal is not exact for literals greater than 2^53.
+ * @param text the source text of the literal
+ * @return the high and low 32 bits or undefined if the literal is not an integer literal (e.g. 1e18 or 1.0)
+ */
+function parseInt64Literal(text: string): [number, number] | undefined {
+    const match = INTEGER_LITERAL.exec(text);
+
+    if (!match) {
+        return undefined;
+    }
+
+    const radix = match[1] ? 16 : match[2] ? 8 : match[3] ? 2 : 10;
+    const digits = match[1] || match[2] || match[3] || match[4];
+    const limbs = [0, 0, 0, 0]; // little endian
+
+    for (const digit of digits) {
+        let carry = parseInt(digit, radix);
+        for (let i = 0; i < limbs.length; ++i) {
+            const limb = limbs[i] * radix + carry;
+            limbs[i] = limb & 0xFFFF;
+            carry = Math.floor(limb / 0x10000);
+        }
+    }
+
+    return [limbs[3] * 0x10000 + limbs[2], limbs[1] * 0x10000 + limbs[0]];
+}
+
 class FirstLiteralTokenCodeGenerator implements SyntaxCodeGenerator<ts.LiteralExpression, Primitive> {
     syntaxKind = ts.SyntaxKind.FirstLiteralToken;
 
@@ -13,8 +45,10 @@ class FirstLiteralTokenCodeGenerator implements SyntaxCodeGenerator<ts.LiteralEx
         const type = context.typeChecker.getTypeAtLocation(node);
         let value: llvm.Value;
 
-        if (type.flags & ts.TypeFlags.IntLike) {
+        if (type.flags & ts.TypeFlags.IntLike || isUintType(type)) {
             value = llvm.ConstantInt.get(context.llvmContext, +node.text);
+        } else if (isInt64Type(type)) {
+            value = FirstLiteralTokenCodeGenerator.toInt64Constant(node, context);
         } else if (type.flags & ts.TypeFlags.NumberLike) {
             value = llvm.ConstantFP.get(context.llvmContext, +node.text);
         } else {
@@ -23,6 +57,31 @@ class FirstLiteralTokenCodeGenerator implements SyntaxCodeGenerator<ts.LiteralEx
 
         return new Primitive(value, type);
     }
+
+    private static toInt64Constant(node: ts.LiteralExpression, context: CodeGenerationContext): llvm.Value {
+        // node.text is the normalized number value of the literal, the source text is needed to not lose precision
+        const text = node.getText();
+        const halves = parseInt64Literal(text);
+
+        if (!halves) {
+            const value = +text;
+            if (!Number.isSafeInteger(value)) {
+                throw CodeGenerationDiagnostics.unsupportedInt64Literal(node);
+            }
+            return llvm.ConstantInt.get(context.llvmContext, value, 64);
+        }
+
+        const [high, low] = halves;
+        const lowBits = llvm.ConstantInt.get(context.llvmContext, low, 64);
+
+        if (high === 0) {
+            return lowBits;
+        }
+
+        // folded to a constant by the builder
+        const highBits = context.builder.createShl(llvm.ConstantInt.get(context.llvmContext, high, 64), llvm.ConstantInt.get(context.llvmContext, 32, 64));
+        return context.builder.createOr(highBits, lowBits);
+    }
 }
 
 export default FirstLiteralTokenCodeGenerator;
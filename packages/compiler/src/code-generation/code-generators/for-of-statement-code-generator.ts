@@ -0,0 +1,340 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isInside} from "../util/closures";
+import {getArrayElementType} from "../util/types";
+import {Allocation} from "../value/allocation";
+import {ArrayReference} from "../value/array-reference";
+import {AssignableValue} from "../value/value";
+
+/**
+ * Code generator for for...of loops over arrays, e.g.
+ * for (const value of array) {
+ *     sum += value;
+ * }
+ *
+ * The loop increments a pointer from the first element of the array up to the pointer behind the last element without
+ * creating an iterator object. The end pointer is only read once before the loop if the body provably does not resize the array.
+ * Otherwise, the loop uses an index that is compared with the current length of the array in each iteration.
+ * The array expression is evaluated once, reassigning the variable that stores the array does not change the iterated array.
+ */
+class ForOfStatementCodeGenerator implements SyntaxCodeGenerator<ts.ForOfStatement, void> {
+    syntaxKind = ts.SyntaxKind.ForOfStatement;
+
+    generate(forOfStatement: ts.ForOfStatement, context: CodeGenerationContext): void {
+        const arrayType = context.typeChecker.getTypeAtLocation(forOfStatement.expression);
+
+        if (!isArrayType(arrayType, context)) {
+            throw CodeGenerationDiagnostics.unsupportedForOfIterable(forOfStatement.expression, context.typeChecker.typeToString(arrayType));
+        }
+
+        const elementType = getArrayElementType(arrayType);
+        const arrayPtr = context.generateValue(forOfStatement.expression).generateIR(context);
+        const array = context.value(arrayPtr, arrayType) as ArrayReference;
+        const cursor = mayResizeArray(forOfStatement.statement, elementType, context) ?
+            new IndexCursor(array, context) :
+            new PointerCursor(array, context);
+
+        context.enterChildScope();
+        const variableType = context.typeChecker.getTypeAtLocation(getLoopVariableNode(forOfStatement.initializer));
+        const variable = this.getLoopVariable(forOfStatement.initializer, variableType, context);
+
+        const fun = context.scope.enclosingFunction;
+        const condition = llvm.BasicBlock.create(context.llvmContext, "forof.cond");
+        let body = llvm.BasicBlock.create(context.llvmContext, "forof.body");
+        const incrementer = llvm.BasicBlock.create(context.llvmContext, "forof.inc");
+        const end = llvm.BasicBlock.create(context.llvmContext, "forof.end");
+
+        context.builder.createBr(condition);
+        fun.addBasicBlock(condition);
+        context.builder.setInsertionPoint(condition);
+        context.builder.createCondBr(cursor.generateHasNext(context), body, end);
+
+        this.setContinueAndBreakLabels(forOfStatement.parent, context, incrementer, end);
+
+        fun.addBasicBlock(body);
+        context.builder.setInsertionPoint(body);
+
+        const element = context.value(loadElement(cursor.generateElementPointer(context), elementType, context), elementType);
+        const castedElement = element.castImplicit(variableType, context);
+
+        if (!castedElement) {
+            throw CodeGenerationDiagnostics.unsupportedImplicitCast(
+                forOfStatement.initializer,
+                context.typeChecker.typeToString(variableType),
+                context.typeChecker.typeToString(elementType)
+            );
+        }
+
+        context.assignValue(variable, castedElement);
+
+        context.generate(forOfStatement.statement);
+        body = context.builder.getInsertBlock();
+
+        if (!body.getTerminator()) {
+            context.builder.createBr(incrementer);
+        }
+
+        fun.addBasicBlock(incrementer);
+        context.builder.setInsertionPoint(incrementer);
+        cursor.generateNext(context);
+        context.builder.createBr(condition);
+
+        context.leaveChildScope();
+
+        fun.addBasicBlock(end);
+        context.builder.setInsertionPoint(end);
+    }
+
+    private getLoopVariable(initializer: ts.ForInitializer, type: ts.Type, context: CodeGenerationContext): AssignableValue {
+        if (initializer.kind !== ts.SyntaxKind.VariableDeclarationList) {
+            return context.generateValue(initializer as ts.Expression) as AssignableValue;
+        }
+
+        const declaration = (initializer as ts.VariableDeclarationList).declarations[0];
+        if (declaration.name.kind !== ts.SyntaxKind.Identifier) {
+            throw CodeGenerationDiagnostics.unsupportedSyntaxKind(declaration.name);
+        }
+
+        const symbol = context.typeChecker.getSymbolAtLocation(declaration.name);
+        const allocation = Allocation.create(type, context, symbol.name);
+        context.scope.addVariable(symbol, allocation);
+
+        return allocation;
+    }
+
+    private setContinueAndBreakLabels(parent: ts.Node | undefined, context: CodeGenerationContext, incrementer: llvm.BasicBlock, end: llvm.BasicBlock) {
+        context.scope.setContinueBlock(incrementer);
+        context.scope.setBreakBlock(end);
+
+        if (parent && parent.kind === ts.SyntaxKind.LabeledStatement) {
+            const labeledStatement = parent as ts.LabeledStatement;
+
+            if (labeledStatement.label) {
+                context.scope.setContinueBlock(incrementer, labeledStatement.label.text);
+                context.scope.setBreakBlock(end, labeledStatement.label.text);
+            }
+        }
+    }
+}
+
+/**
+ * Iteration state of a for...of loop
+ */
+interface ElementCursor {
+    /**
+     * Generates the test if the cursor points to an element of the array
+     * @return the i1 value that is true if the loop body is executed for another element
+     */
+    generateHasNext(context: CodeGenerationContext): llvm.Value;
+
+    /**
+     * Returns the pointer to the element the cursor is pointing to
+     */
+    generateElementPointer(context: CodeGenerationContext): llvm.Value;
+
+    /**
+     * Moves the cursor to the next element
+     */
+    generateNext(context: CodeGenerationContext): void;
+}
+
+/**
+ * Cursor that increments a pointer until it reaches the end pointer that was read before entering the loop.
+ * Requires that the loop body does not resize the array.
+ */
+class PointerCursor implements ElementCursor {
+    private back: llvm.Value;
+    private current: llvm.AllocaInst;
+
+    constructor(array: ArrayReference, context: CodeGenerationContext) {
+        const { elements, back } = array.getElementRange(context);
+
+        this.back = back;
+        this.current = Allocation.createAllocaInstInEntryBlock(elements.type, context, "current");
+        context.builder.createAlignedStore(elements, this.current, this.current.alignment);
+    }
+
+    generateHasNext(context: CodeGenerationContext) {
+        return context.builder.createICmpNE(this.loadCurrent(context), this.back, "hasNext");
+    }
+
+    generateElementPointer(context: CodeGenerationContext) {
+        return this.loadCurrent(context);
+    }
+
+    generateNext(context: CodeGenerationContext) {
+        const next = context.builder.createInBoundsGEP(this.loadCurrent(context), [llvm.ConstantInt.get(context.llvmContext, 1)], "next");
+        context.builder.createAlignedStore(next, this.current, this.current.alignment);
+    }
+
+    private loadCurrent(context: CodeGenerationContext) {
+        return context.builder.createAlignedLoad(this.current, this.current.alignment, "current");
+    }
+}
+
+/**
+ * Cursor that compares an index with the length of the array in every iteration as the body of the loop might resize the array
+ */
+class IndexCursor implements ElementCursor {
+    private index: llvm.AllocaInst;
+    private elements: llvm.Value | undefined;
+    private currentIndex: llvm.Value | undefined;
+
+    constructor(private array: ArrayReference, context: CodeGenerationContext) {
+        this.index = Allocation.createAllocaInstInEntryBlock(llvm.Type.getInt32Ty(context.llvmContext), context, "index");
+        context.builder.createAlignedStore(llvm.ConstantInt.get(context.llvmContext, 0), this.index, this.index.alignment);
+    }
+
+    generateHasNext(context: CodeGenerationContext) {
+        const { elements, length } = this.array.toCArray(context);
+        this.elements = elements;
+        this.currentIndex = this.loadIndex(context);
+
+        return context.builder.createICmpSLT(this.currentIndex, length, "hasNext");
+    }
+
+    generateElementPointer(context: CodeGenerationContext) {
+        // the condition block dominates the loop body, the elements are not reallocated in between
+        return context.builder.createInBoundsGEP(this.elements!, [this.currentIndex!], "&element");
+    }
+
+    generateNext(context: CodeGenerationContext) {
+        const next = context.builder.createAdd(this.loadIndex(context), llvm.ConstantInt.get(context.llvmContext, 1), "next");
+        context.builder.createAlignedStore(next, this.index, this.index.alignment);
+    }
+
+    private loadIndex(context: CodeGenerationContext) {
+        return context.builder.createAlignedLoad(this.index, this.index.alignment, "index");
+    }
+}
+
+function getLoopVariableNode(initializer: ts.ForInitializer): ts.Node {
+    if (initializer.kind === ts.SyntaxKind.VariableDeclarationList) {
+        return (initializer as ts.VariableDeclarationList).declarations[0];
+    }
+
+    return initializer;
+}
+
+function loadElement(elementPointer: llvm.Value, elementType: ts.Type, context: CodeGenerationContext) {
+    const runtimeType = (elementPointer.type as llvm.PointerType).elementType;
+    const element = context.builder.createAlignedLoad(elementPointer, Allocation.getPreferredValueAlignment(runtimeType, context), "element");
+    const type = context.toLLVMType(elementType);
+
+    // objects are stored as i8* in the array
+    return runtimeType.isPointerTy() && !runtimeType.equals(type) ? context.builder.createBitCast(element, type) : element;
+}
+
+function isArrayType(type: ts.Type, context: CodeGenerationContext) {
+    return type.getSymbol() === context.compilationContext.builtIns.get("Array");
+}
+
+/**
+ * Tests if executing the given loop body might change the length of an array with the given element type.
+ * Calls of functions other than Math functions and non resizing array methods and the construction of objects other than arrays
+ * are conservatively treated as resizing, as is the assignment to the length of an array with the same element type.
+ * Assigning an element does not resize the array (an index out of bound throws). A function declared in the body resizes
+ * the array if it captures an array with the same element type as it might be called by a non resizing method (e.g. the
+ * comparator passed to sort).
+ */
+function mayResizeArray(body: ts.Node, elementType: ts.Type, context: CodeGenerationContext): boolean {
+    const typeChecker = context.typeChecker;
+    const isSameArrayType = (expression: ts.Expression) => {
+        const type = typeChecker.getTypeAtLocation(expression);
+        return isArrayType(type, context) && getArrayElementType(type) === elementType;
+    };
+
+    const isArrayLength = (expression: ts.Node): boolean => {
+        if (expression.kind === ts.SyntaxKind.ParenthesizedExpression) {
+            return isArrayLength((expression as ts.ParenthesizedExpression).expression);
+        }
+
+        if (expression.kind === ts.SyntaxKind.PropertyAccessExpression) {
+            const propertyAccess = expression as ts.PropertyAccessExpression;
+            return propertyAccess.name.text === "length" && isSameArrayType(propertyAccess.expression);
+        }
+
+        return false;
+    };
+
+    const isNonResizingCall = (callExpression: ts.CallExpression) => {
+        if (callExpression.expression.kind !== ts.SyntaxKind.PropertyAccessExpression) {
+            return false;
+        }
+
+        const propertyAccess = callExpression.expression as ts.PropertyAccessExpression;
+        const objectType = typeChecker.getTypeAtLocation(propertyAccess.expression);
+
+        if (typeChecker.getSymbolAtLocation(propertyAccess.expression) === context.compilationContext.builtIns.get("Math")) {
+            return true;
+        }
+
+        return isArrayType(objectType, context) && NON_RESIZING_ARRAY_METHODS.indexOf(propertyAccess.name.text) !== -1;
+    };
+
+    // Variables or fields referenced by the closure that are declared outside of it and store an array with the same element type
+    const capturesSameArrayType = (closure: ts.Node): boolean => {
+        const visitClosure = (node: ts.Node): boolean => {
+            if ((node.kind === ts.SyntaxKind.Identifier || node.kind === ts.SyntaxKind.PropertyAccessExpression) && isSameArrayType(node as ts.Expression)) {
+                const symbol = typeChecker.getSymbolAtLocation(node);
+                const declaration = symbol ? symbol.valueDeclaration : undefined;
+
+                if (!declaration || !isInside(declaration, closure)) {
+                    return true;
+                }
+            }
+
+            return !!ts.forEachChild(node, child => visitClosure(child) || undefined);
+        };
+
+        return !!ts.forEachChild(closure, child => visitClosure(child) || undefined);
+    };
+
+    const visit = (node: ts.Node): boolean => {
+        switch (node.kind) {
+            case ts.SyntaxKind.FunctionDeclaration:
+            case ts.SyntaxKind.FunctionExpression:
+            case ts.SyntaxKind.ArrowFunction:
+                return capturesSameArrayType(node);
+
+            case ts.SyntaxKind.CallExpression:
+                if (!isNonResizingCall(node as ts.CallExpression)) {
+                    return true;
+                }
+                break;
+
+            case ts.SyntaxKind.NewExpression:
+                if (!isArrayType(typeChecker.getTypeAtLocation(node), context)) {
+                    return true;
+                }
+                break;
+
+            case ts.SyntaxKind.BinaryExpression:
+                const binary = node as ts.BinaryExpression;
+                const operator = binary.operatorToken.kind;
+                if (operator >= ts.SyntaxKind.FirstAssignment && operator <= ts.SyntaxKind.LastAssignment && isArrayLength(binary.left)) {
+                    return true;
+                }
+                break;
+
+            case ts.SyntaxKind.PrefixUnaryExpression:
+            case ts.SyntaxKind.PostfixUnaryExpression:
+                const unary = node as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+                if ((unary.operator === ts.SyntaxKind.PlusPlusToken || unary.operator === ts.SyntaxKind.MinusMinusToken) && isArrayLength(unary.operand)) {
+                    return true;
+                }
+                break;
+        }
+
+        return !!ts.forEachChild(node, child => visit(child) || undefined);
+    };
+
+    return visit(body);
+}
+
+const NON_RESIZING_ARRAY_METHODS = ["fill", "slice", "sort"];
+
+export default ForOfStatementCodeGenerator;
@@ -2,10 +2,14 @@ import * as ts from "typescript";
 
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isClosure} from "../util/closures";
+import {Allocation} from "../value/allocation";
+import {ClosureReference} from "../value/closure-reference";
 import {UnresolvedFunctionReference} from "../value/unresolved-function-reference";
 
 /**
- * Code Generator for a function declaration
+ * Code Generator for a function declaration. A function declared inside of another function is a closure that is
+ * stored in a variable of the enclosing function.
  */
 class FunctionDeclarationCodeGenerator implements SyntaxCodeGenerator<ts.FunctionDeclaration, void> {
     syntaxKind = ts.SyntaxKind.FunctionDeclaration;
@@ -14,6 +18,14 @@ class FunctionDeclarationCodeGenerator implements SyntaxCodeGenerator<ts.Functio
         const symbol = context.typeChecker.getSymbolAtLocation(functionDeclaration.name!);
 
         const type = context.typeChecker.getTypeAtLocation(functionDeclaration);
+
+        if (isClosure(functionDeclaration)) {
+            const allocation = Allocation.create(type, context, symbol.name);
+            allocation.generateAssignmentIR(ClosureReference.create(functionDeclaration, context), context);
+            context.scope.addVariable(symbol, allocation);
+            return;
+        }
+
         const apparentType = context.typeChecker.getApparentType(type);
         const callSignatures = context.typeChecker.getSignaturesOfType(apparentType, ts.SignatureKind.Call);
 
@@ -0,0 +1,18 @@
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {ClosureReference} from "../value/closure-reference";
+import {Value} from "../value/value";
+
+/**
+ * Code Generator for a function expression, creates a closure that captures the referenced variables of the enclosing function
+ */
+class FunctionExpressionCodeGenerator implements SyntaxCodeGenerator<ts.FunctionExpression, Value> {
+    syntaxKind = ts.SyntaxKind.FunctionExpression;
+
+    generate(functionExpression: ts.FunctionExpression, context: CodeGenerationContext): Value {
+        return ClosureReference.create(functionExpression, context);
+    }
+}
+
+export default FunctionExpressionCodeGenerator;
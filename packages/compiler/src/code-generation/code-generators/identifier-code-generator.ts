@@ -21,12 +21,13 @@ class IdentifierCodeGenerator implements SyntaxCodeGenerator<ts.Identifier, Valu
             return Undefined.create(context);
         }
 
-        if (symbol.flags & ts.SymbolFlags.Function) {
-            return IdentifierCodeGenerator.getFunction(symbol, identifier, context);
+        // Functions nested inside of the enclosing function are closures stored in variables
+        if (symbol.flags & (ts.SymbolFlags.Variable | ts.SymbolFlags.Function) && context.scope.hasVariable(symbol)) {
+            return context.scope.getVariable(symbol);
         }
 
-        if (symbol.flags & ts.SymbolFlags.Variable && context.scope.hasVariable(symbol)) {
-            return context.scope.getVariable(symbol);
+        if (symbol.flags & ts.SymbolFlags.Function) {
+            return IdentifierCodeGenerator.getFunction(symbol, identifier, context);
         }
 
         if (symbol.flags & ts.SymbolFlags.Type) {
@@ -4,6 +4,7 @@ import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CodeGenerationContext} from "../code-generation-context";
 
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isInt64Type, isUintType} from "../util/types";
 import {Value} from "../value/value";
 
 class PostfixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.PostfixUnaryExpression, Value> {
@@ -17,16 +18,20 @@ class PostfixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Post
 
         switch (postfixUnaryExpression.operator) {
             case ts.SyntaxKind.PlusPlusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || isUintType(operandType)) {
                     updated = context.builder.createAdd(before, llvm.ConstantInt.get(context.llvmContext, 1), "inc");
+                } else if (isInt64Type(operandType)) {
+                    updated = context.builder.createAdd(before, llvm.ConstantInt.get(context.llvmContext, 1, 64), "inc");
                 } else if (operandType.flags & ts.TypeFlags.NumberLike) {
                     updated = context.builder.createFAdd(before, llvm.ConstantFP.get(context.llvmContext, 1), "inc");
                 }
                 break;
 
             case ts.SyntaxKind.MinusMinusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || isUintType(operandType)) {
                     updated = context.builder.createAdd(before, llvm.ConstantInt.get(context.llvmContext, -1), "dec");
+                } else if (isInt64Type(operandType)) {
+                    updated = context.builder.createAdd(before, llvm.ConstantInt.get(context.llvmContext, -1, 64), "dec");
                 } else if (operandType.flags & ts.TypeFlags.NumberLike) {
                     updated = context.builder.createFAdd(before, llvm.ConstantFP.get(context.llvmContext, -1), "dec");
                 }
@@ -3,6 +3,7 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {isInt64Type, isUintType} from "../util/types";
 import {Primitive} from "../value/primitive";
 import {Value} from "../value/value";
 
@@ -23,7 +24,7 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
                 break;
 
             case ts.SyntaxKind.MinusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || isInt64Type(operandType) || isUintType(operandType)) {
                     result = context.builder.createNeg(left.generateIR(context), "neg");
                 } else if (operandType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFNeg(left.generateIR(context), "neg");
@@ -32,8 +33,10 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
                 break;
 
             case ts.SyntaxKind.MinusMinusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || isUintType(operandType)) {
                     result = context.builder.createSub(left.generateIR(context), llvm.ConstantInt.get(context.llvmContext, 1), "sub");
+                } else if (isInt64Type(operandType)) {
+                    result = context.builder.createSub(left.generateIR(context), llvm.ConstantInt.get(context.llvmContext, 1, 64), "sub");
                 } else if (operandType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFSub(left.generateIR(context), llvm.ConstantFP.get(context.llvmContext, 1.0), "fsub");
                 }
@@ -41,7 +44,7 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
                 break;
 
             case ts.SyntaxKind.PlusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike || operandType.flags & ts.TypeFlags.NumberLike || operandType.flags & ts.TypeFlags.BooleanLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || operandType.flags & ts.TypeFlags.NumberLike || operandType.flags & ts.TypeFlags.BooleanLike || isInt64Type(operandType) || isUintType(operandType)) {
                     const castedToResultType = left.castImplicit(resultType, context);
                     result = castedToResultType ? castedToResultType.generateIR(context) : undefined;
                 }
@@ -49,8 +52,10 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
                 break;
 
             case ts.SyntaxKind.PlusPlusToken:
-                if (operandType.flags & ts.TypeFlags.IntLike) {
+                if (operandType.flags & ts.TypeFlags.IntLike || isUintType(operandType)) {
                     result = context.builder.createAdd(left.generateIR(context), llvm.ConstantInt.get(context.llvmContext, 1), "add");
+                } else if (isInt64Type(operandType)) {
+                    result = context.builder.createAdd(left.generateIR(context), llvm.ConstantInt.get(context.llvmContext, 1, 64), "add");
                 } else if (operandType.flags & ts.TypeFlags.NumberLike) {
                     result = context.builder.createFAdd(left.generateIR(context), llvm.ConstantFP.get(context.llvmContext, 1.0), "fadd");
                 }
@@ -58,7 +63,8 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
                 break;
 
             case ts.SyntaxKind.TildeToken:
-                const intValue = Primitive.toInt32(left, operandType, resultType, context).generateIR();
+                const toInteger = isInt64Type(resultType) ? Primitive.toInt64 : isUintType(resultType) ? Primitive.toUint32 : Primitive.toInt32;
+                const intValue = toInteger(left, operandType, resultType, context).generateIR();
                 result = context.builder.createNot(intValue, "not");
 
                 break;
@@ -68,12 +74,14 @@ class PrefixUnaryExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Prefi
             throw CodeGenerationDiagnostics.unsupportedUnaryOperation(node, context.typeChecker.typeToString(operandType));
         }
 
-        const resultValue = context.value(result, resultType);
-
         if (node.operator === ts.SyntaxKind.PlusPlusToken || node.operator === ts.SyntaxKind.MinusMinusToken) {
-            context.assignValue(left, resultValue);
+            // the operand type can differ from the result type if the variable has been narrowed to an int
+            const updatedValue = context.value(result, operandType);
+            context.assignValue(left, updatedValue);
+            return updatedValue;
         }
-        return resultValue;
+
+        return context.value(result, resultType);
     }
 }
 
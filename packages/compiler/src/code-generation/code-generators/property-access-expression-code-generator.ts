@@ -5,6 +5,7 @@ import {SyntaxCodeGenerator} from "../syntax-code-generator";
 import {ClassReference} from "../value/class-reference";
 import {FunctionReference} from "../value/function-reference";
 import {ObjectPropertyReference} from "../value/object-property-reference";
+import {SIMDOperationsObject} from "../value/simd-operations-object";
 
 class PropertyAccessExpressionCodeGenerator implements SyntaxCodeGenerator<ts.PropertyAccessExpression, ObjectPropertyReference | FunctionReference> {
     syntaxKind = ts.SyntaxKind.PropertyAccessExpression;
@@ -16,6 +17,10 @@ class PropertyAccessExpressionCodeGenerator implements SyntaxCodeGenerator<ts.Pr
             return object.getProperty(propertyExpression, context);
         }
 
+        if (object instanceof SIMDOperationsObject) {
+            return object.getOperation(propertyExpression, context);
+        }
+
         if (object instanceof ClassReference) {
             throw CodeGenerationDiagnostics.unsupportedStaticProperties(propertyExpression);
         }
@@ -1,9 +1,11 @@
 import * as assert from "assert";
+import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {TypeChecker} from "../../type-checker";
 import {CodeGenerationContext} from "../code-generation-context";
 import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {TailCall, TailCallTarget} from "../util/tail-recursion";
 
 class ReturnStatementCodeGenerator implements SyntaxCodeGenerator<ts.ReturnStatement, void> {
     syntaxKind = ts.SyntaxKind.ReturnStatement;
@@ -11,6 +13,12 @@ class ReturnStatementCodeGenerator implements SyntaxCodeGenerator<ts.ReturnState
     generate(returnStatement: ts.ReturnStatement, context: CodeGenerationContext): void {
         const returnAllocation = context.scope.returnAllocation;
         const returnBlock = context.scope.returnBlock;
+        const tailCallTarget = context.scope.tailCallTarget;
+        const tailCall = tailCallTarget ? tailCallTarget.tailCalls.get(returnStatement) : undefined;
+
+        if (tailCall) {
+            return generateTailCall(tailCall, tailCallTarget!, context);
+        }
 
         if (returnStatement.expression) {
             assert(returnAllocation, "No return allocation present but return statement is");
@@ -28,7 +36,11 @@ class ReturnStatementCodeGenerator implements SyntaxCodeGenerator<ts.ReturnState
                 );
             }
 
-            returnAllocation!.generateAssignmentIR(casted, context);
+            if (tailCallTarget && tailCallTarget.accumulator) {
+                returnAllocation!.generateAssignmentIR(accumulate(tailCallTarget, casted.generateIR(context), "accumulated", context), context);
+            } else {
+                returnAllocation!.generateAssignmentIR(casted, context);
+            }
         }
 
         assert(returnBlock, "No return block present (not inside of a function?)");
@@ -36,6 +48,51 @@ class ReturnStatementCodeGenerator implements SyntaxCodeGenerator<ts.ReturnState
     }
 }
 
+/**
+ * Replaces the self recursive call with an assignment of the arguments to the parameters and a jump to the start of the function
+ */
+function generateTailCall(tailCall: TailCall, target: TailCallTarget, context: CodeGenerationContext) {
+    let accumulated: llvm.Value | undefined;
+    if (tailCall.accumulated) {
+        const casted = context.generateValue(tailCall.accumulated).castImplicit(target.accumulator!.type, context);
+        assert(casted, "The accumulated operand of a tail call needs to be an int");
+        accumulated = casted!.generateIR(context);
+    }
+
+    // All arguments need to be evaluated before the parameters are reassigned, as the arguments might reference the parameters
+    const args = tailCall.call.arguments.map((argument, i) => {
+        const parameter = target.parameters[i];
+        const casted = context.generateValue(argument).castImplicit(parameter.type, context);
+
+        if (!casted) {
+            throw CodeGenerationDiagnostics.unsupportedImplicitCastOfArgument(
+                argument,
+                context.typeChecker.typeToString(parameter.type),
+                context.typeChecker.typeToString(context.typeChecker.getTypeAtLocation(argument))
+            );
+        }
+
+        return casted.generateIR(context);
+    });
+
+    if (accumulated) {
+        target.accumulator!.generateAssignmentIR(accumulate(target, accumulated, "accumulate", context), context);
+    }
+
+    args.forEach((arg, i) => target.parameters[i].generateAssignmentIR(arg, context));
+    context.builder.createBr(target.block);
+}
+
+function accumulate(target: TailCallTarget, value: llvm.Value, name: string, context: CodeGenerationContext): llvm.Value {
+    const accumulator = target.accumulator!.generateIR(context);
+
+    if (target.accumulatorOperator === ts.SyntaxKind.PlusToken) {
+        return context.builder.createAdd(accumulator, value, name);
+    }
+
+    return context.builder.createMul(accumulator, value, name);
+}
+
 function getExpectedReturnType(node: ts.ReturnStatement, typeChecker: TypeChecker) {
     function findEnclosingFunction(current: ts.Node): ts.FunctionLikeDeclaration {
         // tslint:disable-next-line:max-line-length
@@ -0,0 +1,44 @@
+import * as assert from "assert";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {SpeedyJSClassReference} from "../value/speedy-js-class-reference";
+import {SpeedyJSConstructorFunctionReference} from "../value/speedyjs-constructor-function-reference";
+import {SpeedyJSObjectReference} from "../value/speedyjs-object-reference";
+import {Value} from "../value/value";
+
+/**
+ * Generates the base class constructor for super(...) calls and this as instance of the base class for super.method() calls.
+ * Methods called on super are not dispatched but call the implementation of the base class directly.
+ */
+class SuperKeywordCodeGenerator implements SyntaxCodeGenerator<ts.SuperExpression, Value> {
+    syntaxKind = ts.SyntaxKind.SuperKeyword;
+
+    generate(node: ts.SuperExpression, context: CodeGenerationContext): Value {
+        const classDeclaration = getEnclosingClass(node);
+        const classSymbol = context.typeChecker.getSymbolAtLocation(classDeclaration.name!);
+        const self = context.scope.getVariable(classSymbol).dereference(context) as SpeedyJSObjectReference;
+        const baseClass = self.clazz.getBaseClass(context);
+
+        assert(baseClass, `The class ${classSymbol.name} has no base class`);
+
+        if (node.parent!.kind === ts.SyntaxKind.CallExpression) {
+            const signature = context.typeChecker.getResolvedSignature(node.parent as ts.CallExpression);
+            return SpeedyJSConstructorFunctionReference.createSuper(signature, baseClass!, self, context);
+        }
+
+        return self.unsafeCast(baseClass!.type, context, true);
+    }
+}
+
+function getEnclosingClass(node: ts.Node): ts.ClassDeclaration {
+    let current = node.parent;
+    while (current && current.kind !== ts.SyntaxKind.ClassDeclaration) {
+        current = current.parent;
+    }
+
+    assert(current, "super can only be used inside of a class");
+    return current as ts.ClassDeclaration;
+}
+
+export default SuperKeywordCodeGenerator;
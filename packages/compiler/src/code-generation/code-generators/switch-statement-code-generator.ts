@@ -0,0 +1,158 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SyntaxCodeGenerator} from "../syntax-code-generator";
+import {Primitive} from "../value/primitive";
+
+/**
+ * Code generator for switch statements, e.g.
+ * switch (opcode) {
+ *     case 0:
+ *     case 1:
+ *         x += 1;
+ *         break;
+ *     default:
+ *         x = 0;
+ * }
+ *
+ * The case values are compared with the switch value in the order of their declaration. The comparisons of an int value with
+ * constant cases form a chain of equality comparisons that is folded into a single llvm switch instruction by the optimizer.
+ * llc lowers the switch to a jump table (br_table) for dense cases and to a binary search for sparse cases.
+ * The statements of a case clause fall through to the next clause if the clause does not end with a break.
+ */
+class SwitchStatementCodeGenerator implements SyntaxCodeGenerator<ts.SwitchStatement, void> {
+    syntaxKind = ts.SyntaxKind.SwitchStatement;
+
+    generate(switchStatement: ts.SwitchStatement, context: CodeGenerationContext): void {
+        const fun = context.scope.enclosingFunction;
+        const type = context.typeChecker.getTypeAtLocation(switchStatement.expression);
+
+        if (!(type.flags & (ts.TypeFlags.NumberLike | ts.TypeFlags.BooleanLike))) {
+            throw CodeGenerationDiagnostics.unsupportedSwitchExpressionType(switchStatement.expression, context.typeChecker.typeToString(type));
+        }
+
+        const value = new Primitive(context.generateValue(switchStatement.expression).generateIR(context), type);
+        const clauses = switchStatement.caseBlock.clauses;
+        const end = llvm.BasicBlock.create(context.llvmContext, "switch.end");
+        const bodies = clauses.map(clause => {
+            return llvm.BasicBlock.create(context.llvmContext, clause.kind === ts.SyntaxKind.DefaultClause ? "switch.default" : "switch.case");
+        });
+
+        const defaultIndex = clauses.findIndex(clause => clause.kind === ts.SyntaxKind.DefaultClause);
+        const noMatch = defaultIndex === -1 ? end : bodies[defaultIndex];
+        const comparison = new CaseComparison(value);
+
+        let remainingCases = clauses.filter(clause => clause.kind === ts.SyntaxKind.CaseClause).length;
+        clauses.forEach((clause, i) => {
+            if (clause.kind === ts.SyntaxKind.DefaultClause) {
+                return;
+            }
+
+            const matches = comparison.generate(clause.expression, context);
+
+            if (--remainingCases === 0) {
+                context.builder.createCondBr(matches, bodies[i], noMatch);
+            } else {
+                const next = llvm.BasicBlock.create(context.llvmContext, "switch.test");
+                context.builder.createCondBr(matches, bodies[i], next);
+                fun.addBasicBlock(next);
+                context.builder.setInsertionPoint(next);
+            }
+        });
+
+        if (!context.builder.getInsertBlock().getTerminator()) { // no case clauses
+            context.builder.createBr(noMatch);
+        }
+
+        // An unlabeled break inside of a case clause leaves the switch, a continue still targets the enclosing loop
+        context.enterChildScope();
+        context.scope.setBreakBlock(end);
+
+        clauses.forEach((clause, i) => {
+            fun.addBasicBlock(bodies[i]);
+            context.builder.setInsertionPoint(bodies[i]);
+
+            for (const statement of clause.statements) {
+                context.generate(statement);
+            }
+
+            if (!context.builder.getInsertBlock().getTerminator()) {
+                context.builder.createBr(i + 1 < bodies.length ? bodies[i + 1] : end); // fall through
+            }
+        });
+
+        context.leaveChildScope();
+
+        fun.addBasicBlock(end);
+        context.builder.setInsertionPoint(end);
+    }
+}
+
+/**
+ * Compares the value of the switch expression with the values of the case clauses using strict equality
+ */
+class CaseComparison {
+    private valueAsNumber: Primitive | undefined;
+
+    constructor(private value: Primitive) {
+    }
+
+    generate(caseExpression: ts.Expression, context: CodeGenerationContext): llvm.Value {
+        const valueType = this.value.type;
+        const caseType = context.typeChecker.getTypeAtLocation(caseExpression);
+
+        // Integer literals are compared as int to allow the lowering to a jump table
+        const integerLiteral = valueType.flags & ts.TypeFlags.IntLike ? getIntegerLiteral(caseExpression) : undefined;
+        if (typeof integerLiteral !== "undefined") {
+            return context.builder.createICmpEQ(this.value.generateIR(), llvm.ConstantInt.get(context.llvmContext, integerLiteral), "cmpEQ");
+        }
+
+        const caseValue = context.generateValue(caseExpression);
+
+        // int value compared with a number case
+        if (valueType.flags & ts.TypeFlags.IntLike && !(caseType.flags & ts.TypeFlags.IntLike) && caseType.flags & ts.TypeFlags.NumberLike) {
+            this.valueAsNumber = this.valueAsNumber || Primitive.toNumber(this.value, valueType, caseType, context);
+            return context.builder.createFCmpOEQ(this.valueAsNumber.generateIR(), caseValue.generateIR(context), "cmpEQ");
+        }
+
+        const casted = caseValue.castImplicit(valueType, context);
+        if (!casted) {
+            throw CodeGenerationDiagnostics.unsupportedImplicitCast(
+                caseExpression,
+                context.typeChecker.typeToString(valueType),
+                context.typeChecker.typeToString(caseType)
+            );
+        }
+
+        if (valueType.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike)) {
+            return context.builder.createICmpEQ(this.value.generateIR(), casted.generateIR(context), "cmpEQ");
+        }
+
+        return context.builder.createFCmpOEQ(this.value.generateIR(), casted.generateIR(context), "cmpEQ");
+    }
+}
+
+/**
+ * Returns the value of an integer literal (e.g. 3 or -1) that fits into an int32
+ * @return the value or undefined if the expression is not an integer literal
+ */
+function getIntegerLiteral(expression: ts.Expression): number | undefined {
+    if (expression.kind === ts.SyntaxKind.ParenthesizedExpression) {
+        return getIntegerLiteral((expression as ts.ParenthesizedExpression).expression);
+    }
+
+    if (expression.kind === ts.SyntaxKind.PrefixUnaryExpression && (expression as ts.PrefixUnaryExpression).operator === ts.SyntaxKind.MinusToken) {
+        const operand = getIntegerLiteral((expression as ts.PrefixUnaryExpression).operand);
+        return typeof operand === "undefined" ? undefined : -operand;
+    }
+
+    if (expression.kind === ts.SyntaxKind.NumericLiteral) {
+        const value = +(expression as ts.NumericLiteral).text;
+        return value % 1 === 0 && value >= -2147483648 && value <= 2147483647 ? value : undefined;
+    }
+
+    return undefined;
+}
+
+export default SwitchStatementCodeGenerator;
@@ -10,9 +10,11 @@ import {CodeGenerationContextFactory} from "./code-generation-context-factory";
 import {DefaultCodeGenerationContext} from "./default-code-generation-context";
 import {FallbackCodeGenerator} from "./fallback-code-generator";
 import {SyntaxCodeGenerator} from "./syntax-code-generator";
+import {SIMD_VECTOR_KINDS} from "./util/types";
 import {ArrayClassReference} from "./value/array-class-reference";
 import {MathClassReference} from "./value/math-class-reference";
 import {Primitive} from "./value/primitive";
+import {SIMDOperationsObject} from "./value/simd-operations-object";
 import {UnresolvedFunctionReference} from "./value/unresolved-function-reference";
 import {Value} from "./value/value";
 
@@ -72,6 +74,21 @@ export class DefaultCodeGenerationContextFactory implements CodeGenerationContex
                 context.typeChecker.getSignatureFromDeclaration(isNanSymbol.valueDeclaration as ts.FunctionDeclaration)
             ], context));
         }
+
+        const seedRandomSymbol = builtins.get("speedyJsSeedRandom");
+        if (seedRandomSymbol) {
+            context.scope.addFunction(seedRandomSymbol, UnresolvedFunctionReference.createRuntimeFunction([
+                context.typeChecker.getSignatureFromDeclaration(seedRandomSymbol.valueDeclaration as ts.FunctionDeclaration)
+            ], context));
+        }
+
+        for (const kind of SIMD_VECTOR_KINDS) {
+            const operationsSymbol = builtins.get(kind.operationsName);
+            if (operationsSymbol) {
+                const operationsType = context.typeChecker.getTypeAtLocation(operationsSymbol.valueDeclaration!);
+                context.scope.addVariable(operationsSymbol, new SIMDOperationsObject(kind, operationsType));
+            }
+        }
     }
 
     private getCodeGenerators(): Array<SyntaxCodeGenerator<ts.Node, Value | void>> {
@@ -32,6 +32,7 @@ export class DefaultCodeGenerationContext implements CodeGenerationContext {
                 private rootScope = new Scope(),
                 private codeGenerators = new Map<ts.SyntaxKind, SyntaxCodeGenerator<ts.Node, Value | void>>(),
                 private entryFunctions = new Set<string>(),
+                private fastMathFunctions = new Set<string>(),
                 private fallbackCodeGenerator?: FallbackCodeGenerator) {
         this.builder = new llvm.IRBuilder(this.compilationContext.llvmContext);
         this.scope = rootScope;
@@ -63,6 +64,7 @@ export class DefaultCodeGenerationContext implements CodeGenerationContext {
             this.rootScope,
             this.codeGenerators,
             this.entryFunctions,
+            this.fastMathFunctions,
             this.fallbackCodeGenerator
         );
     }
@@ -101,6 +103,15 @@ export class DefaultCodeGenerationContext implements CodeGenerationContext {
         return Array.from(this.entryFunctions.values());
     }
 
+    addFastMathFunction(name: string) {
+        assert(name, "Name is required");
+        this.fastMathFunctions.add(name);
+    }
+
+    getFastMathFunctionNames() {
+        return Array.from(this.fastMathFunctions.values());
+    }
+
     enterChildScope(fn?: llvm.Function): Scope {
         this.scope = this.scope.enterChild(fn);
         return this.scope;
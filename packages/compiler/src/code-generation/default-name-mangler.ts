@@ -12,6 +12,10 @@ import {BaseNameMangler} from "./base-name-mangler";
  * Object:      Pv (Pointer void)
  *
  * Function and type names are prefixed with their length to avoid conflicts.
+ *
+ * Each instantiation of a generic function is a separate function. The type arguments are encoded between I and E
+ * after the function name, e.g. min<number>(number, number): 3minIdEdd. The type arguments of a generic class
+ * are appended to the class name, e.g. Box<int>.get(): BoxIi$3get.
  */
 export class DefaultNameMangler extends BaseNameMangler {
     get separator() {
@@ -15,9 +15,10 @@ export interface NameMangler {
      * @param name the name of the function or undefined if it is an anonymous function
      * @param parameters the parameters of the function
      * @param sourceFile the source file, to which the function belongs (needed to avoid naming clashes between different files)
+     * @param typeArguments the type arguments of a generic function
      * @returns the mangled function name for the function call with the specific arguments
      */
-    mangleFunctionName(name: string | undefined, parameters: Parameter[], sourceFile?: ts.SourceFile): string;
+    mangleFunctionName(name: string | undefined, parameters: Parameter[], sourceFile?: ts.SourceFile, typeArguments?: ts.Type[]): string;
 
     /**
      * Returns the mangled name of either a static or instance method of a class.
@@ -25,9 +26,10 @@ export interface NameMangler {
      * @param methodName the name of the method
      * @param parameters the parameters of the function
      * @param sourceFile the source file, to which the function belongs (needed to avoid naming clashes between different files)
+     * @param typeArguments the type arguments of a generic method
      * @returns the mangled function name for the function call with the specific arguments
      */
-    mangleMethodName(clazz: ts.ObjectType, methodName: string, parameters: Parameter[], sourceFile?: ts.SourceFile): string;
+    mangleMethodName(clazz: ts.ObjectType, methodName: string, parameters: Parameter[], sourceFile?: ts.SourceFile, typeArguments?: ts.Type[]): string;
 
     /**
      * Returns the mangled function name for the property access
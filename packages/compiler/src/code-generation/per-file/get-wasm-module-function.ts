@@ -9,9 +9,28 @@ declare function read(filename: string, type: "binary"): Uint8Array;
 declare function read(filename: string, type?: string): string;
 declare var window: any;
 
+// int64 values cross the boundary as BigInts, not part of the es2015 lib
+declare function BigInt(value: number | string | boolean): any;
+interface BigInt64Array extends ArrayLike<any> {
+    [index: number]: any;
+    set(values: ArrayLike<any>, offset?: number): void;
+    subarray(begin: number, end?: number): BigInt64Array;
+}
+declare var BigInt64Array: {
+    new (buffer: ArrayBuffer): BigInt64Array;
+    from(values: ArrayLike<any>, mapFn: (value: any) => any): BigInt64Array;
+};
+
 interface Type {
     primitive: boolean;
-    fields: Array<{ name: string, type: string }>;
+    /**
+     * The fields of an object with their byte offsets as laid out by the compiler
+     */
+    fields: Array<{ name: string, type: string, offset: int }>;
+    /**
+     * The size of an object in bytes
+     */
+    size: int;
     constructor?: Function;
     typeArguments: string[];
 }
@@ -23,6 +42,9 @@ interface Types {
 interface Options {
     totalStack: int;
     initialMemory: int;
+    maximumMemory: int;
+    memoryGrowthFactor: number;
+    reserveMemory: int;
     globalBase: int;
     staticBump: int;
 }
@@ -59,7 +81,9 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             case "i8":
                 return 1;
             case "i32":
+            case "u32":
                 return 4;
+            case "i64":
             case "double":
                 return 8;
             default: // all objects are pointers
@@ -73,11 +97,15 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             case "i8":
                 return heap8[ptr];
             case "i32":
-                return heap32[ptr >> 2] | 0;
+                return heap32[ptr >>> 2] | 0;
+            case "u32":
+                return heapU32[ptr >>> 2];
+            case "i64":
+                return getHeapI64()[ptr >>> 3];
             case "double":
-                return heap64[ptr >> 3];
+                return heap64[ptr >>> 3];
             default: // all objects are pointers
-                return heapPtr[ptr >> PTR_SHIFT] | 0;
+                return heapPtr[ptr >>> PTR_SHIFT];
         }
     }
 
@@ -88,19 +116,25 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 heap8[ptr] = value;
                 break;
             case "i32":
-                heap32[ptr >> 2] = value;
+            case "u32":
+                heap32[ptr >>> 2] = value;
+                break;
+            case "i64":
+                getHeapI64()[ptr >>> 3] = BigInt(value);
                 break;
             case "double":
-                heap64[ptr >> 3] = value;
+                heap64[ptr >>> 3] = value;
                 break;
             default: // all objects are pointers
-                heapPtr[ptr >> PTR_SHIFT] = value;
+                heapPtr[ptr >>> PTR_SHIFT] = value;
         }
     }
 
     let heap8: Int8Array;
     let heap32: Int32Array;
-    let heapPtr: Int32Array;
+    let heapU32: Uint32Array;
+    let heapI64: BigInt64Array | undefined;
+    let heapPtr: Uint32Array;
     let heap64: Float64Array;
 
     let malloc: (size: int) => int = () => { throw new Error("malloc not defined"); };
@@ -108,18 +142,23 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
 
     function updateHeap(buffer: ArrayBuffer) {
         heap8 = new Int8Array(buffer);
-        heap32 = heapPtr = new Int32Array(buffer);
+        heap32 = new Int32Array(buffer);
+        heapU32 = new Uint32Array(buffer);
+        heapI64 = undefined;
+        heapPtr = new Uint32Array(buffer);
         heap64 = new Float64Array(buffer);
     }
 
     /**
-     * Computes the size of a not packed object
+     * Returns the int64 view of the memory. The view is created on first use so that engines without BigInt support
+     * can load modules that do not pass int64 values to JavaScript.
      */
-    function computeObjectSize(type: Type) {
-        return type.fields.reduce((memo, field) => {
-            const fieldSize = sizeOf(field.type);
-            return alignMemory(memo + fieldSize, fieldSize);
-        }, 0);
+    function getHeapI64(): BigInt64Array {
+        if (!heapI64) {
+            heapI64 = new BigInt64Array(memory.buffer);
+        }
+
+        return heapI64;
     }
 
     function jsToWasm(jsValue: any, typeName: string, types: Types, objectReferences: Map<object, int>): any {
@@ -128,7 +167,7 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         if (!type) { throw new Error("Unknown type " + typeName); }
 
         if (type.primitive) {
-            return jsValue;
+            return typeName === "i64" ? BigInt(jsValue) : jsValue;
         }
 
         if (jsValue === null) {
@@ -160,20 +199,13 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 throw new Error(`Expected object of type ${type.constructor} but was ${jsValue.constructor} (inheritance is not supported).`);
             }
 
-            const size = computeObjectSize(type);
-            const objPtr = malloc(size);
+            const objPtr = malloc(type.size) >>> 0;
             if (objPtr === 0) {
                 throw new Error("Failed to allocate object");
             }
 
-            let offset = 0;
             for (const field of type.fields) {
-                const fieldSize = sizeOf(field.type);
-                offset = alignMemory(offset, fieldSize);
-
-                setHeapValue(objPtr + offset, jsToWasm(jsValue[field.name], field.type, types, objectReferences), field.type);
-
-                offset += fieldSize;
+                setHeapValue(objPtr + field.offset, jsToWasm(jsValue[field.name], field.type, types, objectReferences), field.type);
             }
 
             ptr = objPtr;
@@ -193,10 +225,14 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 return wasmValue !== 0;
             }
 
+            if (typeName === "u32") {
+                return (wasmValue as int) >>> 0; // wasm i32 values are signed in JS
+            }
+
             return wasmValue;
         }
 
-        const ptr = wasmValue as int;
+        const ptr = (wasmValue as int) >>> 0;
         let objectReference = returnedObjects.get(ptr);
 
         if (typeof objectReference !== "undefined") {
@@ -210,13 +246,9 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         } else {
             // Object
             const obj: { [name: string]: any } = Object.create(type.constructor!.prototype); // ensure it is an instance of the class
-            let memoryOffset = wasmValue as int;
 
             for (const field of type.fields) {
-                const fieldSize = sizeOf(field.type);
-                memoryOffset = alignMemory(memoryOffset, fieldSize);
-                obj[field.name] = wasmToJs(getHeapValue(memoryOffset, field.type), field.type, types, returnedObjects);
-                memoryOffset += fieldSize;
+                obj[field.name] = wasmToJs(getHeapValue(ptr + field.offset, field.type), field.type, types, returnedObjects);
             }
 
             objectReference = obj;
@@ -239,9 +271,9 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         static from(native: any[], elementType: string, types: Types, objectReferences: Map<object, int>): RuntimeArray {
             // begin, back, capacity
             const size = PTR_SIZE * 2 + sizeOf("i32");
-            const arrayPtr = malloc(size);
+            const arrayPtr = malloc(size) >>> 0;
             const elementSize = sizeOf(elementType);
-            const elementsPtr = malloc(elementSize * native.length);
+            const elementsPtr = malloc(elementSize * native.length) >>> 0;
 
             if (arrayPtr === 0 || elementsPtr === 0) {
                 throw new Error("Failed to allocate array");
@@ -250,9 +282,9 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             const begin = elementsPtr;
             const back = elementsPtr + (elementSize * native.length);
 
-            heapPtr[arrayPtr >> PTR_SHIFT] = begin;
-            heapPtr[(arrayPtr + PTR_SIZE) >> PTR_SHIFT] = back;
-            heap32[(arrayPtr + 2 * PTR_SIZE) >> 2] = native.length | 0;
+            heapPtr[arrayPtr >>> PTR_SHIFT] = begin;
+            heapPtr[(arrayPtr + PTR_SIZE) >>> PTR_SHIFT] = back;
+            heap32[(arrayPtr + 2 * PTR_SIZE) >>> 2] = native.length | 0;
 
             switch (elementType) {
                 case "i1":
@@ -260,13 +292,17 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                     heap8.set(native, begin);
                     break;
                 case "i32":
-                    heap32.set(native, begin >> 2);
+                case "u32":
+                    heap32.set(native, begin >>> 2);
+                    break;
+                case "i64":
+                    getHeapI64().set(BigInt64Array.from(native, value => BigInt(value)), begin >>> 3);
                     break;
                 case "double":
-                    heap64.set(native, begin >> 3);
+                    heap64.set(native, begin >>> 3);
                     break;
                 default:
-                    heapPtr.set(Int32Array.from(native, object => jsToWasm(object, elementType, types, objectReferences)), begin >> PTR_SHIFT);
+                    heapPtr.set(Uint32Array.from(native, object => jsToWasm(object, elementType, types, objectReferences)), begin >>> PTR_SHIFT);
             }
 
             return new RuntimeArray(arrayPtr, elementType);
@@ -276,11 +312,11 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         }
 
         get begin(): int {
-            return heapPtr[this.ptr >> PTR_SHIFT] | 0;
+            return heapPtr[this.ptr >>> PTR_SHIFT];
         }
 
         get back(): int {
-            return heapPtr[(this.ptr + PTR_SIZE) >> PTR_SHIFT] | 0;
+            return heapPtr[(this.ptr + PTR_SIZE) >>> PTR_SHIFT];
         }
 
         /**
@@ -296,29 +332,48 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                 case "i8":
                     return Array.from(heap8.subarray(this.begin, this.back));
                 case "i32":
-                    return Array.from(heap32.subarray(this.begin >> 2, this.back >> 2));
+                    return Array.from(heap32.subarray(this.begin >>> 2, this.back >>> 2));
+                case "u32":
+                    return Array.from(heapU32.subarray(this.begin >>> 2, this.back >>> 2));
+                case "i64":
+                    return Array.from(getHeapI64().subarray(this.begin >>> 3, this.back >>> 3));
                 case "double":
-                    return Array.from(heap64.subarray(this.begin >> 3, this.back >> 3));
+                    return Array.from(heap64.subarray(this.begin >>> 3, this.back >>> 3));
                 default:
                     return Array.from(
-                        heapPtr.subarray(this.begin >> PTR_SHIFT, this.back >> PTR_SHIFT),
+                        heapPtr.subarray(this.begin >>> PTR_SHIFT, this.back >>> PTR_SHIFT),
                         objectPtr => wasmToJs(objectPtr, this.elementType, types, objectReferences)
                     );
             }
         }
     }
 
+    const WASM_PAGE_SIZE = 64 * 1024;
+    // Memories larger than 2GB are only supported by recent engines and, therefore, require an explicit maximumMemory
+    const DEFAULT_MEMORY_LIMIT = 2 ** 31 - WASM_PAGE_SIZE;
+    const WASM_MEMORY_LIMIT = 2 ** 32 - WASM_PAGE_SIZE;
+
     const TOTAL_STACK = options.totalStack;
     const INITIAL_MEMORY = options.initialMemory;
-    let totalMemory: number = INITIAL_MEMORY;
+    // the memory is grown in whole pages, a maximum memory that is not page aligned can never be reached
+    const MAXIMUM_MEMORY = options.maximumMemory ? alignDown(Math.min(options.maximumMemory, WASM_MEMORY_LIMIT), WASM_PAGE_SIZE) : DEFAULT_MEMORY_LIMIT;
+    const MEMORY_GROWTH_FACTOR = Math.max(options.memoryGrowthFactor || 2, 1);
+    let totalMemory: number = alignUp(Math.max(INITIAL_MEMORY, options.reserveMemory || 0), WASM_PAGE_SIZE);
     const GLOBAL_BASE = options.globalBase;
     const STATIC_BUMP = options.staticBump;
 
-    const WASM_PAGE_SIZE = 64 * 1024;
-    const memory = new WebAssembly.Memory({ initial: INITIAL_MEMORY / WASM_PAGE_SIZE });
+    if (totalMemory > MAXIMUM_MEMORY) {
+        throw new Error("The initial or reserved memory of " + totalMemory + " bytes exceeds the maximum memory of " + MAXIMUM_MEMORY + " bytes.");
+    }
+
+    const memory = new WebAssembly.Memory(options.maximumMemory ?
+        { initial: totalMemory / WASM_PAGE_SIZE, maximum: MAXIMUM_MEMORY / WASM_PAGE_SIZE } :
+        { initial: totalMemory / WASM_PAGE_SIZE });
 
     heap8 = new Int8Array(memory.buffer);
-    heap32 = heapPtr = new Int32Array(memory.buffer);
+    heap32 = new Int32Array(memory.buffer);
+    heapU32 = new Uint32Array(memory.buffer);
+    heapPtr = new Uint32Array(memory.buffer);
     heap64 = new Float64Array(memory.buffer);
 
     const STATIC_TOP = GLOBAL_BASE + STATIC_BUMP;
@@ -334,45 +389,49 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
     heap32[DYNAMIC_TOP_PTR >> 2] = DYNAMIC_BASE;
 
     function growMemory(requestedSize: number) {
-        const limit = 2 ** 31 - WASM_PAGE_SIZE;
-        if (requestedSize > limit) {
-            throw new Error("Cannot grow memory larger than the WebAssembly limit of " + limit + " (requested: " + requestedSize + ").");
+        if (requestedSize > MAXIMUM_MEMORY) {
+            throw new Error("Out of memory: Cannot grow memory to " + requestedSize + " bytes, the maximum memory is " + MAXIMUM_MEMORY + " bytes.");
         }
 
         const oldSize = totalMemory;
-        while ((requestedSize | 0) > (totalMemory | 0)) {
-            if (totalMemory <= 536870912) { // grow fast to 2 gb
-                totalMemory = totalMemory * 2;
+        while (requestedSize > totalMemory) {
+            if (totalMemory <= 536870912) { // grow fast to 512mb
+                totalMemory = alignUp(totalMemory * MEMORY_GROWTH_FACTOR, WASM_PAGE_SIZE);
             } else {
-                const increase = alignUp((2 ** 31 - totalMemory) / 4, WASM_PAGE_SIZE);
-                totalMemory = Math.min(totalMemory + increase, limit);
+                totalMemory = totalMemory + alignUp((MAXIMUM_MEMORY - totalMemory) / 4, WASM_PAGE_SIZE);
             }
+
+            totalMemory = Math.min(Math.max(totalMemory, alignUp(requestedSize, WASM_PAGE_SIZE)), MAXIMUM_MEMORY);
         }
 
-        memory.grow((totalMemory - oldSize) / WASM_PAGE_SIZE);
+        try {
+            memory.grow((totalMemory - oldSize) / WASM_PAGE_SIZE);
+        } catch (e) {
+            totalMemory = oldSize;
+            throw new Error("Out of memory: Failed to grow memory to " + requestedSize + " bytes (" + e + ").");
+        }
         updateHeap(memory.buffer);
     }
 
     function sbrk(increment: number) {
-        increment = increment | 0;
-        let oldDynamicTop = 0;
-        let newDynamicTop = 0;
-        increment = ((increment + 15) & -16) | 0;
-        oldDynamicTop = heap32[DYNAMIC_TOP_PTR >> 2] | 0;
-        newDynamicTop = oldDynamicTop + increment | 0;
-
-        if (((increment | 0) > 0 && (newDynamicTop | 0) < (oldDynamicTop | 0)) // Detect and fail if we would wrap around signed 32-bit int.
-            || (newDynamicTop | 0) < 0) { // Also underflow, sbrk() should be able to be used to subtract.
+        // pointers are unsigned, the top of the heap might be above 2GB
+        increment = ((increment | 0) + 15) & -16;
+        const oldDynamicTop = heapPtr[DYNAMIC_TOP_PTR >>> PTR_SHIFT];
+        const newDynamicTop = oldDynamicTop + increment;
+
+        if (newDynamicTop > WASM_MEMORY_LIMIT // Detect and fail if we would wrap around the 32-bit address space.
+            || newDynamicTop < 0) { // Also underflow, sbrk() should be able to be used to subtract.
             // tslint:disable-next-line:no-console
-            console.error("Signed 32 wrap around detected");
+            console.error("Address space wrap around detected");
             return -1;
         }
 
-        heap32[DYNAMIC_TOP_PTR >> 2] = newDynamicTop;
-        if ((newDynamicTop | 0) > (totalMemory | 0)) {
+        if (newDynamicTop > totalMemory) {
             growMemory(newDynamicTop);
         }
-        return oldDynamicTop | 0;
+
+        heapPtr[DYNAMIC_TOP_PTR >>> PTR_SHIFT] = newDynamicTop;
+        return oldDynamicTop;
     }
 
     function alignMemory(size: int, quantum?: int): int {
@@ -386,6 +445,10 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
         return x;
     }
 
+    function alignDown(x: number, multiple: number) {
+        return x - (x % multiple);
+    }
+
     function loadInstance(): Promise<WebAssemblyInstance> {
         let instance: WebAssemblyInstance;
 
@@ -453,11 +516,8 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
                     __cxa_atexit() {
                         throw new Error("Exceptions not yet supported");
                     },
+                    // only used for non integer exponents, integer powers, round and fmod are implemented in the module
                     pow: Math.pow,
-                    round: Math.round,
-                    fmod(x: number, y: number) {
-                        return x % y;
-                    },
                     abort(what: any) {
                         // tslint:disable-next-line:no-console
                         console.error("Abort WASM for reason: " + what);
@@ -484,6 +544,12 @@ function __moduleLoader(this: any, wasmUri: string, options: Options): ModuleLoa
             instance = result.instance;
             free = instance.exports.free || free;
             malloc = instance.exports.malloc || malloc;
+
+            // Math.random should not return the same sequence for every instance, speedyJsSeedRandom allows to override the seed
+            if (instance.exports.speedyJsSeedRandomi) {
+                instance.exports.speedyJsSeedRandomi((Math.random() * 4294967296) | 0);
+            }
+
             return instance;
         });
     }
@@ -1,8 +1,10 @@
 import * as assert from "assert";
 import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {TypeChecker} from "../../type-checker";
 import {CodeGenerationContext} from "../code-generation-context";
-import {isMaybeObjectType} from "../util/types";
+import {isInt64Type, isMaybeObjectType, isSIMDVectorType, isUintType, isValueClassType} from "../util/types";
+import {SpeedyJSClassReference} from "../value/speedy-js-class-reference";
 import {PerFileSourceFileRewirter} from "./per-file-source-file-rewriter";
 
 import {MODULE_LOADER_FACTORY_NAME, PerFileWasmLoaderEmitHelper} from "./per-file-wasm-loader-emit-helper";
@@ -11,7 +13,8 @@ import {WastMetaData} from "./wast-meta-data";
 interface Types {
     [name: string]: {
         primitive: boolean,
-        fields: Array<{ name: string, type: string }>,
+        fields: Array<{ name: string, type: string, offset: number }>,
+        size: number,
         constructor?: ts.Identifier;
         typeArguments: string[];
     };
@@ -59,7 +62,7 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
 
         // types = { ... }
         const argumentTypes = signature.declaration.parameters.map(parameter => this.context.typeChecker.getTypeAtLocation(parameter));
-        const serializedTypes = this.serializeArgumentAndReturnTypes(argumentTypes, signature.getReturnType());
+        const serializedTypes = this.serializeArgumentAndReturnTypes(argumentTypes, signature.getReturnType(), functionDeclaration);
         const typesIdentifier = ts.createUniqueName("types");
         const typesDeclaration = ts.createVariableStatement(undefined , [ts.createVariableDeclaration(typesIdentifier, undefined, serializedTypes)]);
 
@@ -137,6 +140,9 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         const options = toLiteral({
             totalStack: compilerOptions.totalStack,
             initialMemory: compilerOptions.initialMemory,
+            maximumMemory: compilerOptions.maximumMemory,
+            memoryGrowthFactor: compilerOptions.memoryGrowthFactor,
+            reserveMemory: compilerOptions.reserveMemory,
             globalBase: compilerOptions.globalBase,
             staticBump,
             exposeGc: compilerOptions.exportGc || compilerOptions.exposeGc
@@ -201,7 +207,7 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
         return ts.createIdentifier(symbol.name);
     }
 
-    private serializeArgumentAndReturnTypes(argumentTypes: ts.Type[], returnType: ts.Type) {
+    private serializeArgumentAndReturnTypes(argumentTypes: ts.Type[], returnType: ts.Type, entryFunction: ts.FunctionDeclaration) {
         const types: Types = {};
         const typesToProcess = Array.from(new Set([...argumentTypes, returnType]));
 
@@ -218,8 +224,9 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
                 continue;
             }
 
-            const primitive = !!(type.flags & ts.TypeFlags.BooleanLike || type.flags & ts.TypeFlags.IntLike || type.flags & ts.TypeFlags.NumberLike);
-            let fields: Array<{ name: string, type: string }> = [];
+            const primitive = !!(type.flags & ts.TypeFlags.BooleanLike || type.flags & ts.TypeFlags.IntLike || type.flags & ts.TypeFlags.NumberLike) || isInt64Type(type) || isUintType(type);
+            let fields: Array<{ name: string, type: string, offset: number }> = [];
+            let size = 0;
             const typeArguments: string[] = [];
             let constructor: ts.Identifier | undefined;
 
@@ -227,18 +234,39 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
                 type = type.getNonNullableType();
             }
 
+            // JavaScript has no representation for SIMD vectors
+            if (isSIMDVectorType(type)) {
+                throw CodeGenerationDiagnostics.unsupportedSIMDVectorInEntryFunction(entryFunction, name);
+            }
+
             if (type.flags & ts.TypeFlags.Object) {
                 const objectType = type as ts.ObjectType;
                 const classReference = this.context.resolveClass(type);
                 assert(classReference, "Class Reference for argument or return type " + this.context.typeChecker.typeToString(type) + " not found.");
-                fields = classReference!.getFields(objectType, this.context).map(field => {
+
+                // The marshalling does not know the dynamic type of an object
+                if (classReference instanceof SpeedyJSClassReference && classReference.polymorphic) {
+                    throw CodeGenerationDiagnostics.unsupportedPolymorphicObjectInEntryFunction(entryFunction, type.getSymbol().getName());
+                }
+
+                // The marshalling expects a pointer to the object and not the object stored inline
+                if (isValueClassType(type)) {
+                    throw CodeGenerationDiagnostics.unsupportedValueObjectInEntryFunction(entryFunction, type.getSymbol().getName());
+                }
+
+                fields = classReference!.getFieldLayout(objectType, this.context).map(field => {
                     typesToProcess.push(field.type);
                     return {
                         name: field.name,
-                        type: serializedTypeName(field.type, this.context.typeChecker)
+                        type: serializedTypeName(field.type, this.context.typeChecker),
+                        offset: field.offset
                     };
                 });
 
+                if (fields.length > 0) {
+                    size = classReference!.getTypeStoreSize(objectType, this.context);
+                }
+
                 if (objectType.objectFlags & ts.ObjectFlags.Reference && (objectType as ts.TypeReference).typeArguments) {
                     const typeReference = objectType as ts.TypeReference;
                     typesToProcess.push(...typeReference.typeArguments);
@@ -251,6 +279,7 @@ export class PerFileCodeGeneratorSourceFileRewriter implements PerFileSourceFile
             types[name] = {
                 primitive,
                 fields,
+                size,
                 constructor,
                 typeArguments
             };
@@ -269,6 +298,10 @@ function serializedTypeName(type: ts.Type, typeChecker: TypeChecker): string {
         return "i1";
     } else if (type.flags & ts.TypeFlags.IntLike) {
         return "i32";
+    } else if (isInt64Type(type)) {
+        return "i64";
+    } else if (isUintType(type)) {
+        return "u32";
     } else if (type.flags & ts.TypeFlags.NumberLike) {
         return "double";
     } else if (type.flags & ts.TypeFlags.Object) {
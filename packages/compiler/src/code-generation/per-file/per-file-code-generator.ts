@@ -9,6 +9,7 @@ import {CompilationContext} from "../../compilation-context";
 import {wasmOpt} from "../../external-tools/binaryen-opt";
 import {s2wasm} from "../../external-tools/binaryen-s2wasm";
 import {wasmAs} from "../../external-tools/binaryen-wasm-as";
+import {llvmAs} from "../../external-tools/llvm-as";
 import {LLVMLink} from "../../external-tools/llvm-link";
 import {llc} from "../../external-tools/llvm-llc";
 import {optimize, optimizeLinked} from "../../external-tools/llvm-opt";
@@ -16,6 +17,7 @@ import {BuildDirectory} from "../build-directory";
 import {CodeGenerationContext} from "../code-generation-context";
 import {CodeGenerator} from "../code-generator";
 import {DefaultCodeGenerationContextFactory} from "../default-code-generation-context-factory";
+import {addFastMathFlags} from "../util/fast-math-flags";
 import {FunctionBuilder} from "../util/function-builder";
 import {createResolvedFunctionFromSignature} from "../value/resolved-function";
 import {NoopSourceFileRewriter} from "./llvm-emit-source-file-rewriter";
@@ -112,7 +114,7 @@ export class PerFileCodeGenerator implements CodeGenerator {
             };
 
             const biteCodeFileName = buildDirectory.getTempFileName(`${plainFileName}.bc`);
-            llvm.writeBitcodeToFile(context.module, biteCodeFileName);
+            PerFileCodeGenerator.writeBitcode(context, buildDirectory.getTempFileName(`${plainFileName}.ll`), biteCodeFileName);
 
             transforms.reduce((inputFileName, transformation) => transformation.transform(inputFileName, transformationContext), biteCodeFileName);
         }
@@ -120,6 +122,24 @@ export class PerFileCodeGenerator implements CodeGenerator {
         buildDirectory.remove();
     }
 
+    /**
+     * Writes the bitcode of the module. The fast math flags of the floating point instructions cannot be set using llvm-node.
+     * If the module or any function uses fast math, the flags are added to the textual IR that is then assembled to bitcode.
+     */
+    private static writeBitcode(context: CodeGenerationContext, llFileName: string, biteCodeFileName: string) {
+        const moduleFastMath = context.compilationContext.compilerOptions.fastMath;
+        const fastMathFunctions = new Set(context.getFastMathFunctionNames());
+
+        if (!moduleFastMath && fastMathFunctions.size === 0) {
+            llvm.writeBitcodeToFile(context.module, biteCodeFileName);
+            return;
+        }
+
+        const llvmIR = addFastMathFlags(context.module.print(), name => moduleFastMath || fastMathFunctions.has(name));
+        ts.sys.writeFile(llFileName, llvmIR);
+        llvmAs(llFileName, biteCodeFileName);
+    }
+
     private static createTransformationChain(context: CodeGenerationContext) {
         const optimizationLevel = context.compilationContext.compilerOptions.optimizationLevel;
 
@@ -201,9 +221,9 @@ interface TransformationStep {
 class OptimizationTransformationStep implements TransformationStep {
     transform(inputFileName: string, {plainFileName, buildDirectory, codeGenerationContext}: TransformationContext): string {
         const optimizedFileName = buildDirectory.getTempFileName(`${plainFileName}-opt.bc`);
-        const optimizationLevel = codeGenerationContext.compilationContext.compilerOptions.optimizationLevel;
+        const {optimizationLevel, fastMath} = codeGenerationContext.compilationContext.compilerOptions;
 
-        return optimize(inputFileName, optimizedFileName, optimizationLevel);
+        return optimize(inputFileName, optimizedFileName, optimizationLevel, fastMath);
     }
 }
 
@@ -241,8 +261,9 @@ class LinkTimeOptimizationTransformationStep implements TransformationStep {
     transform(inputFileName: string, {plainFileName, buildDirectory, codeGenerationContext}: TransformationContext): string {
         const optimizedFileName = buildDirectory.getTempFileName(`${plainFileName}-lopt.bc`);
         const entryFunctionNames = codeGenerationContext.getEntryFunctionNames();
+        const {optimizationLevel, fastMath} = codeGenerationContext.compilationContext.compilerOptions;
 
-        return optimizeLinked(inputFileName, entryFunctionNames, optimizedFileName, codeGenerationContext.compilationContext.compilerOptions.optimizationLevel);
+        return optimizeLinked(inputFileName, entryFunctionNames, optimizedFileName, optimizationLevel, fastMath);
     }
 }
 
@@ -264,8 +285,9 @@ class CopyFileToOutputDirectoryTransformationStep implements TransformationStep
 }
 
 class LLCTransformationStep implements TransformationStep {
-    transform(inputFileName: string, { plainFileName, buildDirectory }: TransformationContext): string {
-        return llc(inputFileName, buildDirectory.getTempFileName(`${plainFileName}.s`));
+    transform(inputFileName: string, { plainFileName, buildDirectory, codeGenerationContext }: TransformationContext): string {
+        const fastMath = codeGenerationContext.compilationContext.compilerOptions.fastMath;
+        return llc(inputFileName, buildDirectory.getTempFileName(`${plainFileName}.s`), fastMath);
     }
 }
 
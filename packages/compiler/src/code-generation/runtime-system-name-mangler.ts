@@ -13,6 +13,8 @@ import {Parameter} from "./name-mangler";
  * The name of a function is the declared name of the function including the encoded argument types. The following encoding is used for arguments
  * boolean:     b
  * int:         i
+ * uint:        j
+ * int64:       l
  * number:      d
  * Object:      Pv
  * Array:       Pti where t is the encoded element type
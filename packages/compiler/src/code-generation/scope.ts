@@ -1,6 +1,7 @@
 import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
+import {TailCallTarget} from "./util/tail-recursion";
 import {Allocation} from "./value/allocation";
 import {ClassReference} from "./value/class-reference";
 import {FunctionReference} from "./value/function-reference";
@@ -12,14 +13,16 @@ import {Value} from "./value/value";
 export class Scope {
     private variables = new Map<ts.Symbol, Value>();
     private functions: Map<ts.Symbol, FunctionReference>;
-    private classes: Map<ts.Symbol, ClassReference>;
+    private classes: Map<ts.Symbol | ts.Type, ClassReference>;
     private returnAlloca: Allocation | undefined;
+    private tailCall: TailCallTarget | undefined;
+    private unsafeCode: boolean | undefined;
     private labels: Map<string | Symbol, llvm.BasicBlock> = new Map();
     private children: Scope[] = [];
 
     constructor(private parent?: Scope, private fn?: llvm.Function) {
         this.functions = parent ? parent.functions : new Map<ts.Symbol, FunctionReference>();
-        this.classes = parent ? parent.classes : new Map<ts.Symbol, ClassReference>();
+        this.classes = parent ? parent.classes : new Map<ts.Symbol | ts.Type, ClassReference>();
     }
 
     /**
@@ -33,6 +36,33 @@ export class Scope {
         this.returnAlloca = allocation;
     }
 
+    /**
+     * The loop that replaces the self recursive tail calls of the enclosing function. Only present if the function has such tail calls.
+     */
+    get tailCallTarget(): TailCallTarget | undefined {
+        return this.tailCall || (this.parent && !this.fn ? this.parent.tailCallTarget : undefined);
+    }
+
+    set tailCallTarget(target: TailCallTarget | undefined) {
+        this.tailCall = target;
+    }
+
+    /**
+     * Indicator if the code of the enclosing function is emitted without memory safety checks, either because the whole
+     * module is compiled unsafe or because the function has the "use speedyjs unsafe" directive
+     */
+    get unsafe(): boolean {
+        if (typeof(this.unsafeCode) !== "undefined") {
+            return this.unsafeCode;
+        }
+
+        return !!this.parent && !this.fn && this.parent.unsafe;
+    }
+
+    set unsafe(unsafe: boolean) {
+        this.unsafeCode = unsafe;
+    }
+
     /**
      * Returns the block that is the target of a continue statement
      * @param label the name of the label or undefined for the default continue target
@@ -149,19 +179,24 @@ export class Scope {
         return fun!;
     }
 
-    addClass(symbol: ts.Symbol, classReference: ClassReference) {
-        assert(symbol, "symbol is undefined");
+    /**
+     * Adds a class to the scope
+     * @param symbolOrType the symbol of the class or the type for an instantiation of a generic class
+     * @param classReference the class
+     */
+    addClass(symbolOrType: ts.Symbol | ts.Type, classReference: ClassReference) {
+        assert(symbolOrType, "symbol is undefined");
         assert(classReference, "class reference is undefined");
-        assert(!this.classes.has(symbol), `class ${symbol.name} is already defined`);
+        assert(!this.classes.has(symbolOrType), `class ${classReference.name} is already defined`);
 
-        this.classes.set(symbol, classReference);
+        this.classes.set(symbolOrType, classReference);
     }
 
-    getClass(symbol: ts.Symbol): ClassReference {
-        assert(symbol, "symbol is undefined");
+    getClass(symbolOrType: ts.Symbol | ts.Type): ClassReference {
+        assert(symbolOrType, "symbol is undefined");
 
-        const cls = this.classes.get(symbol);
-        assert(cls, `Class ${symbol.name} is not defined in scope`);
+        const cls = this.classes.get(symbolOrType);
+        assert(cls, `Class ${getClassName(symbolOrType)} is not defined in scope`);
         return cls!;
     }
 
@@ -180,7 +215,11 @@ export class Scope {
         return this.functions.has(symbol);
     }
 
-    hasClass(symbol: ts.Symbol): boolean {
-        return this.classes.has(symbol);
+    hasClass(symbolOrType: ts.Symbol | ts.Type): boolean {
+        return this.classes.has(symbolOrType);
     }
 }
+
+function getClassName(symbolOrType: ts.Symbol | ts.Type) {
+    return (symbolOrType as ts.Symbol).name || (symbolOrType as ts.Type).getSymbol().name;
+}
@@ -0,0 +1,406 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {TypeChecker} from "../../type-checker";
+import {CodeGenerationContext} from "../code-generation-context";
+import {FunctionPointer} from "../value/function-reference";
+
+/**
+ * A function that is declared inside of another function and may reference the variables of the enclosing functions
+ */
+export type ClosureDeclaration = ts.FunctionExpression | ts.ArrowFunction | ts.FunctionDeclaration;
+
+/**
+ * A variable of an enclosing function that is stored in the environment record of a closure
+ */
+export interface CapturedVariable {
+    /**
+     * The symbol of the variable (the class symbol for the this object captured by an arrow function)
+     */
+    symbol: ts.Symbol;
+
+    /**
+     * The name of the variable
+     */
+    name: string;
+
+    /**
+     * The type of the variable
+     */
+    type: ts.Type;
+
+    /**
+     * Indicator if the record stores the address of the variable (shared with the enclosing function) or a copy of its value
+     */
+    byReference: boolean;
+}
+
+/**
+ * The environment record passed to a closure as first argument
+ */
+export interface ClosureEnvironment {
+    /**
+     * The type of the record, the function pointer followed by one field per captured variable
+     */
+    recordType: llvm.StructType;
+
+    /**
+     * The captured variables in the order of their fields
+     */
+    captures: CapturedVariable[];
+
+    /**
+     * The symbol and type of the closure if it calls itself, the record is the closure in this case
+     */
+    self?: { symbol: ts.Symbol, type: ts.Type };
+}
+
+/**
+ * Returns the llvm type of a function value. A function value is a pointer to a closure record
+ * that starts with the pointer to the function. The function expects the closure record as first argument.
+ * @param returnType the llvm return type of the function
+ * @param parameterTypes the llvm types of the parameters
+ * @param context the context
+ */
+export function getClosureType(returnType: llvm.Type, parameterTypes: llvm.Type[], context: CodeGenerationContext): llvm.PointerType {
+    const functionType = llvm.FunctionType.get(returnType, [llvm.Type.getInt8PtrTy(context.llvmContext), ...parameterTypes], false);
+    return llvm.StructType.get(context.llvmContext, [functionType.getPointerTo()], false).getPointerTo();
+}
+
+/**
+ * Returns the closure record of a function that does not capture any variables (e.g. a function declared on the top level).
+ * The record is a constant that references an adaptor function that drops the environment argument.
+ * @param fn the function
+ * @param context the context
+ * @return the pointer to the closure record of the function
+ */
+export function getFunctionClosure(fn: FunctionPointer, context: CodeGenerationContext): llvm.GlobalVariable {
+    const existing = context.module.getGlobalVariable(`${fn.name}.closure`, true);
+    if (existing) {
+        return existing;
+    }
+
+    const functionType = fn.type.elementType;
+    const parameterTypes: llvm.Type[] = [];
+    for (let i = 0; i < functionType.numParams; ++i) {
+        parameterTypes.push(functionType.getParamType(i));
+    }
+
+    const closureType = getClosureType(functionType.returnType, parameterTypes, context).elementType as llvm.StructType;
+    const adaptorType = closureType.getElementType(0) as llvm.PointerType;
+    const adaptor = llvm.Function.create(adaptorType.elementType as llvm.FunctionType, llvm.LinkageTypes.PrivateLinkage, `${fn.name}.adaptor`, context.module);
+    const [environment, ...args] = adaptor.getArguments();
+    environment.name = "environment";
+
+    if (fn instanceof llvm.Function) {
+        fn.getArguments().forEach((parameter, i) => args[i].name = parameter.name);
+    }
+
+    const builder = new llvm.IRBuilder(llvm.BasicBlock.create(context.llvmContext, "entry", adaptor));
+    if (functionType.returnType.isVoidTy()) {
+        builder.createCall(fn, args);
+        builder.createRetVoid();
+    } else {
+        builder.createRet(builder.createCall(fn, args, "result"));
+    }
+
+    const record = llvm.ConstantStruct.get(closureType, [adaptor]);
+    return new llvm.GlobalVariable(context.module, closureType, true, llvm.LinkageTypes.PrivateLinkage, record, `${fn.name}.closure`);
+}
+
+/**
+ * Tests if the given function is declared inside of another function
+ */
+export function isClosure(node: ts.Node): node is ClosureDeclaration {
+    return isFunctionLike(node) && !!getEnclosingFunction(node);
+}
+
+/**
+ * Returns the variables of the enclosing functions referenced by the closure in the order of their first use.
+ * The this object is captured by arrow functions that reference it.
+ * @param closure the closure
+ * @param typeChecker the type checker
+ * @return the symbols of the captured variables
+ */
+export function getCapturedVariables(closure: ClosureDeclaration, typeChecker: TypeChecker): ts.Symbol[] {
+    const outermostFunction = getOutermostFunction(closure);
+    const closureSymbol = getClosureSymbol(closure, typeChecker);
+    const captured: ts.Symbol[] = [];
+
+    function visit(node: ts.Node, inArrowFunction: boolean) {
+        if (node.kind === ts.SyntaxKind.ThisKeyword && inArrowFunction) {
+            const symbol = typeChecker.getSymbolAtLocation(node);
+            if (symbol && captured.indexOf(symbol) === -1) {
+                captured.push(symbol);
+            }
+        } else if (node.kind === ts.SyntaxKind.Identifier && !isPropertyName(node)) {
+            const symbol = typeChecker.getSymbolAtLocation(node);
+            const declaration = symbol ? symbol.valueDeclaration : undefined;
+
+            if (symbol && declaration && symbol.flags & (ts.SymbolFlags.Variable | ts.SymbolFlags.Function) &&
+                isInside(declaration, outermostFunction) && !isInside(declaration, closure) && symbol !== closureSymbol &&
+                captured.indexOf(symbol) === -1) {
+                captured.push(symbol);
+            }
+        }
+
+        // Function expressions and declarations have their own this object
+        const arrowFunction = isFunctionLike(node) ? inArrowFunction && node.kind === ts.SyntaxKind.ArrowFunction : inArrowFunction;
+        ts.forEachChild(node, child => visit(child, arrowFunction));
+    }
+
+    ts.forEachChild(closure, child => visit(child, closure.kind === ts.SyntaxKind.ArrowFunction));
+    return captured;
+}
+
+/**
+ * Returns the symbol through which the closure can call itself, the name of the function or the constant the function is assigned to
+ * @param closure the closure
+ * @param typeChecker the type checker
+ * @return the symbol or undefined for an anonymous function that is not assigned to a constant
+ */
+export function getClosureSymbol(closure: ClosureDeclaration, typeChecker: TypeChecker): ts.Symbol | undefined {
+    if (closure.name) {
+        return typeChecker.getSymbolAtLocation(closure.name);
+    }
+
+    let node: ts.Node = closure;
+    while (node.parent && node.parent.kind === ts.SyntaxKind.ParenthesizedExpression) {
+        node = node.parent;
+    }
+
+    const parent = node.parent!;
+    if (parent.kind === ts.SyntaxKind.VariableDeclaration && (parent as ts.VariableDeclaration).name.kind === ts.SyntaxKind.Identifier &&
+        parent.parent!.flags & ts.NodeFlags.Const) {
+        return typeChecker.getSymbolAtLocation((parent as ts.VariableDeclaration).name);
+    }
+
+    return undefined;
+}
+
+/**
+ * Tests if the closure calls itself
+ */
+export function isRecursiveClosure(closure: ClosureDeclaration, typeChecker: TypeChecker): boolean {
+    const symbol = getClosureSymbol(closure, typeChecker);
+    return !!symbol && getReferences(symbol, closure.body!, typeChecker).length > 0;
+}
+
+/**
+ * Tests if the closure may be used after the enclosing function has returned. A closure does not escape if it is
+ * only called or passed to functions that only call it (e.g. a comparator passed to array.sort).
+ * The environment of a closure that does not escape can be allocated on the stack of the enclosing function.
+ * @param closure the closure
+ * @param typeChecker the type checker
+ * @return true if the closure escapes
+ */
+export function isEscapingClosure(closure: ClosureDeclaration, typeChecker: TypeChecker): boolean {
+    if (closure.kind === ts.SyntaxKind.FunctionDeclaration) {
+        return isEscapingSymbol(typeChecker.getSymbolAtLocation(closure.name!), typeChecker, new Set<ts.Symbol>());
+    }
+
+    return isEscapingExpression(closure, typeChecker, new Set<ts.Symbol>());
+}
+
+/**
+ * Returns an assignment to the given variable other than its initialization
+ * @param symbol the symbol of the variable
+ * @param typeChecker the type checker
+ * @return the assignment or undefined if the variable is never reassigned
+ */
+export function findReassignment(symbol: ts.Symbol, typeChecker: TypeChecker): ts.Node | undefined {
+    const declaration = symbol.valueDeclaration;
+    const container = declaration ? getEnclosingFunction(declaration) : undefined;
+
+    if (!container || !container.body) {
+        return undefined;
+    }
+
+    return getReferences(symbol, container.body, typeChecker)
+        .map(reference => getAssignment(reference))
+        .find(assignment => !!assignment);
+}
+
+function isEscapingExpression(expression: ts.Expression, typeChecker: TypeChecker, visited: Set<ts.Symbol>): boolean {
+    let node: ts.Node = expression;
+    while (node.parent && node.parent.kind === ts.SyntaxKind.ParenthesizedExpression) {
+        node = node.parent;
+    }
+
+    const parent = node.parent!;
+    switch (parent.kind) {
+        case ts.SyntaxKind.CallExpression:
+            const callExpression = parent as ts.CallExpression;
+            if (callExpression.expression === node) {
+                return false;
+            }
+
+            return isRetainingArgument(callExpression, callExpression.arguments.indexOf(node as ts.Expression), typeChecker, visited);
+
+        case ts.SyntaxKind.VariableDeclaration:
+            const variableDeclaration = parent as ts.VariableDeclaration;
+            const isConst = !!(variableDeclaration.parent!.flags & ts.NodeFlags.Const);
+
+            if (variableDeclaration.initializer === node && isConst && variableDeclaration.name.kind === ts.SyntaxKind.Identifier) {
+                return isEscapingSymbol(typeChecker.getSymbolAtLocation(variableDeclaration.name), typeChecker, visited);
+            }
+
+            return true;
+
+        default:
+            return true;
+    }
+}
+
+/**
+ * Tests if any use of the variable or parameter holding a function lets the function escape
+ */
+function isEscapingSymbol(symbol: ts.Symbol, typeChecker: TypeChecker, visited: Set<ts.Symbol>): boolean {
+    if (visited.has(symbol)) {
+        return false;
+    }
+
+    visited.add(symbol);
+
+    const declaration = symbol.valueDeclaration!;
+    const container = getEnclosingFunction(declaration);
+    if (!container || !container.body) {
+        return true;
+    }
+
+    return getReferences(symbol, container.body, typeChecker).some(reference => {
+        if (isInside(reference, declaration)) {
+            return false; // recursive call of a nested function
+        }
+
+        // the function is used by another closure that might escape itself
+        if (getEnclosingFunction(reference) !== container) {
+            return true;
+        }
+
+        return isEscapingExpression(reference, typeChecker, visited);
+    });
+}
+
+/**
+ * Tests if the called function retains the function passed as argument beyond the call
+ */
+function isRetainingArgument(callExpression: ts.CallExpression, index: number, typeChecker: TypeChecker, visited: Set<ts.Symbol>): boolean {
+    const signature = typeChecker.getResolvedSignature(callExpression);
+    const declaration = signature.declaration as ts.FunctionLikeDeclaration;
+
+    // The body of runtime methods and of functions called through a function value is unknown. Only the runtime methods
+    // known to call the passed function without storing it (e.g. array.sort) do not retain it, others might (e.g. array.push)
+    if (!declaration.body) {
+        return !isCallOnlyRuntimeMethod(declaration);
+    }
+
+    const parameter = declaration.parameters[index];
+    if (!parameter || parameter.dotDotDotToken || parameter.name.kind !== ts.SyntaxKind.Identifier) {
+        return true;
+    }
+
+    return isEscapingSymbol(typeChecker.getSymbolAtLocation(parameter.name), typeChecker, visited);
+}
+
+/**
+ * The runtime methods that call the passed functions during the call but never store them
+ */
+const CALL_ONLY_RUNTIME_METHODS: { [className: string]: string[] } = {
+    Array: ["sort"]
+};
+
+function isCallOnlyRuntimeMethod(declaration: ts.SignatureDeclaration): boolean {
+    if (declaration.kind !== ts.SyntaxKind.MethodSignature || !declaration.getSourceFile().isDeclarationFile) {
+        return false;
+    }
+
+    const parent = declaration.parent;
+    if (!parent || parent.kind !== ts.SyntaxKind.InterfaceDeclaration || !declaration.name || declaration.name.kind !== ts.SyntaxKind.Identifier) {
+        return false;
+    }
+
+    const methods = CALL_ONLY_RUNTIME_METHODS[(parent as ts.InterfaceDeclaration).name.text] || [];
+    return methods.indexOf((declaration.name as ts.Identifier).text) !== -1;
+}
+
+function getReferences(symbol: ts.Symbol, node: ts.Node, typeChecker: TypeChecker): ts.Identifier[] {
+    const references: ts.Identifier[] = [];
+
+    function visit(current: ts.Node) {
+        if (current.kind === ts.SyntaxKind.Identifier && !isPropertyName(current) && typeChecker.getSymbolAtLocation(current) === symbol) {
+            references.push(current as ts.Identifier);
+        }
+
+        ts.forEachChild(current, visit);
+    }
+
+    visit(node);
+    return references;
+}
+
+function getAssignment(reference: ts.Identifier): ts.Node | undefined {
+    let node: ts.Node = reference;
+    while (node.parent && node.parent.kind === ts.SyntaxKind.ParenthesizedExpression) {
+        node = node.parent;
+    }
+
+    const parent = node.parent!;
+    switch (parent.kind) {
+        case ts.SyntaxKind.BinaryExpression:
+            const binaryExpression = parent as ts.BinaryExpression;
+            const operator = binaryExpression.operatorToken.kind;
+            const isAssignment = operator >= ts.SyntaxKind.FirstAssignment && operator <= ts.SyntaxKind.LastAssignment;
+            return isAssignment && binaryExpression.left === node ? parent : undefined;
+
+        case ts.SyntaxKind.PrefixUnaryExpression:
+        case ts.SyntaxKind.PostfixUnaryExpression:
+            const operatorKind = (parent as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression).operator;
+            return operatorKind === ts.SyntaxKind.PlusPlusToken || operatorKind === ts.SyntaxKind.MinusMinusToken ? parent : undefined;
+
+        default:
+            return undefined;
+    }
+}
+
+function getEnclosingFunction(node: ts.Node): ts.FunctionLikeDeclaration | undefined {
+    let current = node.parent;
+    while (current && !isFunctionLike(current)) {
+        current = current.parent;
+    }
+
+    return current as ts.FunctionLikeDeclaration | undefined;
+}
+
+function getOutermostFunction(closure: ClosureDeclaration): ts.FunctionLikeDeclaration {
+    let outermost: ts.FunctionLikeDeclaration = closure;
+    for (let current = getEnclosingFunction(closure); current; current = getEnclosingFunction(current)) {
+        outermost = current;
+    }
+
+    return outermost;
+}
+
+function isFunctionLike(node: ts.Node): node is ts.FunctionLikeDeclaration {
+    switch (node.kind) {
+        case ts.SyntaxKind.FunctionDeclaration:
+        case ts.SyntaxKind.FunctionExpression:
+        case ts.SyntaxKind.ArrowFunction:
+        case ts.SyntaxKind.MethodDeclaration:
+        case ts.SyntaxKind.Constructor:
+            return true;
+        default:
+            return false;
+    }
+}
+
+function isPropertyName(identifier: ts.Node) {
+    const parent = identifier.parent!;
+    return parent.kind === ts.SyntaxKind.PropertyAccessExpression && (parent as ts.PropertyAccessExpression).name === identifier;
+}
+
+/**
+ * Tests if the given node is a descendant of the container node (or the container itself)
+ */
+export function isInside(node: ts.Node, container: ts.Node) {
+    return node.pos >= container.pos && node.end <= container.end && node.getSourceFile() === container.getSourceFile();
+}
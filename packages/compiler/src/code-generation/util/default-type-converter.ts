@@ -4,7 +4,17 @@ import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 
 import {CodeGenerationContext} from "../code-generation-context";
 import {ClassReference} from "../value/class-reference";
-import {getCallSignature, isFunctionType, isMaybeObjectType} from "./types";
+import {getClosureType} from "./closures";
+import {
+    getCallSignature,
+    getSIMDVectorKind,
+    isFunctionType,
+    isInt64Type,
+    isMaybeObjectType,
+    isUintType,
+    isValueClassType,
+    SIMDVectorKind
+} from "./types";
 import {TypePlace, TypeScriptToLLVMTypeConverter} from "./typescript-to-llvm-type-converter";
 
 export class DefaultTypeConverter implements TypeScriptToLLVMTypeConverter {
@@ -21,10 +31,14 @@ export class DefaultTypeConverter implements TypeScriptToLLVMTypeConverter {
             return this.getAnyType(place);
         }
 
-        if (type.flags & ts.TypeFlags.IntLike) {
+        if (type.flags & ts.TypeFlags.IntLike || isUintType(type)) {
             return this.getIntType(place);
         }
 
+        if (isInt64Type(type)) {
+            return this.getInt64Type(place);
+        }
+
         if (type.flags & ts.TypeFlags.NumberLike) {
             return this.getNumberType(place);
         }
@@ -44,11 +58,20 @@ export class DefaultTypeConverter implements TypeScriptToLLVMTypeConverter {
         if (isFunctionType(type)) {
             const callSignature = getCallSignature(type);
             const declaration = callSignature.getDeclaration();
+            // Value objects are passed by value to function values as well
             const parameterTypes = callSignature.getParameters().map((p, i) => {
-                return this.convert(this.context.typeChecker.getTypeOfSymbolAtLocation(p, declaration.parameters[i]), place & TypePlace.PARAMETER);
+                const parameterType = this.context.typeChecker.getTypeOfSymbolAtLocation(p, declaration.parameters[i]);
+                return this.convert(parameterType, isValueClassType(parameterType) ? TypePlace.PARAMETER : place & TypePlace.PARAMETER);
             });
 
-            return llvm.FunctionType.get(this.convert(callSignature.getReturnType(), place & TypePlace.RETURN_VALUE), parameterTypes, false).getPointerTo();
+            const returnType = callSignature.getReturnType();
+            const returnPlace = isValueClassType(returnType) ? TypePlace.RETURN_VALUE : place & TypePlace.RETURN_VALUE;
+            return getClosureType(this.convert(returnType, returnPlace), parameterTypes, this.context);
+        }
+
+        const simdVectorKind = getSIMDVectorKind(type);
+        if (simdVectorKind) {
+            return this.getSIMDVectorType(simdVectorKind, place);
         }
 
         if (type.flags & ts.TypeFlags.Object) {
@@ -81,6 +104,10 @@ export class DefaultTypeConverter implements TypeScriptToLLVMTypeConverter {
         return llvm.Type.getInt32Ty(this.llvmContext);
     }
 
+    protected getInt64Type(place: TypePlace) {
+        return llvm.Type.getInt64Ty(this.llvmContext);
+    }
+
     protected getBooleanType(place: TypePlace) {
         return llvm.Type.getInt1Ty(this.llvmContext);
     }
@@ -97,7 +124,18 @@ export class DefaultTypeConverter implements TypeScriptToLLVMTypeConverter {
         return llvm.Type.getInt8PtrTy(this.llvmContext);
     }
 
+    protected getSIMDVectorType(kind: SIMDVectorKind, place: TypePlace): llvm.Type {
+        // The lanes are stored in an array value that is passed by value, the vectorizer packs the lane operations
+        const laneType = kind.floatingPoint ? this.getNumberType(place) : this.getIntType(place);
+        return llvm.ArrayType.get(laneType, kind.lanes);
+    }
+
     protected getObjectType(objectType: ts.ObjectType, classReference: ClassReference, place: TypePlace): llvm.Type {
+        // Value objects are stored inline and passed by value. Inside of a function, they are referenced by the address of their storage
+        if (isValueClassType(objectType) && (place === TypePlace.FIELD || place === TypePlace.PARAMETER || place === TypePlace.RETURN_VALUE)) {
+            return classReference.getLLVMType(objectType, this.context);
+        }
+
         return classReference.getLLVMType(objectType, this.context).getPointerTo();
     }
 }
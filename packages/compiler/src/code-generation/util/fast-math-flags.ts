@@ -0,0 +1,27 @@
+const FUNCTION_DEFINITION = /^define [^@]*@("[^"]*"|[-a-zA-Z$._0-9]+)\(/;
+const FLOATING_POINT_INSTRUCTION = /^(\s*%[-a-zA-Z$._0-9]+ = )(fadd|fsub|fmul|fdiv|frem|fcmp) (?!fast )/;
+
+/**
+ * Sets the fast math flags on the floating point instructions (fadd, fsub, fmul, fdiv, frem and fcmp) of the given functions.
+ * llvm-node cannot set the flags on instructions, therefore, the flags are added to the textual IR of the module.
+ * @param llvmIR the textual IR of the module
+ * @param isFastMathFunction returns true if the flags are to be set on the instructions of the function with the given name
+ * @return the textual IR with the fast math flags
+ */
+export function addFastMathFlags(llvmIR: string, isFastMathFunction: (name: string) => boolean): string {
+    let fastMath = false;
+
+    return llvmIR.split("\n").map(line => {
+        const definition = FUNCTION_DEFINITION.exec(line);
+
+        if (definition) {
+            fastMath = isFastMathFunction(definition[1].replace(/^"(.*)"$/, "$1"));
+        } else if (line === "}") {
+            fastMath = false;
+        } else if (fastMath) {
+            return line.replace(FLOATING_POINT_INSTRUCTION, "$1$2 fast ");
+        }
+
+        return line;
+    }).join("\n");
+}
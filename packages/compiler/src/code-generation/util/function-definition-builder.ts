@@ -2,18 +2,28 @@ import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {getSpeedyJSDirective} from "../../util/speedyjs-function";
 import {CodeGenerationContext} from "../code-generation-context";
 import {Allocation} from "../value/allocation";
 import {ArrayClassReference} from "../value/array-class-reference";
 import {ObjectReference} from "../value/object-reference";
+import {AddressLValue} from "../value/address-lvalue";
 import {ResolvedFunction} from "../value/resolved-function";
 import {Value} from "../value/value";
+import {ClosureEnvironment} from "./closures";
+import {analyzeTailRecursion} from "./tail-recursion";
+import {isValueClassType, toValueObjectStruct} from "./types";
 
 export class FunctionDefinitionBuilder {
     // tslint:disable-next-line:variable-name
     private _returnValue: Value | undefined = undefined;
     // tslint:disable-next-line:variable-name
     private _self: ObjectReference | undefined;
+    // tslint:disable-next-line:variable-name
+    private _environment: ClosureEnvironment | undefined;
+    // tslint:disable-next-line:variable-name
+    private _unsafe = false;
 
     private constructor(private fn: llvm.Function, private resolvedFunction: ResolvedFunction, private context: CodeGenerationContext) {
     }
@@ -51,12 +61,36 @@ export class FunctionDefinitionBuilder {
         return this;
     }
 
+    /**
+     * Defines the function as closure that receives its environment record as first argument
+     * @param environment the layout of the environment record
+     * @return {FunctionDefinitionBuilder} this for a fluent api
+     */
+    environment(environment?: ClosureEnvironment) {
+        this._environment = environment;
+        return this;
+    }
+
+    /**
+     * Emits the function without memory safety checks even if the function has no "use speedyjs unsafe" directive,
+     * e.g. for a closure nested inside of an unsafe function
+     * @param unsafe true if the function is unsafe
+     * @return {FunctionDefinitionBuilder} this for a fluent api
+     */
+    unsafe(unsafe: boolean) {
+        this._unsafe = unsafe;
+        return this;
+    }
+
     /**
      * Builds / Generates the llvm.Function for the function definition of the resolved function
      */
     define(): void {
         this.context.enterChildScope(this.fn);
 
+        const directive = getSpeedyJSDirective(this.definition);
+        this.context.scope.unsafe = this.context.compilationContext.compilerOptions.unsafe || this._unsafe || (!!directive && directive.unsafe);
+
         const entryBlock = this.fn.getEntryBlock() || llvm.BasicBlock.create(this.context.llvmContext, "entry", this.fn);
         const returnBlock = llvm.BasicBlock.create(this.context.llvmContext, "returnBlock");
         this.context.builder.setInsertionPoint(entryBlock);
@@ -66,8 +100,14 @@ export class FunctionDefinitionBuilder {
             this.context.scope.returnAllocation = Allocation.create(this.resolvedFunction.returnType, this.context, "return");
         }
 
-        this.allocateArguments();
-        this.context.generate(this.definition.body);
+        const parameterAllocations = this.allocateArguments();
+        this.enterTailRecursionLoop(parameterAllocations);
+
+        if (this.definition.body.kind === ts.SyntaxKind.Block) {
+            this.context.generate(this.definition.body);
+        } else {
+            this.generateExpressionBody(this.definition.body as ts.Expression);
+        }
 
         this.setBuilderToReturnBlock(returnBlock);
         this.generateReturnStatement();
@@ -77,11 +117,64 @@ export class FunctionDefinitionBuilder {
         // llvm.verifyFunction(this.fn);
     }
 
+    /**
+     * Replaces the self recursive tail calls of the function with jumps to the start of the function body.
+     * Accumulating tail calls, e.g. return n * factorial(n - 1), combine the operand with the accumulator instead
+     * and the accumulator is applied to the value of the non recursive return statements.
+     */
+    private enterTailRecursionLoop(parameters: Allocation[]) {
+        if (this.resolvedFunction.classType || this._returnValue || this._environment) {
+            return;
+        }
+
+        const tailRecursion = analyzeTailRecursion(this.definition, this.context.typeChecker);
+        if (!tailRecursion) {
+            return;
+        }
+
+        let accumulator: Allocation | undefined;
+        if (tailRecursion.accumulatorOperator) {
+            const identity = tailRecursion.accumulatorOperator === ts.SyntaxKind.PlusToken ? 0 : 1;
+            accumulator = Allocation.create(this.resolvedFunction.returnType, this.context, "accumulator");
+            accumulator.generateAssignmentIR(llvm.ConstantInt.get(this.context.llvmContext, identity), this.context);
+        }
+
+        const block = llvm.BasicBlock.create(this.context.llvmContext, "tailrecurse", this.fn);
+        this.context.builder.createBr(block);
+        this.context.builder.setInsertionPoint(block);
+
+        this.context.scope.tailCallTarget = Object.assign({ block, parameters, accumulator }, tailRecursion);
+    }
+
+    /**
+     * Returns the value of the expression body of an arrow function (e.g. x => x * 2)
+     */
+    private generateExpressionBody(body: ts.Expression) {
+        const value = this.context.generateValue(body);
+
+        if (this.context.scope.returnAllocation) {
+            const casted = value.castImplicit(this.resolvedFunction.returnType, this.context);
+
+            if (!casted) {
+                throw CodeGenerationDiagnostics.unsupportedImplicitCast(
+                    body,
+                    this.context.typeChecker.typeToString(this.resolvedFunction.returnType),
+                    this.context.typeChecker.typeToString(this.context.typeChecker.getTypeAtLocation(body))
+                );
+            }
+
+            this.context.scope.returnAllocation.generateAssignmentIR(casted, this.context);
+        }
+
+        this.context.builder.createBr(this.context.scope.returnBlock!);
+    }
+
     private generateReturnStatement() {
         if (this.context.scope.returnAllocation) {
             this.context.builder.createRet(this.context.scope.returnAllocation.generateIR(this.context));
         } else if (this._returnValue) {
-            this.context.builder.createRet(this._returnValue.generateIR(this.context));
+            const returnValue = this._returnValue.generateIR(this.context);
+            this.context.builder.createRet(toValueObjectStruct(returnValue, this.resolvedFunction.returnType, this.context));
         } else {
             this.context.builder.createRetVoid();
         }
@@ -104,18 +197,35 @@ export class FunctionDefinitionBuilder {
         }
     }
 
-    private allocateArguments() {
+    private allocateArguments(): Allocation[] {
         const args = this.fn.getArguments().slice();
+        const allocations: Allocation[] = [];
+
+        // The environment record of a closure is passed as first argument
+        if (this._environment) {
+            const environment = args.shift()!;
+            environment.name = "environment";
+            this.bindEnvironment(environment, this._environment);
+        }
 
         // The this object is passed as first argument
         if (this.resolvedFunction.classType && this.resolvedFunction.instanceMethod) {
             assert(args.length - 1 === this.resolvedFunction.parameters.length, "The function declaration has no additional argument for the this object");
 
-            const thisAllocation = Allocation.create(this.resolvedFunction.classType!, this.context, "this");
+            const classType = this.resolvedFunction.classType;
             const thisArg = args.shift()!;
-            thisAllocation.generateAssignmentIR(thisArg, this.context);
-            thisArg.name = "this";
-            this.context.scope.addVariable(this.resolvedFunction.classType.getSymbol(), thisAllocation);
+
+            // Methods of a value class operate on the storage of the value object
+            if (isValueClassType(classType)) {
+                thisArg.name = "this";
+                const object = this.context.resolveClass(classType)!.objectFor(new AddressLValue(thisArg, classType), classType, this.context);
+                this.context.scope.addVariable(classType.getSymbol(), object);
+            } else {
+                const thisAllocation = Allocation.create(classType, this.context, "this");
+                thisAllocation.generateAssignmentIR(thisArg, this.context);
+                thisArg.name = "this";
+                this.context.scope.addVariable(classType.getSymbol(), thisAllocation);
+            }
         }
 
         for (let i = 0; i < this.resolvedFunction.parameters.length; ++i) {
@@ -134,15 +244,44 @@ export class FunctionDefinitionBuilder {
             }
 
             this.context.scope.addVariable(declaredParameterSymbol, allocation);
+            allocations.push(allocation);
 
             // a field in a constructor that is marked with private, protected or public. Set the argument value on the field.
             if (this._self && declaredParameterSymbol.flags & ts.SymbolFlags.Property) {
-                const fieldOffset = llvm.ConstantInt.get(this.context.llvmContext, this._self.clazz.getFieldOffset(declaredParameterSymbol));
+                const fieldOffset = llvm.ConstantInt.get(this.context.llvmContext, this._self.clazz.getFieldOffset(declaredParameterSymbol, this.context));
                 const fieldIndex = [ llvm.ConstantInt.get(this.context.llvmContext, 0), fieldOffset ];
                 const thiz = this._self.generateIR(this.context);
                 const fieldAddress = this.context.builder.createInBoundsGEP(thiz, fieldIndex, `&${declaredParameterSymbol.name}`);
                 this.context.builder.createAlignedStore(args[i], fieldAddress, Allocation.getPreferredValueAlignment(parameter.type, this.context));
             }
         }
+
+        return allocations;
+    }
+
+    /**
+     * Adds the variables captured in the environment record to the scope of the closure
+     */
+    private bindEnvironment(environment: llvm.Value, { recordType, captures, self }: ClosureEnvironment) {
+        const record = captures.length > 0 ? this.context.builder.createBitCast(environment, recordType.getPointerTo(), "record") : undefined;
+
+        captures.forEach((capture, i) => {
+            const fieldIndex = [ llvm.ConstantInt.get(this.context.llvmContext, 0), llvm.ConstantInt.get(this.context.llvmContext, i + 1) ];
+            let address = this.context.builder.createInBoundsGEP(record!, fieldIndex, `&${capture.name}`);
+
+            // variables captured by reference are shared with the enclosing function, the record stores their address
+            if (capture.byReference) {
+                const pointerType = recordType.getElementType(i + 1);
+                const alignment = Allocation.getPreferredValueAlignment(pointerType, this.context);
+                address = this.context.builder.createAlignedLoad(address, alignment, `${capture.name}.ref`);
+            }
+
+            this.context.scope.addVariable(capture.symbol, Allocation.fromAddress(address, capture.type, this.context, capture.name));
+        });
+
+        if (self) {
+            const closure = this.context.builder.createBitCast(environment, this.context.toLLVMType(self.type), self.symbol.name);
+            this.context.scope.addVariable(self.symbol, this.context.value(closure, self.type));
+        }
     }
 }
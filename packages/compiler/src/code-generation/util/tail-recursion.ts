@@ -0,0 +1,233 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {TypeChecker} from "../../type-checker";
+import {Allocation} from "../value/allocation";
+
+/**
+ * A return statement that calls the enclosing function recursively and that can be replaced by a jump to the
+ * start of the function
+ */
+export interface TailCall {
+    /**
+     * The recursive call of the enclosing function
+     */
+    call: ts.CallExpression;
+
+    /**
+     * The operand that is combined with the result of the recursive call, e.g. n in return n * factorial(n - 1).
+     * Absent for a plain tail call (return f(x))
+     */
+    accumulated?: ts.Expression;
+}
+
+/**
+ * The tail calls of a self recursive function
+ */
+export interface TailRecursion {
+    /**
+     * The tail calls of the function by return statement
+     */
+    tailCalls: Map<ts.ReturnStatement, TailCall>;
+
+    /**
+     * The operator that combines the result of the recursive calls with the accumulated operands, if any
+     */
+    accumulatorOperator?: ts.SyntaxKind.PlusToken | ts.SyntaxKind.AsteriskToken;
+}
+
+/**
+ * The loop that replaces the tail calls of a self recursive function
+ */
+export interface TailCallTarget extends TailRecursion {
+    /**
+     * The block after the argument initialization to which the tail calls jump
+     */
+    block: llvm.BasicBlock;
+
+    /**
+     * The allocations of the parameters, one per parameter of the function
+     */
+    parameters: Allocation[];
+
+    /**
+     * The running value of the accumulator, present if accumulatorOperator is set
+     */
+    accumulator?: Allocation;
+}
+
+/**
+ * Finds the return statements of the given function that call the function itself and can be replaced with a loop.
+ *
+ * These are either direct tail calls, return f(x), or int additions or multiplications with a recursive call,
+ * return x * f(x - 1). The latter are rewritten to tail calls by introducing an accumulator that holds the
+ * product / sum of the operands, what is valid as int addition and multiplication are associative and commutative.
+ * @param declaration the declaration of the function
+ * @param typeChecker the type checker
+ * @return the found tail recursion or undefined if the function is not tail recursive
+ */
+export function analyzeTailRecursion(declaration: ts.FunctionLikeDeclaration, typeChecker: TypeChecker): TailRecursion | undefined {
+    if (declaration.kind !== ts.SyntaxKind.FunctionDeclaration || !declaration.name || !declaration.body || declaration.typeParameters) {
+        return undefined;
+    }
+
+    if (declaration.modifiers && declaration.modifiers.some(modifier => modifier.kind === ts.SyntaxKind.AsyncKeyword)) {
+        return undefined;
+    }
+
+    if (declaration.parameters.some(parameter => !!(parameter.questionToken || parameter.initializer || parameter.dotDotDotToken))) {
+        return undefined;
+    }
+
+    const symbol = typeChecker.getSymbolAtLocation(declaration.name);
+    if (!symbol || symbol.declarations.length !== 1) {
+        return undefined;
+    }
+
+    const tailCalls = new Map<ts.ReturnStatement, TailCall>();
+    const accumulatorOperators = new Set<ts.SyntaxKind>();
+
+    for (const returnStatement of getReturnStatements(declaration.body)) {
+        const expression = skipParentheses(returnStatement.expression);
+
+        if (isSelfCall(expression, declaration, symbol, typeChecker)) {
+            tailCalls.set(returnStatement, { call: expression as ts.CallExpression });
+            continue;
+        }
+
+        const accumulatedCall = getAccumulatedCall(expression, declaration, symbol, typeChecker);
+        if (accumulatedCall) {
+            tailCalls.set(returnStatement, accumulatedCall);
+            accumulatorOperators.add((expression as ts.BinaryExpression).operatorToken.kind);
+        }
+    }
+
+    // an accumulator can only combine the results with a single operator
+    if (tailCalls.size === 0 || accumulatorOperators.size > 1) {
+        return undefined;
+    }
+
+    return {
+        accumulatorOperator: Array.from(accumulatorOperators.values())[0] as ts.SyntaxKind.PlusToken | ts.SyntaxKind.AsteriskToken | undefined,
+        tailCalls
+    };
+}
+
+function getAccumulatedCall(expression: ts.Expression | undefined,
+                            declaration: ts.FunctionLikeDeclaration,
+                            symbol: ts.Symbol,
+                            typeChecker: TypeChecker): TailCall | undefined {
+    if (!expression || expression.kind !== ts.SyntaxKind.BinaryExpression) {
+        return undefined;
+    }
+
+    const binaryExpression = expression as ts.BinaryExpression;
+    const operator = binaryExpression.operatorToken.kind;
+
+    if (operator !== ts.SyntaxKind.PlusToken && operator !== ts.SyntaxKind.AsteriskToken) {
+        return undefined;
+    }
+
+    // Only int operations are associative, floating point additions and multiplications are not
+    const types = [binaryExpression, binaryExpression.left, binaryExpression.right].map(node => typeChecker.getTypeAtLocation(node));
+    if (!types.every(type => !!(type.flags & ts.TypeFlags.IntLike))) {
+        return undefined;
+    }
+
+    const left = skipParentheses(binaryExpression.left);
+    const right = skipParentheses(binaryExpression.right);
+
+    // x op f(y), x is evaluated before the call, as in the recursive version
+    if (isSelfCall(right, declaration, symbol, typeChecker)) {
+        return { call: right as ts.CallExpression, accumulated: binaryExpression.left };
+    }
+
+    // f(y) op x, x is evaluated before the call arguments, this is only valid if neither has side effects
+    const call = left as ts.CallExpression;
+    if (isSelfCall(left, declaration, symbol, typeChecker) && isSideEffectFree(right!) && call.arguments.every(isSideEffectFree)) {
+        return { call, accumulated: binaryExpression.right };
+    }
+
+    return undefined;
+}
+
+function isSelfCall(expression: ts.Expression | undefined, declaration: ts.FunctionLikeDeclaration, symbol: ts.Symbol, typeChecker: TypeChecker) {
+    if (!expression || expression.kind !== ts.SyntaxKind.CallExpression) {
+        return false;
+    }
+
+    const callExpression = expression as ts.CallExpression;
+    if (callExpression.arguments.length !== declaration.parameters.length ||
+        callExpression.arguments.some(argument => argument.kind === ts.SyntaxKind.SpreadElement)) {
+        return false;
+    }
+
+    return isReferenceTo(callExpression.expression, symbol, typeChecker);
+}
+
+function isReferenceTo(expression: ts.Expression, symbol: ts.Symbol, typeChecker: TypeChecker) {
+    if (expression.kind !== ts.SyntaxKind.Identifier) {
+        return false;
+    }
+
+    let referenced = typeChecker.getSymbolAtLocation(expression);
+    if (referenced && referenced.flags & ts.SymbolFlags.Alias) {
+        referenced = typeChecker.getAliasedSymbol(referenced);
+    }
+
+    return referenced === symbol;
+}
+
+function isSideEffectFree(node: ts.Node): boolean {
+    switch (node.kind) {
+        case ts.SyntaxKind.CallExpression:
+        case ts.SyntaxKind.NewExpression:
+        case ts.SyntaxKind.PostfixUnaryExpression:
+            return false;
+        case ts.SyntaxKind.PrefixUnaryExpression:
+            const unaryOperator = (node as ts.PrefixUnaryExpression).operator;
+            if (unaryOperator === ts.SyntaxKind.PlusPlusToken || unaryOperator === ts.SyntaxKind.MinusMinusToken) {
+                return false;
+            }
+            break;
+        case ts.SyntaxKind.BinaryExpression:
+            const binaryOperator = (node as ts.BinaryExpression).operatorToken.kind;
+            if (binaryOperator >= ts.SyntaxKind.FirstAssignment && binaryOperator <= ts.SyntaxKind.LastAssignment) {
+                return false;
+            }
+            break;
+    }
+
+    return !ts.forEachChild(node, child => !isSideEffectFree(child) || undefined);
+}
+
+function getReturnStatements(body: ts.Node): ts.ReturnStatement[] {
+    const result: ts.ReturnStatement[] = [];
+
+    function visit(node: ts.Node) {
+        switch (node.kind) {
+            case ts.SyntaxKind.ReturnStatement:
+                result.push(node as ts.ReturnStatement);
+                return;
+            // return statements of nested functions are not part of this function
+            case ts.SyntaxKind.FunctionDeclaration:
+            case ts.SyntaxKind.FunctionExpression:
+            case ts.SyntaxKind.ArrowFunction:
+            case ts.SyntaxKind.ClassDeclaration:
+            case ts.SyntaxKind.ClassExpression:
+                return;
+            default:
+                ts.forEachChild(node, visit);
+        }
+    }
+
+    visit(body);
+    return result;
+}
+
+function skipParentheses(expression: ts.Expression | undefined): ts.Expression | undefined {
+    while (expression && expression.kind === ts.SyntaxKind.ParenthesizedExpression) {
+        expression = (expression as ts.ParenthesizedExpression).expression;
+    }
+
+    return expression;
+}
@@ -1,7 +1,9 @@
 import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
+import {isValueClass} from "../../util/speedyjs-function";
 import {CodeGenerationContext} from "../code-generation-context";
+import {TypePlace} from "./typescript-to-llvm-type-converter";
 
 /**
  * Returns the llvm type for the given typescript type
@@ -51,6 +53,20 @@ export function getCallSignature(type: ts.Type) {
     return type.getCallSignatures()[0];
 }
 
+/**
+ * Tests if the given type is a generic class or interface or an instantiation of it (e.g. Box<T> or Box<int>)
+ * @param type the type to test
+ * @return {boolean} true if the type has type arguments
+ */
+export function isGenericType(type: ts.Type): type is ts.TypeReference {
+    if (type.flags & ts.TypeFlags.Object && (type as ts.ObjectType).objectFlags & ts.ObjectFlags.Reference) {
+        const typeArguments = (type as ts.TypeReference).typeArguments;
+        return !!typeArguments && typeArguments.length > 0;
+    }
+
+    return false;
+}
+
 /**
  * Tests if the given type is a maybe object type (objectType | undefined).
  * @param type the type to test
@@ -68,6 +84,117 @@ export function isMaybeObjectType(type: ts.Type): type is ts.UnionType {
     return false;
 }
 
+/**
+ * Tests if the given type is the int64 (long) type declared in the speedy.js lib file (number & { __int64?: never })
+ * @param type the type to test
+ * @return {boolean} true if the type is int64
+ */
+export function isInt64Type(type: ts.Type): type is ts.IntersectionType {
+    if (type.flags & ts.TypeFlags.Intersection) {
+        return (type as ts.IntersectionType).types.some(t => !!(t.flags & ts.TypeFlags.Object) && !!t.getProperty("__int64"));
+    }
+
+    return false;
+}
+
+/**
+ * Tests if the given type is the uint type declared in the speedy.js lib file (number & { __uint?: never })
+ * @param type the type to test
+ * @return {boolean} true if the type is uint
+ */
+export function isUintType(type: ts.Type): type is ts.IntersectionType {
+    if (type.flags & ts.TypeFlags.Intersection) {
+        return (type as ts.IntersectionType).types.some(t => !!(t.flags & ts.TypeFlags.Object) && !!t.getProperty("__uint"));
+    }
+
+    return false;
+}
+
+/**
+ * A SIMD vector type declared in the speedy.js lib file, e.g. float64x2
+ */
+export interface SIMDVectorKind {
+    /**
+     * The name of the vector type, e.g. float64x2
+     */
+    name: string;
+
+    /**
+     * The name of the built in object that provides the operations of the vector type, e.g. Float64x2
+     */
+    operationsName: string;
+
+    /**
+     * The number of lanes
+     */
+    lanes: number;
+
+    /**
+     * Indicator if the lanes are numbers (float64) or ints (int32)
+     */
+    floatingPoint: boolean;
+}
+
+export const SIMD_VECTOR_KINDS: SIMDVectorKind[] = [
+    { name: "float64x2", operationsName: "Float64x2", lanes: 2, floatingPoint: true },
+    { name: "int32x4", operationsName: "Int32x4", lanes: 4, floatingPoint: false }
+];
+
+/**
+ * Returns the kind of the SIMD vector type declared in the speedy.js lib file (an interface with a __float64x2 or __int32x4 member)
+ * @param type the type
+ * @return the kind of the vector or undefined if the type is not a SIMD vector type
+ */
+export function getSIMDVectorKind(type: ts.Type): SIMDVectorKind | undefined {
+    if (!(type.flags & ts.TypeFlags.Object)) {
+        return undefined;
+    }
+
+    return SIMD_VECTOR_KINDS.find(kind => !!type.getProperty(`__${kind.name}`));
+}
+
+/**
+ * Tests if the given type is a SIMD vector type (float64x2 or int32x4)
+ * @param type the type to test
+ * @return {boolean} true if the type is a SIMD vector type
+ */
+export function isSIMDVectorType(type: ts.Type): type is ts.ObjectType {
+    return !!getSIMDVectorKind(type);
+}
+
+/**
+ * Tests if the given type is an instance of a value class (a class with the "use value" directive in its constructor)
+ * @param type the type to test
+ * @return {boolean} true if the instances of the type are values
+ */
+export function isValueClassType(type: ts.Type): type is ts.ObjectType {
+    if (!(type.flags & ts.TypeFlags.Object) || !((type as ts.ObjectType).objectFlags & (ts.ObjectFlags.Class | ts.ObjectFlags.Reference))) {
+        return false;
+    }
+
+    const symbol = type.getSymbol();
+    const declaration = symbol ? symbol.valueDeclaration : undefined;
+    return !!declaration && declaration.kind === ts.SyntaxKind.ClassDeclaration && isValueClass(declaration as ts.ClassDeclaration);
+}
+
+/**
+ * Returns the struct of a value object to store it inline or to pass it by value.
+ * Inside of a function, value objects are referenced by the address of their storage that is loaded by this function.
+ * Other values are returned unchanged.
+ * @param value the address of the value object or the llvm value
+ * @param type the type of the value
+ * @param context the context
+ * @return the struct of the value object or the passed value
+ */
+export function toValueObjectStruct(value: llvm.Value, type: ts.Type, context: CodeGenerationContext): llvm.Value {
+    if (!isValueClassType(type) || !value.type.isPointerTy()) {
+        return value;
+    }
+
+    const structType = context.toLLVMType(type, TypePlace.FIELD);
+    return context.builder.createAlignedLoad(value, context.module.dataLayout.getPrefTypeAlignment(structType), "value");
+}
+
 export function getArrayElementType(arrayType: ts.Type): ts.Type {
     const genericType = arrayType as ts.GenericType;
     assert(genericType.typeArguments.length === 1, "An array type needs to have one type argument, the type of the array elements");
@@ -4,10 +4,12 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CompilationContext} from "../../compilation-context";
 import {CodeGenerationContext} from "../code-generation-context";
+import {getFunctionClosure} from "../util/closures";
 import {invoke} from "../util/functions";
 import {llvmArrayValue} from "../util/llvm-array-helpers";
-import {getArrayElementType, getCallSignature, isFunctionType} from "../util/types";
+import {getArrayElementType, getCallSignature, isFunctionType, isSIMDVectorType, isValueClassType, toValueObjectStruct} from "../util/types";
 import {TypePlace} from "../util/typescript-to-llvm-type-converter";
+import {ArrayReference, CArray} from "./array-reference";
 import {FunctionPointer, FunctionReference} from "./function-reference";
 import {ObjectReference} from "./object-reference";
 import {createResolvedFunctionFromSignature, ResolvedFunction, ResolvedFunctionParameter} from "./resolved-function";
@@ -45,7 +47,20 @@ export abstract class AbstractFunctionReference implements FunctionReference {
         const resolvedSignature = callerContext.typeChecker.getResolvedSignature(callExpression);
         const resolvedFunction = this.getResolvedFunctionFromSignature(resolvedSignature, callerContext.compilationContext);
 
-        const passedArguments = toLlvmArgumentValues(callExpression.arguments || [] as ts.Expression[], resolvedFunction, callerContext);
+        const args = callExpression.arguments || [] as ts.Expression[];
+        const arraySymbol = callerContext.compilationContext.builtIns.get("Array");
+        // Array methods may modify the array while reading the passed elements, e.g. array.push(...array)
+        const isArrayMethod = !!this.classType && this.classType.getSymbol() === arraySymbol;
+        const spreadExpression = isArrayMethod ? undefined : getSpreadVariadicArgument(args, resolvedFunction, callerContext);
+
+        if (spreadExpression) {
+            // JS evaluates the arguments from left to right, the arguments in front of the spread array come first
+            const passedArguments = toLlvmArgumentValues(args.slice(0, args.length - 1), resolvedFunction, callerContext);
+            const spreadArgument = (callerContext.generateValue(spreadExpression).dereference(callerContext) as ArrayReference).toCArray(callerContext);
+            return this.invokeResolvedFunction(resolvedFunction, passedArguments, callerContext, spreadArgument);
+        }
+
+        const passedArguments = toLlvmArgumentValues(args, resolvedFunction, callerContext);
         return this.invokeResolvedFunction(resolvedFunction, passedArguments, callerContext);
     }
 
@@ -57,11 +72,14 @@ export abstract class AbstractFunctionReference implements FunctionReference {
         return createResolvedFunctionFromSignature(signature, compilationContext, this.classType);
     }
 
-    private invokeResolvedFunction(resolvedFunction: ResolvedFunction, args: llvm.Value[], callerContext: CodeGenerationContext) {
+    protected invokeResolvedFunction(resolvedFunction: ResolvedFunction,
+                                     args: llvm.Value[],
+                                     callerContext: CodeGenerationContext,
+                                     spreadArgument?: CArray): Value {
         const llvmFunction = this.getLLVMFunction(resolvedFunction, callerContext, args);
         assert(llvmFunction.type.isPointerTy() && (llvmFunction.type as llvm.PointerType).elementType.isFunctionTy(), "Expected pointer to a function type");
 
-        const callArguments = this.getCallArguments(resolvedFunction, args, callerContext);
+        const callArguments = this.getCallArguments(resolvedFunction, args, callerContext, spreadArgument);
         let name: string | undefined;
 
         if (!(resolvedFunction.returnType.flags & ts.TypeFlags.Void)) {
@@ -71,7 +89,11 @@ export abstract class AbstractFunctionReference implements FunctionReference {
         const returnType = callerContext.toLLVMType(resolvedFunction.returnType, TypePlace.RETURN_VALUE);
         let dereferenceableSize: number | undefined;
 
-        if (resolvedFunction.returnType.flags & ts.TypeFlags.Object) {
+        // Value objects and SIMD vectors are returned by value and not by a dereferenceable pointer
+        if (resolvedFunction.returnType.flags & ts.TypeFlags.Object &&
+            !isFunctionType(resolvedFunction.returnType) &&
+            !isValueClassType(resolvedFunction.returnType) &&
+            !isSIMDVectorType(resolvedFunction.returnType)) {
             const classReference = callerContext.resolveClass(resolvedFunction.returnType)!;
             dereferenceableSize = classReference.getTypeStoreSize(resolvedFunction.returnType as ts.ObjectType, callerContext);
         }
@@ -90,9 +112,13 @@ export abstract class AbstractFunctionReference implements FunctionReference {
      * @param resolvedFunction the specific signature of the function to call
      * @param passedArguments the parameters passed in the invoke statement
      * @param callerContext the callers code generation context
+     * @param spreadArgument the elements of the array spread into the variadic parameter, if any
      * @return the values that are to be passed to the llvm function
      */
-    protected getCallArguments(resolvedFunction: ResolvedFunction, passedArguments: llvm.Value[], callerContext: CodeGenerationContext): llvm.Value[] {
+    protected getCallArguments(resolvedFunction: ResolvedFunction,
+                               passedArguments: llvm.Value[],
+                               callerContext: CodeGenerationContext,
+                               spreadArgument?: CArray): llvm.Value[] {
         const result: llvm.Value[] = [];
 
         for (let i = 0; i < resolvedFunction.parameters.length; ++i) {
@@ -111,7 +137,10 @@ export abstract class AbstractFunctionReference implements FunctionReference {
                 break;
             }
 
-            if (parameter.variadic) {
+            if (parameter.variadic && spreadArgument) {
+                result.push(spreadArgument.elements, spreadArgument.length);
+                break;
+            } else if (parameter.variadic) {
                 const arrayType = (parameter.type as ts.GenericType);
                 const elementType = getArrayElementType(arrayType);
                 const elementLLVMType = callerContext.toLLVMType(elementType, TypePlace.PARAMETER);
@@ -124,7 +153,7 @@ export abstract class AbstractFunctionReference implements FunctionReference {
 
                 break;
             } else {
-                result.push(arg!);
+                result.push(toValueObjectStruct(arg!, parameter.type, callerContext));
             }
         }
 
@@ -143,8 +172,11 @@ export abstract class AbstractFunctionReference implements FunctionReference {
         return this;
     }
 
+    /**
+     * Returns the function as function value, the closure record of the function that has no captured variables
+     */
     generateIR(context: CodeGenerationContext): llvm.Value {
-        return this.getLLVMFunction(this.getResolvedFunction(context), context);
+        return getFunctionClosure(this.getLLVMFunction(this.getResolvedFunction(context), context), context);
     }
 
     castImplicit(type: ts.Type, context: CodeGenerationContext): Value | undefined {
@@ -188,6 +220,30 @@ function toLlvmArgumentValues(args: ts.Expression[], resolvedFunction: ResolvedF
     return values;
 }
 
+/**
+ * Tests if the array passed to the variadic parameter is spread (e.g. Math.max(...array)). In this case, the elements
+ * of the array are passed directly to the function instead of being copied into a new varargs array.
+ * @return the expression of the spread array or undefined if the last argument is not an array spread into the variadic parameter
+ */
+function getSpreadVariadicArgument(args: ts.Expression[], resolvedFunction: ResolvedFunction, callerContext: CodeGenerationContext): ts.Expression | undefined {
+    const variadicParameter = resolvedFunction.parameters[args.length - 1];
+    const lastArgument = args[args.length - 1];
+
+    if (!variadicParameter || !variadicParameter.variadic || !lastArgument || lastArgument.kind !== ts.SyntaxKind.SpreadElement) {
+        return undefined;
+    }
+
+    const spreadExpression = (lastArgument as ts.SpreadElement).expression;
+    const spreadType = callerContext.typeChecker.getTypeAtLocation(spreadExpression);
+
+    if (spreadType.getSymbol() !== callerContext.compilationContext.builtIns.get("Array") ||
+        getArrayElementType(spreadType) !== getArrayElementType(variadicParameter.type)) {
+        return undefined;
+    }
+
+    return spreadExpression;
+}
+
 function toLlvmVariadicArgument(varArgs: ts.Expression[], parameter: ResolvedFunctionParameter, callerContext: CodeGenerationContext) {
     const elementType = getArrayElementType(parameter.type);
     const llvmVarArgs = new Array<llvm.Value>(varArgs.length);
@@ -2,6 +2,9 @@ import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
+import {isValueClassType, toValueObjectStruct} from "../util/types";
+import {TypePlace} from "../util/typescript-to-llvm-type-converter";
+import {AddressLValue} from "./address-lvalue";
 import {ObjectReference} from "./object-reference";
 import {Pointer} from "./pointer";
 
@@ -10,12 +13,13 @@ import {AssignableValue, Value} from "./value";
 /**
  * Wrapper for an allocation with an alignment.
  *
- * Is capable to work with Values and ensures correct alignment
+ * Is capable to work with Values and ensures correct alignment. Value objects are stored inline in the allocation,
+ * like in a field, and are copied when assigned.
  */
 export class Allocation implements AssignableValue {
     static create(type: ts.Type, context: CodeGenerationContext, name?: string): Allocation {
-        const allocaInst = Allocation.createAllocaInstInEntryBlock(context.toLLVMType(type), context, name);
-        const alignment = Allocation.getPreferredValueAlignment(type, context);
+        const allocaInst = Allocation.createAllocaInstInEntryBlock(context.toLLVMType(type, TypePlace.FIELD), context, name);
+        const alignment = Allocation.getStorageAlignment(type, context);
         return new Allocation(allocaInst, type, alignment, name);
     }
 
@@ -32,15 +36,32 @@ export class Allocation implements AssignableValue {
 
     static createGlobal(pointer: llvm.GlobalVariable, type: ts.Type, context: CodeGenerationContext, name?: string) {
         assert(pointer.type.isPointerTy(), "Address needs to be a pointer");
-        const alignment = Allocation.getPreferredValueAlignment(type, context);
+        const alignment = Allocation.getStorageAlignment(type, context);
         return new Allocation(pointer, type, alignment, name);
     }
 
+    /**
+     * Creates an allocation for a variable stored at the given address, e.g. a variable captured by a closure
+     * @param address the address of the variable
+     * @param type the type of the variable
+     * @param context the context
+     * @param name the name of the variable
+     */
+    static fromAddress(address: llvm.Value, type: ts.Type, context: CodeGenerationContext, name?: string) {
+        assert(address.type.isPointerTy(), "Address needs to be a pointer");
+        const alignment = Allocation.getStorageAlignment(type, context);
+        return new Allocation(address, type, alignment, name);
+    }
+
     static getPreferredValueAlignment(type: llvm.Type | ts.Type, context: CodeGenerationContext) {
         type = type instanceof llvm.Type ? type : context.toLLVMType(type);
         return context.module.dataLayout.getPrefTypeAlignment(type);
     }
 
+    private static getStorageAlignment(type: ts.Type, context: CodeGenerationContext) {
+        return Allocation.getPreferredValueAlignment(context.toLLVMType(type, TypePlace.FIELD), context);
+    }
+
     private constructor(public store: llvm.Value, public type: ts.Type, public alignment: number, public name?: string) {
     }
 
@@ -55,6 +76,10 @@ export class Allocation implements AssignableValue {
     dereference(context: CodeGenerationContext): Value {
         if (this.type.flags & ts.TypeFlags.Object) {
             const classReference = context.resolveClass(this.type);
+            if (classReference && isValueClassType(this.type)) {
+                return classReference.objectFor(new AddressLValue(this.store, this.type), this.type, context);
+            }
+
             if (classReference) {
                 return classReference.objectFor(new AllocationPointerWrapper(this), this.type as ts.ObjectType, context);
             }
@@ -71,7 +96,7 @@ export class Allocation implements AssignableValue {
         assert(this.isAssignable, "Cannot assign to constant global variable");
 
         const llvmValue = value instanceof llvm.Value ? value : value.generateIR(context);
-        context.builder.createAlignedStore(llvmValue, this.store, this.alignment, false);
+        context.builder.createAlignedStore(toValueObjectStruct(llvmValue, this.type, context), this.store, this.alignment, false);
     }
 
     castImplicit(type: ts.Type, context: CodeGenerationContext) {
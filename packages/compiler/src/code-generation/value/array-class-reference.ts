@@ -1,9 +1,10 @@
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CompilationContext} from "../../compilation-context";
 import {CodeGenerationContext} from "../code-generation-context";
 import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
-import {getArrayElementType, isMaybeObjectType} from "../util/types";
+import {getArrayElementType, isMaybeObjectType, isValueClassType} from "../util/types";
 import {TypePlace} from "../util/typescript-to-llvm-type-converter";
 import {Address} from "./address";
 
@@ -39,7 +40,8 @@ export class ArrayClassReference extends ClassReference {
      */
     static fromLiteral(type: ts.ObjectType, elements: llvm.Value[], context: CodeGenerationContext): ArrayReference {
         const parameters = [ createResolvedParameter("items", type, false, undefined, true) ];
-        const resolvedConstructor = createResolvedFunction("constructor", [], parameters, type, type.getSymbol().getDeclarations()[0].getSourceFile(), type);
+        const sourceFile = type.getSymbol().getDeclarations()[0].getSourceFile();
+        const resolvedConstructor = createResolvedFunction("constructor", new Map(), parameters, type, sourceFile, type);
         const constructorFunction = ResolvedFunctionReference.createRuntimeFunction(resolvedConstructor, context);
         context.requiresGc = true;
 
@@ -90,6 +92,11 @@ export class ArrayClassReference extends ClassReference {
             elementType = elementType.getNonNullableType();
         }
 
+        // The runtime stores the elements of object arrays as pointers but value objects have no heap address
+        if (isValueClassType(elementType)) {
+            throw CodeGenerationDiagnostics.unsupportedValueObjectArray(elementType.getSymbol().valueDeclaration as ts.ClassDeclaration);
+        }
+
         const elementsPtr = context.toRuntimeLLVMType(elementType, TypePlace.FIELD).getPointerTo();
 
         const existing = this.llvmTypes.get(elementsPtr.toString());
@@ -1,17 +1,27 @@
+import * as llvm from "llvm-node";
 import * as ts from "typescript";
 
 import {CodeGenerationContext} from "../code-generation-context";
 import {ComputedObjectPropertyReferenceBuilder} from "../util/computed-object-property-reference-builder";
 import {ObjectIndexReferenceBuilder} from "../util/object-index-reference-builder";
-import {getArrayElementType} from "../util/types";
+import {getArrayElementType, isUintType, sizeof} from "../util/types";
 import {Address} from "./address";
 import {ArrayClassReference} from "./array-class-reference";
 import {BuiltInObjectReference} from "./built-in-object-reference";
 import {FunctionReference} from "./function-reference";
 import {ObjectIndexReference} from "./object-index-reference";
 import {ObjectPropertyReference} from "./object-property-reference";
+import {UncheckedArrayElementReference} from "./unchecked-array-element-reference";
 import {UnresolvedMethodReference} from "./unresolved-method-reference";
 
+/**
+ * Pointer to the elements of an array and the number of elements, the representation used by the runtime for varargs
+ */
+export interface CArray {
+    elements: llvm.Value;
+    length: llvm.Value;
+}
+
 /**
  * Reference to an Array<T> Object
  */
@@ -67,7 +77,68 @@ export class ArrayReference extends BuiltInObjectReference {
         }
     }
 
+    /**
+     * Returns the pointer to the elements and the length of this array without copying the elements. The returned
+     * pointer is only valid as long as the array is not modified.
+     * @param context the code generation context
+     * @return the pointer to the first element and the number of elements (int)
+     */
+    toCArray(context: CodeGenerationContext): CArray {
+        const { elements, back } = this.getElementRange(context);
+
+        const int32Type = llvm.Type.getInt32Ty(context.llvmContext);
+        const byteLength = context.builder.createSub(
+            context.builder.createPtrToInt(back, int32Type, "backAddress"),
+            context.builder.createPtrToInt(elements, int32Type, "elementsAddress"),
+            "byteLength"
+        );
+        const length = context.builder.createSDiv(byteLength, sizeof((elements.type as llvm.PointerType).elementType, context), "length");
+
+        return { elements, length };
+    }
+
+    /**
+     * Returns the pointer to the first element and the pointer behind the last element of this array.
+     * The pointers are only valid as long as the array is not resized.
+     * @param context the code generation context
+     * @return the pointer to the first element (elements) and the pointer past the last element (back)
+     */
+    getElementRange(context: CodeGenerationContext): { elements: llvm.Value, back: llvm.Value } {
+        const ZERO = llvm.ConstantInt.get(context.llvmContext, 0);
+        const arrayPtr = this.generateIR(context);
+
+        const beginPtr = context.builder.createInBoundsGEP(arrayPtr, [ZERO, ZERO], "beginPtr");
+        const backPtr = context.builder.createInBoundsGEP(arrayPtr, [ZERO, llvm.ConstantInt.get(context.llvmContext, 1)], "backPtr");
+        const pointerAlignment = context.module.dataLayout.getPrefTypeAlignment((beginPtr.type as llvm.PointerType).elementType);
+        const elements = context.builder.createAlignedLoad(beginPtr, pointerAlignment, "elements");
+        const back = context.builder.createAlignedLoad(backPtr, pointerAlignment, "back");
+
+        return { elements, back };
+    }
+
+    /**
+     * Returns the pointer to the first element of this array. The pointer is only valid as long as the array is not resized.
+     * @param context the code generation context
+     * @return the pointer to the first element
+     */
+    getElements(context: CodeGenerationContext): llvm.Value {
+        const ZERO = llvm.ConstantInt.get(context.llvmContext, 0);
+        const beginPtr = context.builder.createInBoundsGEP(this.generateIR(context), [ZERO, ZERO], "beginPtr");
+        const pointerAlignment = context.module.dataLayout.getPrefTypeAlignment((beginPtr.type as llvm.PointerType).elementType);
+
+        return context.builder.createAlignedLoad(beginPtr, pointerAlignment, "elements");
+    }
+
     getIndexer(elementAccessExpression: ts.ElementAccessExpression, context: CodeGenerationContext): ObjectIndexReference {
+        // The accessors of the unsafe runtime are unchecked already, an unsafe function in a safe module accesses the elements directly
+        const indexType = context.typeChecker.getTypeAtLocation(elementAccessExpression.argumentExpression!);
+        const intIndex = !!(indexType.flags & ts.TypeFlags.IntLike) || isUintType(indexType);
+        if (context.scope.unsafe && !context.compilationContext.compilerOptions.unsafe && intIndex) {
+            const elementType = context.typeChecker.getTypeAtLocation(elementAccessExpression);
+            const index = context.generateValue(elementAccessExpression.argumentExpression!);
+            return new UncheckedArrayElementReference(elementType, this, index);
+        }
+
         return ObjectIndexReferenceBuilder
             .forElement(elementAccessExpression, context)
             .fromRuntime()
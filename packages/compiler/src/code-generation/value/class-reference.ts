@@ -15,6 +15,16 @@ export interface Field {
     type: ts.Type;
 }
 
+/**
+ * A field together with its position in the memory of an object
+ */
+export interface FieldLayout extends Field {
+    /**
+     * The offset of the field in bytes from the start of the object
+     */
+    offset: number;
+}
+
 /**
  * Reference to a class (or in JS, to the constructor function)
  */
@@ -100,7 +110,7 @@ export abstract class ClassReference implements Value {
         return this.getObjectType(type, context);
     }
 
-    getFieldOffset(property: ts.Symbol) {
+    getFieldOffset(property: ts.Symbol, context: CodeGenerationContext) {
         const field = this.type.getProperty(property.getName()); // in case the passed in property is transient or this class type is transient
         assert(field.flags & ts.SymbolFlags.Property, `The property ${property.name} is not a property (e.g. a method instead)`);
 
@@ -118,6 +128,27 @@ export abstract class ClassReference implements Value {
      */
     abstract getFields(type: ts.ObjectType, context: CodeGenerationContext): Field[];
 
+    /**
+     * Returns the fields of the class instances together with their byte offsets as laid out by {@link getLLVMType}.
+     * The offsets follow the alignment rules of the data layout of the module.
+     * @param type the specific instantiated type of the class
+     * @param context the code generation context
+     */
+    getFieldLayout(type: ts.ObjectType, context: CodeGenerationContext): FieldLayout[] {
+        const dataLayout = context.module.dataLayout;
+        let offset = this.getHeaderTypes(context).reduce((memo, headerType) => {
+            return alignOffset(memo, dataLayout.getPrefTypeAlignment(headerType)) + dataLayout.getTypeStoreSize(headerType);
+        }, 0);
+
+        return this.getFields(type, context).map(field => {
+            const llvmType = context.toLLVMType(field.type, TypePlace.FIELD);
+            const fieldOffset = alignOffset(offset, dataLayout.getPrefTypeAlignment(llvmType));
+            offset = fieldOffset + dataLayout.getTypeStoreSize(llvmType);
+
+            return { name: field.name, type: field.type, offset: fieldOffset };
+        });
+    }
+
     /**
      * Returns the reference to the constructor function
      * @param newExpression the call to the constructor
@@ -133,6 +164,14 @@ export abstract class ClassReference implements Value {
      */
     abstract objectFor(address: Address, type: ts.ObjectType, context: CodeGenerationContext): ObjectReference;
 
+    /**
+     * Returns the types of the values stored in front of the fields of an object
+     * @param context the code generation context
+     */
+    protected getHeaderTypes(context: CodeGenerationContext): llvm.Type[] {
+        return [];
+    }
+
     /**
      * Creates the type of the object
      * @param type the type
@@ -144,7 +183,10 @@ export abstract class ClassReference implements Value {
             const forwardDeclaration = llvm.StructType.create(this.compilationContext.llvmContext, `class.${this.symbol.name}`);
             this.llvmType = forwardDeclaration;
 
-            const fieldTypes = this.getFields(type, context).map(field => context.toLLVMType(field.type, TypePlace.FIELD));
+            const fieldTypes = [
+                ...this.getHeaderTypes(context),
+                ...this.getFields(type, context).map(field => context.toLLVMType(field.type, TypePlace.FIELD))
+            ];
 
             if (fieldTypes.length === 0) {
                 // LLVM doesn't seem to like empty structs, at least when marked as dereferencaeble (throws value out of range as size is 0).
@@ -158,3 +200,7 @@ export abstract class ClassReference implements Value {
         return this.llvmType;
     }
 }
+
+function alignOffset(offset: number, alignment: number) {
+    return Math.ceil(offset / alignment) * alignment;
+}
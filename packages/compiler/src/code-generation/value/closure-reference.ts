@@ -0,0 +1,159 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {
+    CapturedVariable,
+    ClosureDeclaration,
+    findReassignment,
+    getCapturedVariables,
+    getClosureSymbol,
+    isEscapingClosure,
+    isRecursiveClosure
+} from "../util/closures";
+import {FunctionDefinitionBuilder} from "../util/function-definition-builder";
+import {sizeof} from "../util/types";
+import {TypePlace} from "../util/typescript-to-llvm-type-converter";
+import {AbstractFunctionReference} from "./abstract-function-reference";
+import {Allocation} from "./allocation";
+import {CArray} from "./array-reference";
+import {FunctionPointer} from "./function-reference";
+import {createResolvedFunctionFromSignature, ResolvedFunction} from "./resolved-function";
+
+/**
+ * Reference to a function value. A function value is a pointer to a closure record that stores the pointer to the function
+ * followed by the variables captured by the function. The function is called with the record as additional first argument.
+ */
+export class ClosureReference extends AbstractFunctionReference {
+
+    /**
+     * Creates the closure for a function expression, arrow function or function declaration nested inside of another function.
+     *
+     * A closure that does not escape the enclosing function stores its record on the stack and captures the variables by reference.
+     * The record of an escaping closure is allocated on the heap and stores copies of the captured variables that,
+     * therefore, cannot be reassigned.
+     * @param declaration the declaration of the closure
+     * @param context the context of the enclosing function
+     * @return the reference to the created closure
+     */
+    static create(declaration: ClosureDeclaration, context: CodeGenerationContext) {
+        const typeChecker = context.typeChecker;
+        const signature = typeChecker.getSignatureFromDeclaration(declaration);
+        const resolvedFunction = createResolvedFunctionFromSignature(signature, context.compilationContext);
+        const closureType = typeChecker.getTypeAtLocation(declaration);
+        const escaping = isEscapingClosure(declaration, typeChecker);
+
+        const captures = getCapturedVariables(declaration, typeChecker)
+            .filter(symbol => context.scope.hasVariable(symbol))
+            .map(symbol => ClosureReference.capture(symbol, escaping, context));
+
+        const fieldTypes = captures.map(capture => {
+            const variable = context.scope.getVariable(capture.symbol);
+            return capture.byReference ? (variable as Allocation).store.type : context.toLLVMType(capture.type, TypePlace.FIELD);
+        });
+
+        const closureSymbol = getClosureSymbol(declaration, typeChecker);
+        const name = closureSymbol ? closureSymbol.name : "lambda";
+        const fn = ClosureReference.declareFunction(resolvedFunction, name, context);
+        const recordType = llvm.StructType.get(context.llvmContext, [fn.type, ...fieldTypes], false);
+        const self = closureSymbol && isRecursiveClosure(declaration, typeChecker) ? { symbol: closureSymbol, type: closureType } : undefined;
+
+        FunctionDefinitionBuilder.create(fn, resolvedFunction, context.createChildContext())
+            .environment({ recordType, captures, self })
+            .unsafe(context.scope.unsafe)
+            .define();
+
+        const record = escaping ?
+            ClosureReference.allocateRecordOnHeap(recordType, context) :
+            Allocation.createAllocaInstInEntryBlock(recordType, context, "closure");
+
+        const fnAddress = context.builder.createInBoundsGEP(record, getFieldIndex(0, context), "&fn");
+        context.builder.createAlignedStore(fn, fnAddress, Allocation.getPreferredValueAlignment(fn.type, context));
+
+        captures.forEach((capture, i) => {
+            const variable = context.scope.getVariable(capture.symbol);
+            const value = capture.byReference ? (variable as Allocation).store : variable.generateIR(context);
+            const address = context.builder.createInBoundsGEP(record, getFieldIndex(i + 1, context), `&${capture.name}`);
+            context.builder.createAlignedStore(value, address, Allocation.getPreferredValueAlignment(value.type, context));
+        });
+
+        const closure = context.builder.createBitCast(record, context.toLLVMType(closureType), name);
+        return new ClosureReference(closure, resolvedFunction);
+    }
+
+    /**
+     * Creates a reference to the function value of the given signature
+     * @param closure the pointer to the closure record
+     * @param signature the signature of the function
+     * @param context the context
+     */
+    static createForSignature(closure: llvm.Value, signature: ts.Signature, context: CodeGenerationContext) {
+        const resolvedFunction = createResolvedFunctionFromSignature(signature, context.compilationContext);
+        return new ClosureReference(closure, resolvedFunction);
+    }
+
+    private static capture(symbol: ts.Symbol, escaping: boolean, context: CodeGenerationContext): CapturedVariable {
+        const variable = context.scope.getVariable(symbol);
+        const type = variable instanceof Allocation ? variable.type : context.typeChecker.getTypeOfSymbolAtLocation(symbol, symbol.valueDeclaration!);
+        const name = symbol.flags & ts.SymbolFlags.Class ? "this" : symbol.name;
+
+        if (escaping) {
+            const reassignment = findReassignment(symbol, context.typeChecker);
+            if (reassignment) {
+                throw CodeGenerationDiagnostics.unsupportedReassignmentOfCapturedVariable(reassignment, symbol.name);
+            }
+        }
+
+        return { symbol, name, type, byReference: !escaping && variable instanceof Allocation };
+    }
+
+    private static declareFunction(resolvedFunction: ResolvedFunction, name: string, context: CodeGenerationContext) {
+        const parameterTypes = resolvedFunction.parameters.map(parameter => context.toLLVMType(parameter.type, TypePlace.PARAMETER));
+        const returnType = context.toLLVMType(resolvedFunction.returnType, TypePlace.RETURN_VALUE);
+        const functionType = llvm.FunctionType.get(returnType, [llvm.Type.getInt8PtrTy(context.llvmContext), ...parameterTypes], false);
+        const qualifiedName = `${context.scope.enclosingFunction.name}.${name}`;
+
+        return llvm.Function.create(functionType, llvm.LinkageTypes.InternalLinkage, qualifiedName, context.module);
+    }
+
+    private static allocateRecordOnHeap(recordType: llvm.StructType, context: CodeGenerationContext) {
+        const pointerType = llvm.Type.getInt8PtrTy(context.llvmContext);
+        const mallocFunctionType = llvm.FunctionType.get(pointerType, [llvm.Type.getInt32Ty(context.llvmContext)], false);
+        const allocatorName = context.compilationContext.compilerOptions.warmHeap ? "speedyJsScratchAlloc" : "malloc";
+        const malloc = context.module.getOrInsertFunction(allocatorName, mallocFunctionType);
+        context.requiresGc = true;
+
+        const result = context.builder.createCall(malloc, [sizeof(recordType, context)], "closureVoid*");
+        return context.builder.createBitCast(result, recordType.getPointerTo(), "closure");
+    }
+
+    private constructor(private closure: llvm.Value, private resolvedFunction: ResolvedFunction) {
+        super();
+    }
+
+    protected getResolvedFunction(): ResolvedFunction {
+        return this.resolvedFunction;
+    }
+
+    protected getLLVMFunction(resolvedFunction: ResolvedFunction, context: CodeGenerationContext): FunctionPointer {
+        const address = context.builder.createInBoundsGEP(this.closure, getFieldIndex(0, context), "&fn");
+        const fnType = (address.type as llvm.PointerType).elementType;
+        return context.builder.createAlignedLoad(address, Allocation.getPreferredValueAlignment(fnType, context), "fn") as FunctionPointer;
+    }
+
+    protected getCallArguments(resolvedFunction: ResolvedFunction,
+                               passedArguments: llvm.Value[],
+                               callerContext: CodeGenerationContext,
+                               spreadArgument?: CArray): llvm.Value[] {
+        const environment = callerContext.builder.createBitCast(this.closure, llvm.Type.getInt8PtrTy(callerContext.llvmContext), "environment");
+        return [environment, ...super.getCallArguments(resolvedFunction, passedArguments, callerContext, spreadArgument)];
+    }
+
+    generateIR(): llvm.Value {
+        return this.closure;
+    }
+}
+
+function getFieldIndex(field: number, context: CodeGenerationContext) {
+    return [ llvm.ConstantInt.get(context.llvmContext, 0), llvm.ConstantInt.get(context.llvmContext, field) ];
+}
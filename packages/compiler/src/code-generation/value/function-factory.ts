@@ -1,8 +1,10 @@
 import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
+import {OptimizationLevel} from "../../speedyjs-compiler-options";
 import {CodeGenerationContext} from "../code-generation-context";
 import {NameMangler, Parameter} from "../name-mangler";
+import {isFunctionType, isSIMDVectorType, isValueClassType} from "../util/types";
 import {TypePlace, TypeScriptToLLVMTypeConverter} from "../util/typescript-to-llvm-type-converter";
 import {ObjectReference} from "./object-reference";
 import {ResolvedFunction} from "./resolved-function";
@@ -15,6 +17,11 @@ export interface FunctionProperties {
     noInline: boolean;
     noUnwind: boolean;
     visibility: llvm.VisibilityTypes;
+
+    /**
+     * The optimization level for the function or undefined if the optimization level of the module applies
+     */
+    optimizationLevel?: OptimizationLevel;
 }
 
 /**
@@ -119,7 +126,11 @@ export class FunctionFactory {
 
         this.attributeParameters(fn, resolvedFunction, context, objectReference);
 
-        if (resolvedFunction.returnType.flags & ts.TypeFlags.Object) {
+        // value objects and SIMD vectors are returned by value
+        if (resolvedFunction.returnType.flags & ts.TypeFlags.Object &&
+            !isFunctionType(resolvedFunction.returnType) &&
+            !isValueClassType(resolvedFunction.returnType) &&
+            !isSIMDVectorType(resolvedFunction.returnType)) {
             const classReference = context.resolveClass(resolvedFunction.returnType)!;
             // If object can be undefined, or null
             fn.addDereferenceableAttr(0, classReference.getTypeStoreSize(resolvedFunction.returnType as ts.ObjectType, context));
@@ -155,6 +166,26 @@ export class FunctionFactory {
             attributes.push(llvm.Attribute.AttrKind.ReadNone);
         }
 
+        // The optimization pipeline is the same for all functions of a module, only the size and no optimization levels
+        // can be requested per function. O3 hints the inliner to inline the function.
+        switch (properties.optimizationLevel) {
+            case "0":
+                attributes.push(llvm.Attribute.AttrKind.OptimizeNone);
+                if (!properties.noInline) {
+                    attributes.push(llvm.Attribute.AttrKind.NoInline); // required by optnone
+                }
+                break;
+            case "s":
+                attributes.push(llvm.Attribute.AttrKind.OptimizeForSize);
+                break;
+            case "z":
+                attributes.push(llvm.Attribute.AttrKind.OptimizeForSize, llvm.Attribute.AttrKind.MinSize);
+                break;
+            case "3":
+                attributes.push(llvm.Attribute.AttrKind.InlineHint);
+                break;
+        }
+
         return attributes;
     }
 
@@ -181,7 +212,8 @@ export class FunctionFactory {
                 parameter.addAttr(llvm.Attribute.AttrKind.ZExt);
             }
 
-            if (parameterDefinition.type.flags & ts.TypeFlags.Object) {
+            // value objects are passed by value
+            if (parameterDefinition.type.flags & ts.TypeFlags.Object && !isValueClassType(parameterDefinition.type)) {
                 const classReference = context.resolveClass(parameterDefinition.type as ts.ObjectType);
 
                 if (classReference) {
@@ -212,11 +244,13 @@ export class FunctionFactory {
                 resolvedFunction.classType,
                 resolvedFunction.functionName!,
                 usedParameters,
-                resolvedFunction.sourceFile
+                resolvedFunction.sourceFile,
+                Array.from(resolvedFunction.typeArguments.values())
             );
         }
 
-        return this.nameMangler.mangleFunctionName(resolvedFunction.functionName, usedParameters, resolvedFunction.sourceFile);
+        const typeArguments = Array.from(resolvedFunction.typeArguments.values());
+        return this.nameMangler.mangleFunctionName(resolvedFunction.functionName, usedParameters, resolvedFunction.sourceFile, typeArguments);
     }
 
     private toLlvmArgumentTypes(resolvedFunction: ResolvedFunction,
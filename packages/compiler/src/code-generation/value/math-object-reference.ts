@@ -27,16 +27,46 @@ export class MathObjectReference extends BuiltInObjectReference {
                                 context: CodeGenerationContext) {
         switch (symbol.name) {
             // use the llvm intrinsic whenever a web assembly instruction exists
-            case "pow":
-            case "sqrt":
+            case "abs":
+            case "acos":
+            case "acosh":
+            case "asin":
+            case "asinh":
+            case "atan":
+            case "atan2":
+            case "atanh":
+            case "cbrt":
+            case "ceil":
+            case "clz32":
+            case "cos":
+            case "cosh":
+            case "exp":
+            case "expm1":
+            case "floor":
+            case "fround":
+            case "imul":
             case "log":
+            case "log10":
+            case "log1p":
+            case "log2":
+            case "pow":
+            case "round":
+            case "sign":
             case "sin":
-            case "cos":
+            case "sinh":
+            case "sqrt":
+            case "tan":
+            case "tanh":
+            case "trunc":
+                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context, { readnone: true, noUnwind: true });
+            case "hypot":
             case "max":
             case "min":
-            case "round":
-            case "floor":
-                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context, { readnone: true, noUnwind: true });
+                // read the values from the passed varargs or spread array
+                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context, { readonly: true, noUnwind: true });
+            case "random":
+                // reads and updates the state of the random number generator
+                return UnresolvedMethodReference.createRuntimeMethod(this, signatures, context, { noUnwind: true });
             default:
                 throw CodeGenerationDiagnostics.builtInMethodNotSupported(propertyAccessExpression, "Math", symbol.name);
         }
@@ -44,7 +74,14 @@ export class MathObjectReference extends BuiltInObjectReference {
 
     protected createPropertyReference(symbol: ts.Symbol, propertyAccess: ts.PropertyAccessExpression, context: CodeGenerationContext): ObjectPropertyReference {
         switch (symbol.name) {
+            case "E":
+            case "LN10":
+            case "LN2":
+            case "LOG10E":
+            case "LOG2E":
             case "PI":
+            case "SQRT1_2":
+            case "SQRT2":
                 return ComputedObjectPropertyReferenceBuilder
                     .forProperty(propertyAccess, context)
                     .readonly()
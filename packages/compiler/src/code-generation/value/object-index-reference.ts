@@ -11,8 +11,8 @@ import {AssignableValue, Value} from "./value";
 export class ObjectIndexReference implements AssignableValue {
 
     constructor(public type: ts.Type,
-                private object: ObjectReference,
-                private index: Value,
+                protected object: ObjectReference,
+                protected index: Value,
                 private getter: llvm.Function | undefined,
                 private setter: llvm.Function | undefined) {
     }
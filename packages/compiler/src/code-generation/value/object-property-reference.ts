@@ -2,6 +2,8 @@ import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
 import {invoke} from "../util/functions";
+import {isValueClassType, toValueObjectStruct} from "../util/types";
+import {AddressLValue} from "./address-lvalue";
 import {Allocation} from "./allocation";
 import {ObjectReference} from "./object-reference";
 import {AssignableValue, Value} from "./value";
@@ -106,7 +108,8 @@ class ComputedObjectPropertyReference extends ObjectPropertyReference {
 }
 
 /**
- * Backs a property that dispatches directly to an object field
+ * Backs a property that dispatches directly to an object field. A value object stored in the field is referenced
+ * by the address of the field and is copied when assigned.
  */
 class ObjectFieldPropertyReference extends ObjectPropertyReference {
 
@@ -115,14 +118,19 @@ class ObjectFieldPropertyReference extends ObjectPropertyReference {
     }
 
     protected getValue(context: CodeGenerationContext): Value {
+        if (isValueClassType(this.propertyType)) {
+            const classReference = context.resolveClass(this.propertyType)!;
+            return classReference.objectFor(new AddressLValue(this.getFieldAddress(context), this.propertyType), this.propertyType, context);
+        }
+
         const alignment = Allocation.getPreferredValueAlignment(this.propertyType, context);
         const value = context.builder.createAlignedLoad(this.getFieldAddress(context), alignment, this.property.name);
         return context.value(value, this.propertyType);
     }
 
     protected setValue(value: Value, context: CodeGenerationContext): void {
-        const alignment = Allocation.getPreferredValueAlignment(this.propertyType, context);
-        context.builder.createAlignedStore(value.generateIR(context), this.getFieldAddress(context), alignment);
+        const llvmValue = toValueObjectStruct(value.generateIR(context), this.propertyType, context);
+        context.builder.createAlignedStore(llvmValue, this.getFieldAddress(context), Allocation.getPreferredValueAlignment(llvmValue.type, context));
     }
 
     isAssignable(): boolean {
@@ -132,7 +140,7 @@ class ObjectFieldPropertyReference extends ObjectPropertyReference {
     private getFieldAddress(context: CodeGenerationContext) {
         const fieldIndex = [
             llvm.ConstantInt.get(context.llvmContext, 0),
-            llvm.ConstantInt.get(context.llvmContext, this.object.clazz.getFieldOffset(this.property))
+            llvm.ConstantInt.get(context.llvmContext, this.object.clazz.getFieldOffset(this.property, context))
         ];
 
         return context.builder.createInBoundsGEP(this.object.generateIR(context), fieldIndex, `&${this.property.name}`);
@@ -2,7 +2,7 @@ import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
 import {FunctionDeclarationBuilder} from "../util/function-declaration-builder";
-import {isMaybeObjectType} from "../util/types";
+import {isInt64Type, isMaybeObjectType, isSIMDVectorType, isUintType} from "../util/types";
 import {ObjectReference} from "./object-reference";
 import {Value} from "./value";
 
@@ -43,8 +43,11 @@ export class Primitive implements Value {
     static toInt32(value: Value, valueType: ts.Type, int32Type: ts.Type, context: CodeGenerationContext) {
         let intValue: llvm.Value;
 
-        if (valueType.flags & ts.TypeFlags.IntLike) {
+        if (valueType.flags & ts.TypeFlags.IntLike || isUintType(valueType)) {
             intValue = value.generateIR(context);
+        } else if (isInt64Type(valueType)) {
+            const llvmValue = value.generateIR(context);
+            intValue = context.builder.createTrunc(llvmValue, llvm.Type.getInt32Ty(context.llvmContext), `${llvmValue.name}AsInt32`);
         } else if (valueType.flags & ts.TypeFlags.BooleanLike) {
             const llvmValue = value.generateIR(context);
             intValue = context.builder.createZExt(llvmValue, llvm.Type.getInt32Ty(context.llvmContext), `${llvmValue.name}AsInt32`);
@@ -68,6 +71,56 @@ export class Primitive implements Value {
         return new Primitive(intValue, int32Type);
     }
 
+    /**
+     * Converts the value to a uint32 type. The result has the same bits as the value converted to an int32 (ToUint32(x) === ToInt32(x) >>> 0)
+     * @param value the value to convert
+     * @param valueType the type of the value
+     * @param uint32Type the uint type
+     * @param context the context
+     * @return the converted value
+     */
+    static toUint32(value: Value, valueType: ts.Type, uint32Type: ts.Type, context: CodeGenerationContext) {
+        return Primitive.toInt32(value, valueType, uint32Type, context);
+    }
+
+    /**
+     * Converts the value to an int64 type. Numbers are truncated towards zero and wrapped modulo 2^64 (BigInt.asIntN(64, x))
+     * @param value the value to convert
+     * @param valueType the type of the value
+     * @param int64Type the int64 type
+     * @param context the context
+     * @return the converted value
+     */
+    static toInt64(value: Value, valueType: ts.Type, int64Type: ts.Type, context: CodeGenerationContext) {
+        const llvmValue = value.generateIR(context);
+        const int64 = llvm.Type.getInt64Ty(context.llvmContext);
+        let intValue: llvm.Value;
+
+        if (isInt64Type(valueType)) {
+            intValue = llvmValue;
+        } else if (valueType.flags & ts.TypeFlags.IntLike) {
+            intValue = context.builder.createSExt(llvmValue, int64, `${llvmValue.name}AsInt64`);
+        } else if (valueType.flags & ts.TypeFlags.BooleanLike || isUintType(valueType)) {
+            intValue = context.builder.createZExt(llvmValue, int64, `${llvmValue.name}AsInt64`);
+        } else if (valueType.flags & ts.TypeFlags.NumberLike) {
+            const fn = FunctionDeclarationBuilder.create("toInt64d", [{
+                name: "value",
+                type: valueType
+            }], int64Type, context)
+                .withAttribute(llvm.Attribute.AttrKind.ReadNone)
+                .withAttribute(llvm.Attribute.AttrKind.AlwaysInline)
+                .externalLinkage()
+                .declareIfNotExisting();
+            intValue = context.builder.createCall(fn, [llvmValue], `${llvmValue.name}AsInt64`);
+        } else if (valueType.flags & ts.TypeFlags.Object || isMaybeObjectType(valueType)) {
+            intValue = llvm.ConstantInt.get(context.llvmContext, 0, 64);
+        } else {
+            throw new Error(`Unsupported conversion of ${context.typeChecker.typeToString(valueType)} to int64`);
+        }
+
+        return new Primitive(intValue, int64Type);
+    }
+
     /**
      * Converts the given value to a boolean
      * @param value the value to convert
@@ -82,10 +135,14 @@ export class Primitive implements Value {
             return llvmValue;
         }
 
-        if (valueType.flags & ts.TypeFlags.IntLike) {
+        if (valueType.flags & ts.TypeFlags.IntLike || isUintType(valueType)) {
             return context.builder.createICmpNE(llvmValue, llvm.ConstantInt.get(context.llvmContext, 0), `${llvmValue.name}AsBool`);
         }
 
+        if (isInt64Type(valueType)) {
+            return context.builder.createICmpNE(llvmValue, llvm.ConstantInt.get(context.llvmContext, 0, 64), `${llvmValue.name}AsBool`);
+        }
+
         if (valueType.flags & ts.TypeFlags.NumberLike) {
             return context.builder.createFCmpONE(llvmValue, llvm.ConstantFP.get(context.llvmContext, 0), `${llvmValue.name}AsBool`);
         }
@@ -115,8 +172,10 @@ export class Primitive implements Value {
 
         if (valueType.flags & ts.TypeFlags.BooleanLike) {
             numberValue = context.builder.createUIToFP(llvmValue, llvm.Type.getDoubleTy(context.llvmContext), `${llvmValue.name}AsNumber`);
-        } else if (valueType.flags & ts.TypeFlags.IntLike) {
+        } else if (valueType.flags & ts.TypeFlags.IntLike || isInt64Type(valueType)) {
             numberValue = context.builder.createSIToFP(llvmValue, llvm.Type.getDoubleTy(context.llvmContext), `${llvmValue.name}AsNumber`);
+        } else if (isUintType(valueType)) {
+            numberValue = context.builder.createUIToFP(llvmValue, llvm.Type.getDoubleTy(context.llvmContext), `${llvmValue.name}AsNumber`);
         } else if (valueType.flags & ts.TypeFlags.NumberLike) {
             numberValue = llvmValue;
         } else if (valueType.flags & ts.TypeFlags.Undefined) {
@@ -154,6 +213,11 @@ export class Primitive implements Value {
             return this;
         }
 
+        if (isSIMDVectorType(type) || isSIMDVectorType(this.type)) {
+            // vectors are only converted lane wise by their operations
+            return undefined;
+        }
+
         if (type.flags & ts.TypeFlags.BooleanLike) {
             // no safe implicit cast to boolean, skip
             return undefined;
@@ -164,6 +228,18 @@ export class Primitive implements Value {
             return this.type.flags & ts.TypeFlags.BooleanLike ? Primitive.toInt32(this, this.type, type, context) : undefined;
         }
 
+        if (isInt64Type(type)) {
+            // int, uint and boolean values are widened to int64, numbers require an explicit cast
+            const isWidened = isInt64Type(this.type) || isUintType(this.type) || this.type.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike);
+            return isWidened ? Primitive.toInt64(this, this.type, type, context) : undefined;
+        }
+
+        if (isUintType(type)) {
+            // int values keep their bits (as x >>> 0), numbers require an explicit cast
+            const isConvertible = isUintType(this.type) || this.type.flags & (ts.TypeFlags.IntLike | ts.TypeFlags.BooleanLike);
+            return isConvertible ? Primitive.toUint32(this, this.type, type, context) : undefined;
+        }
+
         // all primitive types can safely be casted to number
         if (type.flags & ts.TypeFlags.NumberLike) {
             return Primitive.toNumber(this, this.type, type, context);
@@ -70,9 +70,9 @@ export interface ResolvedFunction {
     parameters: ResolvedFunctionParameter[];
 
     /**
-     * The type parameters passed
+     * The type arguments passed for the type parameters of a generic function (e.g. min<int>(...), T is int)
      */
-    typeParameters: ts.Type[];
+    typeArguments: Map<ts.TypeParameter, ts.Type>;
 
     /**
      * The resolved return type of the function
@@ -101,7 +101,7 @@ export interface ResolvedFunction {
  * Creates a new resolved function
  */
 export function createResolvedFunction(name: string,
-                                       typeParameters: ts.Type[],
+                                       typeArguments: Map<ts.TypeParameter, ts.Type>,
                                        parameters: ResolvedFunctionParameter[],
                                        returnType: ts.Type,
                                        sourceFile?: ts.SourceFile,
@@ -112,7 +112,7 @@ export function createResolvedFunction(name: string,
         async,
         functionName: name,
         parameters,
-        typeParameters,
+        typeArguments,
         instanceMethod,
         returnType,
         sourceFile,
@@ -168,10 +168,37 @@ export function createResolvedFunctionFromSignature(signature: ts.Signature,
         returnType,
         sourceFile: signature.declaration.getSourceFile(),
         symbol,
-        typeParameters: signature.typeParameters || []
+        typeArguments: compilationContext.typeChecker.getTypeArgumentsOfSignature(signature)
     };
 }
 
+/**
+ * Returns the type arguments to use when defining the given function. These are the type arguments of the function itself
+ * and, for methods and constructors of a generic class, the type arguments of the class instantiation.
+ * @param resolvedFunction the resolved function
+ * @return the type argument for each type parameter used in the definition of the function
+ */
+export function getTypeArgumentsOfDefinition(resolvedFunction: ResolvedFunction): Map<ts.TypeParameter, ts.Type> {
+    const typeArguments = new Map<ts.TypeParameter, ts.Type>();
+    const classType = resolvedFunction.classType;
+
+    if (classType && classType.objectFlags & ts.ObjectFlags.Reference) {
+        const classReference = classType as ts.TypeReference;
+        const typeParameters = classReference.target.typeParameters || [];
+
+        if (typeParameters.length > 0) {
+            typeParameters.forEach((typeParameter, i) => typeArguments.set(typeParameter, classReference.typeArguments[i]));
+            typeArguments.set(classReference.target.thisType!, classType);
+        }
+    }
+
+    for (const [typeParameter, typeArgument] of Array.from(resolvedFunction.typeArguments.entries())) {
+        typeArguments.set(typeParameter, typeArgument);
+    }
+
+    return typeArguments;
+}
+
 function getClassType(signature: ts.Signature, typeChecker: TypeChecker): ts.ObjectType | undefined {
     const declaration = signature.getDeclaration();
     if (declaration.kind === ts.SyntaxKind.ConstructSignature) {
@@ -0,0 +1,275 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SIMDVectorKind} from "../util/types";
+import {Allocation} from "./allocation";
+import {ArrayReference} from "./array-reference";
+import {FunctionReference} from "./function-reference";
+import {ObjectReference} from "./object-reference";
+import {Undefined} from "./undefined";
+import {AssignableValue, Value} from "./value";
+
+/**
+ * Reference to an operation of a SIMD vector type, e.g. Float64x2.add.
+ *
+ * The operations are generated inline and process the lanes of the vectors one by one. A vector is an llvm array value
+ * (e.g. [2 x double]) that is spilled to the stack to access its lanes. SROA splits these stack slots into the scalar lanes
+ * and the SLP vectorizer packs the lane operations into SIMD instructions if the target supports them.
+ */
+export class SIMDOperationReference implements FunctionReference {
+
+    /**
+     * Creates a new instance
+     * @param kind the vector type
+     * @param name the name of the operation
+     * @param signature the declared signature of the operation
+     */
+    constructor(private kind: SIMDVectorKind, private name: string, private signature: ts.Signature) {
+    }
+
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): Value | void {
+        const args = callExpression.arguments || [] as ts.Expression[];
+        const parameterTypes = this.getParameterTypes(callerContext);
+
+        const values = args.map((arg, i) => {
+            const casted = callerContext.generateValue(arg).castImplicit(parameterTypes[i], callerContext);
+
+            if (!casted) {
+                throw CodeGenerationDiagnostics.unsupportedImplicitCastOfArgument(
+                    arg,
+                    callerContext.typeChecker.typeToString(parameterTypes[i]),
+                    callerContext.typeChecker.typeToString(callerContext.typeChecker.getTypeAtLocation(arg))
+                );
+            }
+
+            return casted.generateIR(callerContext);
+        });
+
+        return this.invokeWith(values, callerContext);
+    }
+
+    invokeWith(args: llvm.Value[], callerContext: CodeGenerationContext): Value | void {
+        const returnType = this.signature.getReturnType();
+        const result = this.generateOperation(args, callerContext);
+
+        if (returnType.flags & ts.TypeFlags.Void) {
+            return Undefined.create(callerContext);
+        }
+
+        return callerContext.value(result!, returnType);
+    }
+
+    isAssignable(): this is AssignableValue {
+        return false;
+    }
+
+    isObject(): this is ObjectReference {
+        return false;
+    }
+
+    dereference(): this {
+        return this;
+    }
+
+    generateIR(): llvm.Value {
+        throw new Error(`The SIMD operation ${this.kind.operationsName}.${this.name} cannot be used as a function value.`);
+    }
+
+    castImplicit(): Value | undefined {
+        return undefined;
+    }
+
+    private generateOperation(args: llvm.Value[], context: CodeGenerationContext): llvm.Value | undefined {
+        const builder = context.builder;
+        const floatingPoint = this.kind.floatingPoint;
+
+        switch (this.name) {
+            case "of":
+                return this.fromLanes(args, context);
+            case "splat":
+                return this.fromLanes(Array.from({ length: this.kind.lanes }, () => args[0]), context);
+            case "add":
+                return this.mapLanes(args, (a, b) => floatingPoint ? builder.createFAdd(a, b, "add") : builder.createAdd(a, b, "add"), context);
+            case "sub":
+                return this.mapLanes(args, (a, b) => floatingPoint ? builder.createFSub(a, b, "sub") : builder.createSub(a, b, "sub"), context);
+            case "mul":
+                return this.mapLanes(args, (a, b) => floatingPoint ? builder.createFMul(a, b, "mul") : builder.createMul(a, b, "mul"), context);
+            case "div":
+                return this.mapLanes(args, (a, b) => builder.createFDiv(a, b, "div"), context);
+            case "neg":
+                return this.mapLanes(args, a => floatingPoint ? builder.createFNeg(a, "neg") : builder.createNeg(a, "neg"), context);
+            case "and":
+                return this.mapLanes(args, (a, b) => builder.createAnd(a, b, "and"), context);
+            case "or":
+                return this.mapLanes(args, (a, b) => builder.createOr(a, b, "or"), context);
+            case "xor":
+                return this.mapLanes(args, (a, b) => builder.createXor(a, b, "xor"), context);
+            case "min":
+                return this.mapLanes(args, (a, b) => builder.createSelect(this.createLessThan(b, a, context), b, a, "min"), context);
+            case "max":
+                return this.mapLanes(args, (a, b) => builder.createSelect(this.createLessThan(a, b, context), b, a, "max"), context);
+            case "sum":
+                return this.toLanes(args[0], context).reduce((sum, lane) => {
+                    return floatingPoint ? builder.createFAdd(sum, lane, "sum") : builder.createAdd(sum, lane, "sum");
+                });
+            case "extractLane":
+                return this.loadLane(this.spill(args[0], context), this.toLaneIndex(args[1], this.kind.lanes, context), context);
+            case "replaceLane":
+                return this.replaceLane(args[0], args[1], args[2], context);
+            case "swizzle":
+                return this.shuffle([args[0]], args.slice(1), context);
+            case "shuffle":
+                return this.shuffle([args[0], args[1]], args.slice(2), context);
+            case "load":
+                return this.load(args[0], args[1], context);
+            case "store":
+                return this.store(args[0], args[1], args[2], context);
+            default:
+                throw new Error(`Unsupported SIMD operation ${this.kind.operationsName}.${this.name}`);
+        }
+    }
+
+    private replaceLane(vector: llvm.Value, lane: llvm.Value, value: llvm.Value, context: CodeGenerationContext) {
+        const storage = this.spill(vector, context);
+        const laneType = this.getLaneType(context);
+        const address = this.getLaneAddress(storage, this.toLaneIndex(lane, this.kind.lanes, context), context);
+
+        context.builder.createAlignedStore(value, address, Allocation.getPreferredValueAlignment(laneType, context));
+        return this.loadVector(storage, context);
+    }
+
+    /**
+     * Creates a vector whose lanes are selected from the lanes of the given vectors (the lanes of the first vector followed
+     * by the lanes of the second vector)
+     */
+    private shuffle(vectors: llvm.Value[], selectors: llvm.Value[], context: CodeGenerationContext) {
+        const laneType = this.getLaneType(context);
+        const numberOfLanes = this.kind.lanes * vectors.length;
+        const storage = Allocation.createAllocaInstInEntryBlock(llvm.ArrayType.get(laneType, numberOfLanes), context, "lanes");
+
+        vectors.forEach((vector, i) => {
+            this.toLanes(vector, context).forEach((lane, j) => {
+                const address = this.getLaneAddress(storage, llvm.ConstantInt.get(context.llvmContext, i * this.kind.lanes + j), context);
+                context.builder.createAlignedStore(lane, address, Allocation.getPreferredValueAlignment(laneType, context));
+            });
+        });
+
+        return this.fromLanes(selectors.map(selector => this.loadLane(storage, this.toLaneIndex(selector, numberOfLanes, context), context)), context);
+    }
+
+    private load(array: llvm.Value, index: llvm.Value, context: CodeGenerationContext) {
+        const address = this.getElementsAddress(array, index, context);
+        return context.builder.createAlignedLoad(address, Allocation.getPreferredValueAlignment(this.getLaneType(context), context), "vector");
+    }
+
+    private store(array: llvm.Value, index: llvm.Value, vector: llvm.Value, context: CodeGenerationContext) {
+        const address = this.getElementsAddress(array, index, context);
+        context.builder.createAlignedStore(vector, address, Allocation.getPreferredValueAlignment(this.getLaneType(context), context));
+        return undefined;
+    }
+
+    /**
+     * Returns the address of the array elements array[index] to array[index + lanes - 1] as pointer to a vector.
+     * The index is only checked against the bounds of the array in safe functions. Out of bounds accesses of
+     * safe functions are redirected to a zeroed stack slot, loads return a zero vector and stores have no effect.
+     */
+    private getElementsAddress(array: llvm.Value, index: llvm.Value, context: CodeGenerationContext): llvm.Value {
+        const arrayType = this.getParameterTypes(context)[0];
+        const arrayReference = context.value(array, arrayType).dereference(context) as ArrayReference;
+        const vectorPointerType = this.getVectorType(context).getPointerTo();
+
+        if (context.scope.unsafe || context.compilationContext.compilerOptions.unsafe) {
+            const elementAddress = context.builder.createInBoundsGEP(arrayReference.getElements(context), [index], "&[i]");
+            return context.builder.createBitCast(elementAddress, vectorPointerType, "&vector");
+        }
+
+        const { elements, length } = arrayReference.toCArray(context);
+        const elementAddress = context.builder.createInBoundsGEP(elements, [index], "&[i]");
+        const lastIndex = context.builder.createSub(length, llvm.ConstantInt.get(context.llvmContext, this.kind.lanes), "lastIndex");
+        const inBounds = context.builder.createAnd(
+            context.builder.createICmpSGE(index, llvm.ConstantInt.get(context.llvmContext, 0), "isPositive"),
+            context.builder.createICmpSLE(index, lastIndex, "isBeforeEnd"),
+            "inBounds"
+        );
+
+        const outOfBounds = Allocation.createAllocaInstInEntryBlock(this.getVectorType(context), context, "outOfBounds");
+        context.builder.createAlignedStore(llvm.Constant.getNullValue(this.getVectorType(context)), outOfBounds, outOfBounds.alignment);
+
+        return context.builder.createSelect(inBounds, context.builder.createBitCast(elementAddress, vectorPointerType, "&vector"), outOfBounds, "&vector");
+    }
+
+    private mapLanes(vectors: llvm.Value[], operation: (...lanes: llvm.Value[]) => llvm.Value, context: CodeGenerationContext) {
+        const lanesOfVectors = vectors.map(vector => this.toLanes(vector, context));
+        const result = lanesOfVectors[0].map((lane, i) => operation(...lanesOfVectors.map(lanes => lanes[i])));
+        return this.fromLanes(result, context);
+    }
+
+    private createLessThan(lhs: llvm.Value, rhs: llvm.Value, context: CodeGenerationContext) {
+        return this.kind.floatingPoint ? context.builder.createFCmpOLT(lhs, rhs, "cmpLT") : context.builder.createICmpSLT(lhs, rhs, "cmpLT");
+    }
+
+    /**
+     * Converts a lane selector into a lane index in the range [0, numberOfLanes) by taking it modulo the number of lanes
+     */
+    private toLaneIndex(selector: llvm.Value, numberOfLanes: number, context: CodeGenerationContext) {
+        return context.builder.createAnd(selector, llvm.ConstantInt.get(context.llvmContext, numberOfLanes - 1), "laneIndex");
+    }
+
+    private toLanes(vector: llvm.Value, context: CodeGenerationContext): llvm.Value[] {
+        const storage = this.spill(vector, context);
+        const lanes: llvm.Value[] = [];
+
+        for (let i = 0; i < this.kind.lanes; ++i) {
+            lanes.push(this.loadLane(storage, llvm.ConstantInt.get(context.llvmContext, i), context));
+        }
+
+        return lanes;
+    }
+
+    private fromLanes(lanes: llvm.Value[], context: CodeGenerationContext): llvm.Value {
+        const laneType = this.getLaneType(context);
+        const storage = Allocation.createAllocaInstInEntryBlock(this.getVectorType(context), context, "vector");
+
+        lanes.forEach((lane, i) => {
+            const address = this.getLaneAddress(storage, llvm.ConstantInt.get(context.llvmContext, i), context);
+            context.builder.createAlignedStore(lane, address, Allocation.getPreferredValueAlignment(laneType, context));
+        });
+
+        return this.loadVector(storage, context);
+    }
+
+    private spill(vector: llvm.Value, context: CodeGenerationContext) {
+        const storage = Allocation.createAllocaInstInEntryBlock(vector.type, context, "vector");
+        context.builder.createAlignedStore(vector, storage, storage.alignment);
+        return storage;
+    }
+
+    private loadVector(storage: llvm.AllocaInst, context: CodeGenerationContext) {
+        return context.builder.createAlignedLoad(storage, storage.alignment, "vector");
+    }
+
+    private loadLane(storage: llvm.Value, index: llvm.Value, context: CodeGenerationContext) {
+        const address = this.getLaneAddress(storage, index, context);
+        return context.builder.createAlignedLoad(address, Allocation.getPreferredValueAlignment(this.getLaneType(context), context), "lane");
+    }
+
+    private getLaneAddress(storage: llvm.Value, index: llvm.Value, context: CodeGenerationContext) {
+        return context.builder.createInBoundsGEP(storage, [llvm.ConstantInt.get(context.llvmContext, 0), index], "&lane");
+    }
+
+    private getParameterTypes(context: CodeGenerationContext) {
+        const declaration = this.signature.getDeclaration();
+        return this.signature.getParameters().map((parameter, i) => {
+            return context.typeChecker.getTypeOfSymbolAtLocation(parameter, declaration.parameters[i]);
+        });
+    }
+
+    private getLaneType(context: CodeGenerationContext) {
+        return this.kind.floatingPoint ? llvm.Type.getDoubleTy(context.llvmContext) : llvm.Type.getInt32Ty(context.llvmContext);
+    }
+
+    private getVectorType(context: CodeGenerationContext) {
+        return llvm.ArrayType.get(this.getLaneType(context), this.kind.lanes);
+    }
+}
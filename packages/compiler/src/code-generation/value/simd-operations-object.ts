@@ -0,0 +1,59 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {SIMDVectorKind} from "../util/types";
+import {ObjectReference} from "./object-reference";
+import {SIMDOperationReference} from "./simd-operation-reference";
+import {AssignableValue, Value} from "./value";
+
+/**
+ * The built in object that provides the operations of a SIMD vector type, e.g. Float64x2 for float64x2.
+ * The object has no runtime representation, its operations are generated inline where they are called.
+ */
+export class SIMDOperationsObject implements Value {
+
+    /**
+     * Creates a new instance
+     * @param kind the vector type of which the object provides the operations
+     * @param type the type of the object, e.g. Float64x2Constructor
+     */
+    constructor(private kind: SIMDVectorKind, private type: ts.Type) {
+    }
+
+    /**
+     * Returns the operation accessed by the given property access expression, e.g. Float64x2.add
+     * @param propertyAccess the property access expression
+     * @param context the context
+     * @return the reference to the operation
+     */
+    getOperation(propertyAccess: ts.PropertyAccessExpression, context: CodeGenerationContext): SIMDOperationReference {
+        const symbol = this.type.getProperty(propertyAccess.name.text);
+        if (!symbol || !(symbol.flags & ts.SymbolFlags.Method)) {
+            throw CodeGenerationDiagnostics.builtInPropertyNotSupported(propertyAccess, this.kind.operationsName);
+        }
+
+        const signature = context.typeChecker.getSignatureFromDeclaration(symbol.valueDeclaration as ts.MethodSignature);
+        return new SIMDOperationReference(this.kind, symbol.name, signature);
+    }
+
+    isAssignable(): this is AssignableValue {
+        return false;
+    }
+
+    isObject(): this is ObjectReference {
+        return false;
+    }
+
+    dereference(): this {
+        return this;
+    }
+
+    generateIR(): llvm.Value {
+        throw new Error(`The built in object ${this.kind.operationsName} has no value, only its operations can be called.`);
+    }
+
+    castImplicit(): Value | undefined {
+        return undefined;
+    }
+}
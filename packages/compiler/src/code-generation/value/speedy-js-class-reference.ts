@@ -4,7 +4,10 @@ import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
 import {CompilationContext} from "../../compilation-context";
 import {CodeGenerationContext} from "../code-generation-context";
+import {isGenericType, isValueClassType} from "../util/types";
+import {TypePlace} from "../util/typescript-to-llvm-type-converter";
 import {Address} from "./address";
+import {Allocation} from "./allocation";
 
 import {ClassReference, Field} from "./class-reference";
 import {FunctionReference} from "./function-reference";
@@ -18,21 +21,32 @@ export class SpeedyJSClassReference extends ClassReference {
         const baseTypes = type.getBaseTypes();
 
         const declaration = type.getSymbol().valueDeclaration as ts.ClassDeclaration;
-        if (baseTypes && type.getBaseTypes().length > 0) {
+        if (baseTypes && baseTypes.length > 0 && !SpeedyJSClassReference.isSupportedBaseType(type, baseTypes[0], context)) {
             throw CodeGenerationDiagnostics.unsupportedClassInheritance(declaration);
         }
 
-        if (type.objectFlags & ts.ObjectFlags.Reference) {
-            const typeReference = type as ts.TypeReference;
-            if (typeReference.typeArguments && typeReference.typeArguments.length > 0) {
-                throw CodeGenerationDiagnostics.unsupportedGenericClass(declaration);
-            }
+        // Value objects are copied without their dynamic type, value classes can therefore not be part of a class hierarchy
+        if (isValueClassType(type) && context.compilationContext.classHierarchy.isPolymorphic(type.getSymbol())) {
+            throw CodeGenerationDiagnostics.unsupportedValueClassInheritance(declaration);
+        }
+
+        // Instances of a generic class differ in their layout, the type descriptor can therefore not be shared with subclasses
+        if (isGenericType(type) && context.compilationContext.classHierarchy.isPolymorphic(type.getSymbol())) {
+            throw CodeGenerationDiagnostics.unsupportedGenericClass(declaration);
         }
 
         const typeInformation = ClassReference.createTypeDescriptor(type.getSymbol(), context);
         return new SpeedyJSClassReference(typeInformation, type, context.compilationContext);
     }
 
+    private static isSupportedBaseType(type: ts.ObjectType, baseType: ts.BaseType, context: CodeGenerationContext) {
+        const baseClass = context.compilationContext.classHierarchy.getBaseClass(type.getSymbol());
+        const typeArguments = baseType.flags & ts.TypeFlags.Object && (baseType as ts.ObjectType).objectFlags & ts.ObjectFlags.Reference ?
+            (baseType as ts.TypeReference).typeArguments : undefined;
+
+        return !!baseClass && baseClass === baseType.getSymbol() && !(typeArguments && typeArguments.length > 0);
+    }
+
     private constructor(typeInformation: llvm.GlobalVariable, private objectType: ts.ObjectType, compilationContext: CompilationContext) {
         super(typeInformation, objectType.getSymbol(), compilationContext);
     }
@@ -41,10 +55,30 @@ export class SpeedyJSClassReference extends ClassReference {
         return this.objectType;
     }
 
-    getFields(type: ts.ObjectType, context: CodeGenerationContext): Field[] {
-        const fields = this.type.getApparentProperties().filter(property => property.flags & ts.SymbolFlags.Property);
+    /**
+     * Indicator if the class extends or is extended by another class. The instances of these classes store a pointer
+     * to the type descriptor of their class in front of the fields.
+     */
+    get polymorphic() {
+        return this.compilationContext.classHierarchy.isPolymorphic(this.symbol);
+    }
+
+    /**
+     * Returns the class this class extends
+     * @param context the context
+     * @return the base class or undefined if this class does not extend another class
+     */
+    getBaseClass(context: CodeGenerationContext): SpeedyJSClassReference | undefined {
+        const baseClass = this.compilationContext.classHierarchy.getBaseClass(this.symbol);
+        if (!baseClass) {
+            return undefined;
+        }
 
-        return fields.map(field => {
+        return context.resolveClass(this.compilationContext.typeChecker.getDeclaredTypeOfSymbol(baseClass)) as SpeedyJSClassReference;
+    }
+
+    getFields(type: ts.ObjectType, context: CodeGenerationContext): Field[] {
+        return this.getFieldSymbols(context).map(field => {
             return {
                 name: field.getName(),
                 type: context.typeChecker.getTypeOfSymbolAtLocation(field, field.valueDeclaration!)
@@ -52,14 +86,137 @@ export class SpeedyJSClassReference extends ClassReference {
         });
     }
 
+    getFieldOffset(property: ts.Symbol, context: CodeGenerationContext) {
+        assert(property.flags & ts.SymbolFlags.Property, `The property ${property.name} is not a property (e.g. a method instead)`);
+
+        const index = this.getFieldSymbols(context).findIndex(field => field.name === property.name);
+        assert(index >= 0, `The property ${property.name} could not be found in class ${this.type.getSymbol().name}`);
+
+        return index + (this.polymorphic ? 1 : 0);
+    }
+
+    /**
+     * Returns the fields declared by this class (but not the inherited ones)
+     */
+    getOwnFields(): ts.Symbol[] {
+        const declaration = this.symbol.valueDeclaration as ts.ClassDeclaration;
+
+        return this.type.getApparentProperties().filter(property => {
+            if (!(property.flags & ts.SymbolFlags.Property)) {
+                return false;
+            }
+
+            // Fields declared in the class body or as parameter properties of the constructor
+            const parent = property.valueDeclaration!.parent!;
+            return parent === declaration || parent.kind === ts.SyntaxKind.Constructor && parent.parent === declaration;
+        });
+    }
+
+    /**
+     * Returns the type descriptor of this class that identifies the class of an object at runtime
+     * @param context the context
+     */
+    getTypeDescriptor(context: CodeGenerationContext): llvm.Value {
+        return context.builder.createBitCast(this.typeInformation, llvm.Type.getInt8PtrTy(context.llvmContext));
+    }
+
+    /**
+     * Loads the type descriptor of the class of the given object
+     * @param object the pointer to an instance of this class or any of its subclasses
+     * @param context the context
+     */
+    loadTypeDescriptorOf(object: llvm.Value, context: CodeGenerationContext): llvm.Value {
+        assert(this.polymorphic, "Only instances of classes in a class hierarchy store their type descriptor");
+
+        const address = context.builder.createInBoundsGEP(object, [
+            llvm.ConstantInt.get(context.llvmContext, 0),
+            llvm.ConstantInt.get(context.llvmContext, 0)
+        ], "&typeDescriptor");
+
+        const pointerType = llvm.Type.getInt8PtrTy(context.llvmContext);
+        return context.builder.createAlignedLoad(address, Allocation.getPreferredValueAlignment(pointerType, context), "typeDescriptor");
+    }
+
+    /**
+     * Stores the type descriptor of this class in the header of a newly allocated object
+     * @param object the pointer to the new instance
+     * @param context the context
+     */
+    initializeTypeDescriptor(object: llvm.Value, context: CodeGenerationContext) {
+        if (!this.polymorphic) {
+            return;
+        }
+
+        const address = context.builder.createInBoundsGEP(object, [
+            llvm.ConstantInt.get(context.llvmContext, 0),
+            llvm.ConstantInt.get(context.llvmContext, 0)
+        ], "&typeDescriptor");
+
+        const typeDescriptor = this.getTypeDescriptor(context);
+        context.builder.createAlignedStore(typeDescriptor, address, Allocation.getPreferredValueAlignment(typeDescriptor.type, context));
+    }
+
     getConstructor(newExpression: ts.NewExpression, context: CodeGenerationContext): FunctionReference {
         const signature = context.typeChecker.getResolvedSignature(newExpression);
-        context.requiresGc = true;
-        return SpeedyJSConstructorFunctionReference.create(signature, this, context);
+
+        // value objects are not allocated on the heap
+        if (!isValueClassType(this.type)) {
+            context.requiresGc = true;
+        }
+
+        // The class identifier references the generic class (e.g. Box<T>), the constructor belongs to the instantiation (e.g. Box<int>)
+        const classReference = isGenericType(this.type) ? context.resolveClass(signature.getReturnType()) as SpeedyJSClassReference : this;
+        return SpeedyJSConstructorFunctionReference.create(signature, classReference, context);
     }
 
     objectFor(address: Address, type: ts.ObjectType, context: CodeGenerationContext): ObjectReference {
         assert(type.flags & ts.TypeFlags.Object, "Requires an object type");
         return new SpeedyJSObjectReference(address, type, this);
     }
+
+    protected getHeaderTypes(context: CodeGenerationContext): llvm.Type[] {
+        return this.polymorphic ? [llvm.Type.getInt8PtrTy(context.llvmContext)] : [];
+    }
+
+    /**
+     * Returns the fields in the order they are stored in the object. The fields of the base class are stored
+     * first so that an instance of a subclass has the same layout as an instance of the base class.
+     * The fields declared by a single class are ordered by descending alignment to avoid padding between them.
+     * @param context the context
+     */
+    private getFieldSymbols(context: CodeGenerationContext): ts.Symbol[] {
+        const classHierarchy = this.compilationContext.classHierarchy;
+        const fields: ts.Symbol[] = [];
+
+        const hierarchy: ts.Symbol[] = [];
+        for (let current: ts.Symbol | undefined = this.symbol; current; current = classHierarchy.getBaseClass(current)) {
+            hierarchy.unshift(current);
+        }
+
+        for (const classSymbol of hierarchy) {
+            const classType = classSymbol === this.symbol ? this.type : this.compilationContext.typeChecker.getDeclaredTypeOfSymbol(classSymbol);
+            const properties = classType.getApparentProperties().filter(property => property.flags & ts.SymbolFlags.Property);
+
+            const ownFields = properties.filter(property => !fields.some(field => field.name === property.name));
+            fields.push(...sortByDescendingAlignment(ownFields, context));
+        }
+
+        return fields;
+    }
+}
+
+/**
+ * Sorts the fields by descending alignment of their types. Fields with the same alignment keep their declaration order.
+ * The alignment is the one the data layout of the module uses for the field in the object struct.
+ */
+function sortByDescendingAlignment(fields: ts.Symbol[], context: CodeGenerationContext): ts.Symbol[] {
+    const dataLayout = context.module.dataLayout;
+
+    return fields
+        .map((field, index) => {
+            const fieldType = context.typeChecker.getTypeOfSymbolAtLocation(field, field.valueDeclaration!);
+            return { field, index, alignment: dataLayout.getPrefTypeAlignment(context.toLLVMType(fieldType, TypePlace.FIELD)) };
+        })
+        .sort((left, right) => right.alignment - left.alignment || left.index - right.index)
+        .map(entry => entry.field);
 }
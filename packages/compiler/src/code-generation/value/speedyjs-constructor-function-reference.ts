@@ -5,31 +5,25 @@ import {CodeGenerationContext} from "../code-generation-context";
 import {DefaultNameMangler} from "../default-name-mangler";
 import {FunctionDeclarationBuilder} from "../util/function-declaration-builder";
 import {FunctionDefinitionBuilder} from "../util/function-definition-builder";
-import {sizeof} from "../util/types";
+import {invoke} from "../util/functions";
+import {isValueClassType, sizeof, toValueObjectStruct} from "../util/types";
 import {TypePlace} from "../util/typescript-to-llvm-type-converter";
 
 import {AbstractFunctionReference} from "./abstract-function-reference";
-import {Address} from "./address";
 import {AddressLValue} from "./address-lvalue";
+import {Allocation} from "./allocation";
+import {CArray} from "./array-reference";
 import {ObjectReference} from "./object-reference";
-import {createResolvedFunction, createResolvedFunctionFromSignature, ResolvedFunction} from "./resolved-function";
+import {createResolvedFunction, createResolvedFunctionFromSignature, getTypeArgumentsOfDefinition, ResolvedFunction} from "./resolved-function";
 import {SpeedyJSClassReference} from "./speedy-js-class-reference";
 import {verifyIsSupportedSpeedyJSFunction} from "./speedyjs-function-factory";
 import {SpeedyJSObjectReference} from "./speedyjs-object-reference";
+import {Value} from "./value";
 
 export class SpeedyJSConstructorFunctionReference extends AbstractFunctionReference {
 
     static create(signature: ts.Signature, classReference: SpeedyJSClassReference, context: CodeGenerationContext) {
-        let resolvedFunction: ResolvedFunction;
-
-        if (signature.declaration) {
-            resolvedFunction = createResolvedFunctionFromSignature(signature, context.compilationContext, classReference.type);
-            verifyIsSupportedSpeedyJSFunction(signature.declaration, context);
-        } else {
-            // default constructor
-            const sourceFile = classReference.type.getSymbol().declarations![0].getSourceFile();
-            resolvedFunction = createResolvedFunction("constructor", [], [], signature.getReturnType(), sourceFile, classReference.type);
-        }
+        const resolvedFunction = resolveConstructor(signature, classReference, context);
 
         const declarationContext = context.createChildContext();
         const fn = new ConstructorFunctionBuilder(resolvedFunction, classReference, declarationContext)
@@ -39,10 +33,42 @@ export class SpeedyJSConstructorFunctionReference extends AbstractFunctionRefere
         return new SpeedyJSConstructorFunctionReference(resolvedFunction, fn);
     }
 
-    constructor(private resolvedFunction: ResolvedFunction, private fn: llvm.Function) {
+    /**
+     * Creates a reference to the constructor of the base class called by super(...) from the constructor of a subclass.
+     * The base class constructor initializes the passed object instead of allocating a new one.
+     * @param signature the resolved signature of the super call
+     * @param baseClass the base class
+     * @param self the object under construction
+     * @param context the context
+     */
+    static createSuper(signature: ts.Signature, baseClass: SpeedyJSClassReference, self: SpeedyJSObjectReference, context: CodeGenerationContext) {
+        const resolvedFunction = resolveConstructor(signature, baseClass, context);
+
+        const declarationContext = context.createChildContext();
+        const fn = new ConstructorFunctionBuilder(resolvedFunction, baseClass, declarationContext, true)
+            .mangleName()
+            .defineIfAbsent();
+
+        return new SpeedyJSConstructorFunctionReference(resolvedFunction, fn, self);
+    }
+
+    constructor(private resolvedFunction: ResolvedFunction, private fn: llvm.Function, private self?: SpeedyJSObjectReference) {
         super(resolvedFunction.classType);
     }
 
+    invoke(callExpression: ts.CallExpression | ts.NewExpression, callerContext: CodeGenerationContext): void | Value {
+        const result = super.invoke(callExpression, callerContext);
+
+        // The fields of the subclass are initialized after the constructor of the base class returns. The fields declared
+        // as constructor parameters have already been assigned the argument values when entering the constructor.
+        if (this.self) {
+            const fields = this.self.clazz.getOwnFields().filter(field => field.valueDeclaration!.kind !== ts.SyntaxKind.Parameter);
+            initializeFields(fields, this.self, callerContext);
+        }
+
+        return result;
+    }
+
     protected getResolvedFunction(callerContext: CodeGenerationContext): ResolvedFunction {
         return this.resolvedFunction;
     }
@@ -54,12 +80,69 @@ export class SpeedyJSConstructorFunctionReference extends AbstractFunctionRefere
     protected getLLVMFunction(): llvm.Function {
         return this.fn;
     }
+
+    protected getCallArguments(resolvedFunction: ResolvedFunction,
+                               passedArguments: llvm.Value[],
+                               callerContext: CodeGenerationContext,
+                               spreadArgument?: CArray): llvm.Value[] {
+        const args = super.getCallArguments(resolvedFunction, passedArguments, callerContext, spreadArgument);
+        return this.self ? [this.self.generateIR(callerContext), ...args] : args;
+    }
+}
+
+/**
+ * Initializes the given fields of the object with their initializer or the default value of the field type
+ * @param fields the fields to initialize
+ * @param object the object
+ * @param context the context
+ */
+export function initializeFields(fields: ts.Symbol[], object: SpeedyJSObjectReference, context: CodeGenerationContext) {
+    for (const field of fields) {
+        const declaration = field.valueDeclaration as ts.PropertyDeclaration;
+        const fieldType = context.typeChecker.getTypeAtLocation(declaration);
+
+        let value: llvm.Value;
+        if (declaration.initializer) {
+            value = toValueObjectStruct(context.generateValue(declaration.initializer).generateIR(context), fieldType, context);
+        } else if (context.compilationContext.compilerOptions.unsafe) {
+            continue;
+        } else {
+            value = llvm.Constant.getNullValue(context.toLLVMType(fieldType, TypePlace.FIELD));
+        }
+
+        const fieldOffset = llvm.ConstantInt.get(context.llvmContext, object.clazz.getFieldOffset(field, context));
+        const gepFieldIndex = [ llvm.ConstantInt.get(context.llvmContext, 0), fieldOffset];
+        const fieldPointer = context.builder.createInBoundsGEP(object.generateIR(context), gepFieldIndex, `&${field.name}`);
+        context.builder.createStore(value, fieldPointer, false);
+    }
 }
 
+function resolveConstructor(signature: ts.Signature, classReference: SpeedyJSClassReference, context: CodeGenerationContext) {
+    if (signature.declaration) {
+        verifyIsSupportedSpeedyJSFunction(signature.declaration, context);
+        return createResolvedFunctionFromSignature(signature, context.compilationContext, classReference.type);
+    }
+
+    // default constructor
+    const sourceFile = classReference.type.getSymbol().declarations![0].getSourceFile();
+    return createResolvedFunction("constructor", new Map(), [], signature.getReturnType(), sourceFile, classReference.type);
+}
+
+/**
+ * Builds the constructor function of a class.
+ *
+ * The constructor of a class that is part of a class hierarchy is split in two functions. The constructor allocates the object,
+ * stores the type descriptor and calls the initializer (constructor.init) that runs the constructor body on the passed object.
+ * The initializer is also called by the super(...) calls of the subclass constructors.
+ */
 class ConstructorFunctionBuilder {
-    private constructorName = "constructor";
+    private constructorName: string;
 
-    constructor(private resolvedFunction: ResolvedFunction, private classReference: SpeedyJSClassReference, private context: CodeGenerationContext) {
+    constructor(private resolvedFunction: ResolvedFunction,
+                private classReference: SpeedyJSClassReference,
+                private context: CodeGenerationContext,
+                private initializer = false) {
+        this.constructorName = initializer ? "constructor.init" : "constructor";
     }
 
     mangleName() {
@@ -75,7 +158,14 @@ class ConstructorFunctionBuilder {
             return existingFn;
         }
 
-        return this.define();
+        // The constructor of a generic class is instantiated for each instantiation of the class
+        return this.context.typeChecker.withTypeArguments(getTypeArgumentsOfDefinition(this.resolvedFunction), () => {
+            if (this.initializer) {
+                return this.defineInitializer();
+            }
+
+            return this.classReference.polymorphic ? this.defineAllocatingConstructor() : this.define();
+        });
     }
 
     private define() {
@@ -88,13 +178,14 @@ class ConstructorFunctionBuilder {
         const entryBlock = llvm.BasicBlock.create(this.context.llvmContext, "entry", declaration);
         this.context.builder.setInsertionPoint(entryBlock);
 
-        const objectAddress = this.allocateObjectOnHeap();
+        const objectAddress = isValueClassType(this.classReference.type) ? this.allocateObjectOnStack() : this.allocateObjectOnHeap();
         const objectReference = new SpeedyJSObjectReference(objectAddress, this.classReference.type, this.classReference);
 
         this.context.enterChildScope(declaration);
         this.context.scope.addVariable(this.classReference.symbol, objectReference);
 
-        this.initializeFields(objectAddress);
+        const fields = this.classReference.type.getApparentProperties().filter(property => property.flags & ts.SymbolFlags.Property);
+        initializeFields(fields, objectReference, this.context);
         this.callUserConstructorFn(declaration, objectReference);
 
         this.context.leaveChildScope();
@@ -102,11 +193,101 @@ class ConstructorFunctionBuilder {
         return declaration;
     }
 
+    private defineAllocatingConstructor() {
+        const initializer = new ConstructorFunctionBuilder(this.resolvedFunction, this.classReference, this.context.createChildContext(), true)
+            .mangleName()
+            .defineIfAbsent();
+
+        const declaration = FunctionDeclarationBuilder
+            .forResolvedFunction(this.resolvedFunction, this.context)
+            .linkOnceOdrLinkage()
+            .name(this.constructorName)
+            .declare();
+
+        const entryBlock = llvm.BasicBlock.create(this.context.llvmContext, "entry", declaration);
+        this.context.builder.setInsertionPoint(entryBlock);
+
+        const objectAddress = this.allocateObjectOnHeap();
+        const object = objectAddress.get(this.context);
+        this.classReference.initializeTypeDescriptor(object, this.context);
+
+        const args = declaration.getArguments();
+        args.forEach((arg, i) => {
+            arg.name = this.resolvedFunction.parameters[i].name;
+        });
+
+        const objectType = this.classReference.getLLVMType(this.classReference.type, this.context).getPointerTo();
+        invoke(initializer, [object, ...args], objectType, this.context);
+        this.context.builder.createRet(object);
+
+        return declaration;
+    }
+
+    private defineInitializer() {
+        const constructorDefinition = this.resolvedFunction.definition;
+        const classDeclaration = this.classReference.symbol.valueDeclaration;
+        const baseClass = this.classReference.getBaseClass(this.context);
+
+        // The constructor is inherited from the base class, initialize the base class part before the own fields
+        let baseInitializer: llvm.Function | undefined;
+        if (baseClass && !(constructorDefinition && constructorDefinition.parent === classDeclaration)) {
+            const baseFunction = Object.assign({}, this.resolvedFunction, { classType: baseClass.type, returnType: baseClass.type });
+            baseInitializer = new ConstructorFunctionBuilder(baseFunction, baseClass, this.context.createChildContext(), true)
+                .mangleName()
+                .defineIfAbsent();
+        }
+
+        const parameters = [{ name: "this", type: this.classReference.type as ts.Type }, ...this.resolvedFunction.parameters];
+        const declaration = FunctionDeclarationBuilder
+            .create(this.constructorName, parameters, this.classReference.type, this.context)
+            .linkOnceOdrLinkage()
+            .declare();
+
+        const entryBlock = llvm.BasicBlock.create(this.context.llvmContext, "entry", declaration);
+        this.context.builder.setInsertionPoint(entryBlock);
+
+        const args = declaration.getArguments();
+        const objectAddress = new AddressLValue(args[0], this.classReference.type);
+        const objectReference = new SpeedyJSObjectReference(objectAddress, this.classReference.type, this.classReference);
+
+        this.context.enterChildScope(declaration);
+        this.context.scope.addVariable(this.classReference.symbol, objectReference);
+
+        if (baseInitializer) {
+            args.forEach((arg, i) => {
+                arg.name = i === 0 ? "this" : this.resolvedFunction.parameters[i - 1].name;
+            });
+            invoke(baseInitializer, args, baseClass!.getLLVMType(baseClass!.type, this.context).getPointerTo(), this.context);
+            initializeFields(this.classReference.getOwnFields(), objectReference, this.context);
+            this.context.builder.createRet(args[0]);
+        } else if (constructorDefinition) {
+            // without a base class, the fields are initialized before the constructor body, otherwise by super(...)
+            if (!baseClass) {
+                initializeFields(this.classReference.getOwnFields(), objectReference, this.context);
+            }
+
+            FunctionDefinitionBuilder.create(declaration, Object.assign({}, this.resolvedFunction, { instanceMethod: true }), this.context)
+                .returnValue(objectReference)
+                .self(objectReference)
+                .define();
+        } else {
+            args[0].name = "this";
+            initializeFields(this.classReference.getOwnFields(), objectReference, this.context);
+            this.context.builder.createRet(args[0]);
+        }
+
+        this.context.leaveChildScope();
+
+        return declaration;
+    }
+
     private allocateObjectOnHeap() {
         const objectType = this.classReference.getLLVMType(this.classReference.type, this.context);
         const pointerType = llvm.Type.getInt8PtrTy(this.context.llvmContext);
         const mallocFunctionType = llvm.FunctionType.get(pointerType, [llvm.Type.getInt32Ty(this.context.llvmContext)], false);
-        const malloc = this.context.module.getOrInsertFunction("malloc", mallocFunctionType);
+        // The warm heap retains its memory between calls of the entry functions, speedyJsGc only resets the allocation pointer
+        const allocatorName = this.context.compilationContext.compilerOptions.warmHeap ? "speedyJsScratchAlloc" : "malloc";
+        const malloc = this.context.module.getOrInsertFunction(allocatorName, mallocFunctionType);
         const size = sizeof(objectType, this.context);
 
         const result = this.context.builder.createCall(malloc, [size], "thisVoid*");
@@ -114,32 +295,20 @@ class ConstructorFunctionBuilder {
         return new AddressLValue(ptr, this.classReference.type);
     }
 
-    private initializeFields(objectAddress: Address) {
-        const fields = this.classReference.type.getApparentProperties().filter(property => property.flags & ts.SymbolFlags.Property);
-
-        for (const field of fields) {
-            const declaration = field.valueDeclaration as ts.PropertyDeclaration;
-
-            let value: llvm.Value;
-            if (declaration.initializer) {
-                value = this.context.generateValue(declaration.initializer).generateIR(this.context);
-            } else if (this.context.compilationContext.compilerOptions.unsafe) {
-                continue;
-            } else {
-                const fieldType = this.context.typeChecker.getTypeAtLocation(declaration);
-                value = llvm.Constant.getNullValue(this.context.toLLVMType(fieldType, TypePlace.FIELD));
-            }
-
-            const fieldOffset = llvm.ConstantInt.get(this.context.llvmContext, this.classReference.getFieldOffset(field));
-            const gepFieldIndex = [ llvm.ConstantInt.get(this.context.llvmContext, 0), fieldOffset];
-            const fieldPointer = this.context.builder.createInBoundsGEP(objectAddress.get(this.context), gepFieldIndex, `&${field.name}`);
-            this.context.builder.createStore(value, fieldPointer, false);
-        }
+    /**
+     * Allocates a value object in the stack frame of the constructor, the constructor returns the initialized object by value
+     */
+    private allocateObjectOnStack() {
+        const objectType = this.classReference.getLLVMType(this.classReference.type, this.context);
+        const ptr = this.context.builder.createAlloca(objectType, undefined, "this");
+        ptr.alignment = Allocation.getPreferredValueAlignment(objectType, this.context);
+        return new AddressLValue(ptr, this.classReference.type);
     }
 
     private callUserConstructorFn(fn: llvm.Function, objectReference: ObjectReference) {
         if (!this.resolvedFunction.definition) {
-            this.context.builder.createRet(objectReference.generateIR(this.context));
+            const object = objectReference.generateIR(this.context);
+            this.context.builder.createRet(toValueObjectStruct(object, this.classReference.type, this.context));
             return;
         }
 
@@ -2,13 +2,14 @@ import * as assert from "assert";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {getSpeedyJSDirective} from "../../util/speedyjs-function";
 import {CodeGenerationContext} from "../code-generation-context";
 import {DefaultNameMangler} from "../default-name-mangler";
 import {Parameter} from "../name-mangler";
 import {FunctionDefinitionBuilder} from "../util/function-definition-builder";
 import {FunctionFactory, FunctionProperties} from "./function-factory";
 import {ObjectReference} from "./object-reference";
-import {ResolvedFunction} from "./resolved-function";
+import {getTypeArgumentsOfDefinition, ResolvedFunction} from "./resolved-function";
 
 export function verifyIsSupportedSpeedyJSFunction(declaration: ts.Declaration, context: CodeGenerationContext) {
     // tslint:disable-next-line: max-line-length
@@ -18,10 +19,6 @@ export function verifyIsSupportedSpeedyJSFunction(declaration: ts.Declaration, c
 
     const functionDeclaration = declaration as ts.FunctionDeclaration | ts.MethodDeclaration | ts.ConstructorDeclaration;
 
-    if (functionDeclaration.typeParameters && functionDeclaration.typeParameters.length > 0) {
-        throw CodeGenerationDiagnostics.unsupportedGenericFunction(functionDeclaration);
-    }
-
     // tslint:disable-next-line: max-line-length
     if (functionDeclaration.kind === ts.SyntaxKind.FunctionDeclaration && functionDeclaration.parent && functionDeclaration.parent.kind !== ts.SyntaxKind.SourceFile) {
         throw CodeGenerationDiagnostics.unsupportedNestedFunctionDeclaration(functionDeclaration);
@@ -30,6 +27,15 @@ export function verifyIsSupportedSpeedyJSFunction(declaration: ts.Declaration, c
     if (context.typeChecker.isImplementationOfOverload(functionDeclaration)) {
         throw CodeGenerationDiagnostics.unsupportedOverloadedFunctionDeclaration(functionDeclaration);
     }
+
+    const directive = getSpeedyJSDirective(functionDeclaration);
+    if (directive && directive.unsupportedOptions.length > 0) {
+        throw CodeGenerationDiagnostics.unsupportedSpeedyJSDirectiveOption(directive.node, directive.unsupportedOptions[0]);
+    }
+
+    if (directive && directive.inline && directive.optimizationLevel === "0") {
+        throw CodeGenerationDiagnostics.conflictingSpeedyJSDirectiveOptions(directive.node, "inline", "O0");
+    }
 }
 
 /**
@@ -69,10 +75,26 @@ export class SpeedyJSFunctionFactory extends FunctionFactory {
 
         assert(definition.body, "Cannot define a function without a body");
 
+        // e.g. "use speedyjs inline O3"
+        const directive = getSpeedyJSDirective(definition);
+        if (directive) {
+            properties = Object.assign({}, properties, {
+                alwaysInline: properties.alwaysInline || directive.inline,
+                optimizationLevel: directive.optimizationLevel
+            });
+        }
+
         const fn = super.createFunction(mangledName, resolvedFunction, numberOfArguments, context, properties, objectReference);
 
+        if (directive && directive.fastMath) {
+            context.addFastMathFunction(fn.name);
+        }
+
+        // Generic functions are instantiated for each type argument tuple, the type parameters are substituted in the body
         const childContext = context.createChildContext();
-        FunctionDefinitionBuilder.create(fn, resolvedFunction, childContext).define();
+        context.typeChecker.withTypeArguments(getTypeArgumentsOfDefinition(resolvedFunction), () => {
+            FunctionDefinitionBuilder.create(fn, resolvedFunction, childContext).define();
+        });
 
         return fn;
     }
@@ -11,10 +11,18 @@ import {ObjectReference} from "./object-reference";
 import {SpeedyJSClassReference} from "./speedy-js-class-reference";
 import {UnresolvedMethodReference} from "./unresolved-method-reference";
 import {Value} from "./value";
+import {VirtualMethodReference} from "./virtual-method-reference";
 
 export class SpeedyJSObjectReference implements ObjectReference {
 
-    constructor(private address: Address, public type: ts.ObjectType, public clazz: SpeedyJSClassReference) {
+    /**
+     * Creates a new reference
+     * @param address the address of the object
+     * @param type the static type of the object
+     * @param clazz the class reference of the static type
+     * @param exactType indicator if the object is known to be exactly of the static type and not of a subclass (e.g. super)
+     */
+    constructor(private address: Address, public type: ts.ObjectType, public clazz: SpeedyJSClassReference, private exactType = false) {
     }
 
     getTypeStoreSize(context: CodeGenerationContext) {
@@ -34,9 +42,25 @@ export class SpeedyJSObjectReference implements ObjectReference {
         const apparentType = context.typeChecker.getApparentType(methodType);
         const signatures = context.typeChecker.getSignaturesOfType(apparentType, ts.SignatureKind.Call);
 
+        if (this.clazz.polymorphic) {
+            return VirtualMethodReference.create(this, signatures, context, this.exactType);
+        }
+
         return UnresolvedMethodReference.createMethod(this, signatures, context);
     }
 
+    /**
+     * Reinterprets the object as an instance of the given class without any checks, e.g. to pass this to a method of a base class
+     * @param type the type of the class
+     * @param context the context
+     * @param exactType indicator if the object is exactly of the given type
+     */
+    unsafeCast(type: ts.ObjectType, context: CodeGenerationContext, exactType = false): SpeedyJSObjectReference {
+        const classReference = context.resolveClass(type) as SpeedyJSClassReference;
+        const castedPtr = context.builder.createBitCast(this.generateIR(context), context.toLLVMType(type));
+        return new SpeedyJSObjectReference(new AddressLValue(castedPtr, type), type, classReference, exactType);
+    }
+
     getIndexer(element: ts.ElementAccessExpression, context: CodeGenerationContext): ObjectIndexReference {
         throw CodeGenerationDiagnostics.unsupportedIndexer(element);
     }
@@ -60,6 +84,13 @@ export class SpeedyJSObjectReference implements ObjectReference {
             return this.clazz.objectFor(new AddressLValue(castedPtr, type), this.type, context);
         }
 
+        // upcast to a base class
+        const targetType = isMaybeObjectType(type) ? type.types.find(t => !!(t.flags & ts.TypeFlags.Object))! : type;
+        if (targetType.flags & ts.TypeFlags.Object && targetType.getSymbol() && this.type.getSymbol() &&
+            context.compilationContext.classHierarchy.isSubclassOf(this.type.getSymbol(), targetType.getSymbol())) {
+            return this.unsafeCast(targetType as ts.ObjectType, context);
+        }
+
         if (type.flags & ts.TypeFlags.TypeParameter) {
             const typeParameter = type as ts.TypeParameter;
 
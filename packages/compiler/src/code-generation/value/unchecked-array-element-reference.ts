@@ -0,0 +1,43 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {CodeGenerationContext} from "../code-generation-context";
+import {Allocation} from "./allocation";
+import {ArrayReference} from "./array-reference";
+import {ObjectIndexReference} from "./object-index-reference";
+import {Value} from "./value";
+
+/**
+ * Reference to an array element (x[i]) that is read and written by the address of the element instead of calling the
+ * accessors of the runtime. The index is not checked against the length of the array, therefore, it is only used
+ * by functions with the "use speedyjs unsafe" directive.
+ */
+export class UncheckedArrayElementReference extends ObjectIndexReference {
+
+    constructor(type: ts.Type, private array: ArrayReference, index: Value) {
+        super(type, array, index, undefined, undefined);
+    }
+
+    generateIR(context: CodeGenerationContext): llvm.Value {
+        const elementPointer = this.getElementPointer(context);
+        const runtimeType = (elementPointer.type as llvm.PointerType).elementType;
+        const element = context.builder.createAlignedLoad(elementPointer, Allocation.getPreferredValueAlignment(runtimeType, context), "[i]");
+        const type = context.toLLVMType(this.type);
+
+        // objects are stored as i8* in the array
+        return runtimeType.isPointerTy() && !runtimeType.equals(type) ? context.builder.createBitCast(element, type) : element;
+    }
+
+    generateAssignmentIR(value: Value, context: CodeGenerationContext): void {
+        const valueToSet = value.generateIR(context);
+        const elementPointer = this.getElementPointer(context);
+        const runtimeType = (elementPointer.type as llvm.PointerType).elementType;
+        const element = runtimeType.isPointerTy() && !runtimeType.equals(valueToSet.type) ? context.builder.createBitCast(valueToSet, runtimeType) : valueToSet;
+
+        context.builder.createAlignedStore(element, elementPointer, Allocation.getPreferredValueAlignment(runtimeType, context));
+    }
+
+    private getElementPointer(context: CodeGenerationContext) {
+        const elements = this.array.getElements(context);
+        return context.builder.createInBoundsGEP(elements, [this.index.generateIR(context)], "&[i]");
+    }
+}
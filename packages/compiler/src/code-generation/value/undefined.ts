@@ -1,7 +1,7 @@
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
-import {isMaybeObjectType} from "../util/types";
+import {isInt64Type, isMaybeObjectType, isUintType} from "../util/types";
 import {ObjectReference} from "./object-reference";
 import {Primitive} from "./primitive";
 import {AssignableValue, Value} from "./value";
@@ -40,10 +40,14 @@ export class Undefined implements Value {
             return Primitive.false(context, type);
         }
 
-        if (type.flags & ts.TypeFlags.IntLike) {
+        if (type.flags & ts.TypeFlags.IntLike || isUintType(type)) {
             return new Primitive(llvm.ConstantInt.get(context.llvmContext, 0), type);
         }
 
+        if (isInt64Type(type)) {
+            return new Primitive(llvm.ConstantInt.get(context.llvmContext, 0, 64), type);
+        }
+
         if (type.flags & ts.TypeFlags.NumberLike) {
             return new Primitive(llvm.ConstantFP.getNaN(llvm.Type.getDoubleTy(context.llvmContext)), type);
         }
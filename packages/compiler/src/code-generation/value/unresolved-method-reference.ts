@@ -2,6 +2,7 @@ import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {CodeGenerationContext} from "../code-generation-context";
 import {RuntimeSystemNameMangler} from "../runtime-system-name-mangler";
+import {CArray} from "./array-reference";
 import {FunctionFactory, FunctionProperties} from "./function-factory";
 import {ObjectReference} from "./object-reference";
 import {ResolvedFunction} from "./resolved-function";
@@ -51,7 +52,10 @@ export class UnresolvedMethodReference extends UnresolvedFunctionReference {
         return this.llvmFunctionFactory.getOrCreateInstanceMethod(this.object, resolvedFunction, numberOfArguments, context, this.properties);
     }
 
-    protected getCallArguments(resolvedFunction: ResolvedFunction, passedArguments: llvm.Value[], callerContext: CodeGenerationContext): llvm.Value[] {
-        return [this.object.generateIR(callerContext), ...super.getCallArguments(resolvedFunction, passedArguments, callerContext)];
+    protected getCallArguments(resolvedFunction: ResolvedFunction,
+                               passedArguments: llvm.Value[],
+                               callerContext: CodeGenerationContext,
+                               spreadArgument?: CArray): llvm.Value[] {
+        return [this.object.generateIR(callerContext), ...super.getCallArguments(resolvedFunction, passedArguments, callerContext, spreadArgument)];
     }
 }
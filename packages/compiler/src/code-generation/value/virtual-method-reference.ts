@@ -0,0 +1,192 @@
+import * as llvm from "llvm-node";
+import * as ts from "typescript";
+import {MethodImplementation} from "../../class-hierarchy-analysis";
+import {CodeGenerationDiagnostics} from "../../code-generation-diagnostic";
+import {CodeGenerationContext} from "../code-generation-context";
+import {TypePlace} from "../util/typescript-to-llvm-type-converter";
+import {CArray} from "./array-reference";
+import {createResolvedFunctionFromSignature, ResolvedFunction} from "./resolved-function";
+import {SpeedyJSClassReference} from "./speedy-js-class-reference";
+import {SpeedyJSFunctionFactory} from "./speedyjs-function-factory";
+import {SpeedyJSObjectReference} from "./speedyjs-object-reference";
+import {Undefined} from "./undefined";
+import {UnresolvedFunctionReference} from "./unresolved-function-reference";
+import {Value} from "./value";
+
+/**
+ * Reference to a method of a class that is part of a class hierarchy.
+ *
+ * The class hierarchy analysis computes the implementations a call can dispatch to. A call with a single possible
+ * implementation is a direct call of this implementation. Otherwise, the type descriptor of the receiver is compared
+ * with the type descriptors of the classes using an implementation and the matching implementation is called directly.
+ */
+export class VirtualMethodReference extends UnresolvedFunctionReference {
+
+    /**
+     * Creates a reference to a method of a polymorphic class
+     * @param receiver the object on which the method is called
+     * @param signatures the signatures of the method
+     * @param context the context
+     * @param exact indicator if the receiver is exactly of its static type (e.g. super.method()), the call is not dispatched in this case
+     */
+    static create(receiver: SpeedyJSObjectReference, signatures: ts.Signature[], context: CodeGenerationContext, exact = false) {
+        return new VirtualMethodReference(receiver, signatures, new SpeedyJSFunctionFactory(context), exact);
+    }
+
+    /**
+     * The object passed as this to the implementation currently called
+     */
+    private target: SpeedyJSObjectReference;
+
+    protected constructor(private receiver: SpeedyJSObjectReference,
+                          signatures: ts.Signature[],
+                          llvmFunctionFactory: SpeedyJSFunctionFactory,
+                          private exact: boolean) {
+        super(signatures, llvmFunctionFactory, receiver.type);
+        this.target = receiver;
+    }
+
+    protected invokeResolvedFunction(resolvedFunction: ResolvedFunction,
+                                     args: llvm.Value[],
+                                     callerContext: CodeGenerationContext,
+                                     spreadArgument?: CArray): Value {
+        const implementations = this.getImplementations(resolvedFunction.functionName!, callerContext);
+
+        // abstract method without any implementation, there is no instance to call the method on
+        if (implementations.length === 0) {
+            return super.invokeResolvedFunction(resolvedFunction, args, callerContext, spreadArgument);
+        }
+
+        const resolvedImplementations = implementations.map(implementation => this.resolveImplementation(implementation, resolvedFunction, callerContext));
+
+        if (resolvedImplementations.length === 1) {
+            return this.invokeImplementation(resolvedImplementations[0], resolvedFunction, args, callerContext, spreadArgument);
+        }
+
+        const typeDescriptor = this.receiver.clazz.loadTypeDescriptorOf(this.receiver.generateIR(callerContext), callerContext);
+        const fn = callerContext.scope.enclosingFunction;
+        const end = llvm.BasicBlock.create(callerContext.llvmContext, "dispatch.end");
+        const returnsValue = !(resolvedFunction.returnType.flags & ts.TypeFlags.Void);
+        const results: Array<{ value: llvm.Value, block: llvm.BasicBlock }> = [];
+
+        for (let i = 0; i < resolvedImplementations.length; ++i) {
+            const implementation = resolvedImplementations[i];
+
+            // The last implementation is used by all remaining classes and, therefore, needs no test
+            if (i < resolvedImplementations.length - 1) {
+                const isInstance = implementation.classes
+                    .map(classSymbol => {
+                        const classType = callerContext.typeChecker.getDeclaredTypeOfSymbol(classSymbol);
+                        const classReference = callerContext.resolveClass(classType) as SpeedyJSClassReference;
+                        return callerContext.builder.createICmpEQ(typeDescriptor, classReference.getTypeDescriptor(callerContext), `is${classSymbol.name}`);
+                    })
+                    .reduce((left, right) => callerContext.builder.createOr(left, right));
+
+                const implementationBlock = llvm.BasicBlock.create(callerContext.llvmContext, `dispatch.${implementation.declaringClass.name}`, fn);
+                const otherwise = llvm.BasicBlock.create(callerContext.llvmContext, "dispatch.else", fn);
+                callerContext.builder.createCondBr(isInstance, implementationBlock, otherwise);
+                callerContext.builder.setInsertionPoint(implementationBlock);
+
+                const value = this.invokeImplementation(implementation, resolvedFunction, args, callerContext, spreadArgument);
+                if (returnsValue) {
+                    results.push({ value: value.generateIR(callerContext), block: callerContext.builder.getInsertBlock() });
+                }
+
+                callerContext.builder.createBr(end);
+                callerContext.builder.setInsertionPoint(otherwise);
+            } else {
+                const value = this.invokeImplementation(implementation, resolvedFunction, args, callerContext, spreadArgument);
+                if (returnsValue) {
+                    results.push({ value: value.generateIR(callerContext), block: callerContext.builder.getInsertBlock() });
+                }
+
+                callerContext.builder.createBr(end);
+            }
+        }
+
+        fn.addBasicBlock(end);
+        callerContext.builder.setInsertionPoint(end);
+
+        if (!returnsValue) {
+            return Undefined.create(callerContext);
+        }
+
+        const returnType = callerContext.toLLVMType(resolvedFunction.returnType, TypePlace.RETURN_VALUE);
+        const phi = callerContext.builder.createPhi(returnType, results.length, resolvedFunction.functionName);
+        for (const result of results) {
+            phi.addIncoming(result.value, result.block);
+        }
+
+        return callerContext.value(phi, resolvedFunction.returnType);
+    }
+
+    protected getLLVMFunction(resolvedFunction: ResolvedFunction, context: CodeGenerationContext, passedArguments?: llvm.Value[]): llvm.Function {
+        const numberOfArguments = passedArguments ? passedArguments.length : resolvedFunction.parameters.length;
+
+        return this.llvmFunctionFactory.getOrCreateInstanceMethod(this.target, resolvedFunction, numberOfArguments, context, this.properties);
+    }
+
+    protected getCallArguments(resolvedFunction: ResolvedFunction,
+                               passedArguments: llvm.Value[],
+                               callerContext: CodeGenerationContext,
+                               spreadArgument?: CArray): llvm.Value[] {
+        return [this.target.generateIR(callerContext), ...super.getCallArguments(resolvedFunction, passedArguments, callerContext, spreadArgument)];
+    }
+
+    private getImplementations(methodName: string, context: CodeGenerationContext): MethodImplementation[] {
+        const classHierarchy = context.compilationContext.classHierarchy;
+
+        if (this.exact) {
+            const implementation = classHierarchy.getMethodImplementation(this.receiver.type.getSymbol(), methodName);
+            return implementation ? [implementation] : [];
+        }
+
+        return classHierarchy.getMethodImplementations(this.receiver.type.getSymbol(), methodName);
+    }
+
+    /**
+     * Resolves the function of the implementation. The implementation is instantiated for the class declaring it
+     * (and not for the static type of the receiver) so that all subclasses share the same function.
+     */
+    private resolveImplementation(implementation: MethodImplementation,
+                                  calledFunction: ResolvedFunction,
+                                  context: CodeGenerationContext): MethodImplementation & { resolvedFunction: ResolvedFunction } {
+        const declaringType = context.typeChecker.getDeclaredTypeOfSymbol(implementation.declaringClass) as ts.ObjectType;
+        const signature = context.typeChecker.getSignatureFromDeclaration(implementation.declaration);
+        const resolvedFunction = createResolvedFunctionFromSignature(signature, context.compilationContext, declaringType);
+
+        const sameParameters = resolvedFunction.parameters.length === calledFunction.parameters.length &&
+            resolvedFunction.parameters.every((parameter, i) => parameter.type === calledFunction.parameters[i].type &&
+                parameter.variadic === calledFunction.parameters[i].variadic);
+
+        if (!sameParameters) {
+            throw CodeGenerationDiagnostics.unsupportedMethodOverride(implementation.declaration);
+        }
+
+        return Object.assign({ resolvedFunction }, implementation);
+    }
+
+    private invokeImplementation(implementation: MethodImplementation & { resolvedFunction: ResolvedFunction },
+                                 calledFunction: ResolvedFunction,
+                                 args: llvm.Value[],
+                                 callerContext: CodeGenerationContext,
+                                 spreadArgument?: CArray): Value {
+        const declaringType = implementation.resolvedFunction.classType!;
+        this.target = this.receiver.unsafeCast(declaringType, callerContext);
+
+        const result = super.invokeResolvedFunction(implementation.resolvedFunction, args, callerContext, spreadArgument);
+        this.target = this.receiver;
+
+        if (calledFunction.returnType.flags & ts.TypeFlags.Void) {
+            return result;
+        }
+
+        // the implementation may return a subtype of the return type of the called method
+        const casted = result.castImplicit(calledFunction.returnType, callerContext);
+        if (!casted) {
+            throw CodeGenerationDiagnostics.unsupportedMethodOverride(implementation.declaration);
+        }
+
+        return casted;
+    }
+}
@@ -1,6 +1,8 @@
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
 import {BuiltInSymbols} from "./built-in-symbols";
+import {ClassHierarchyAnalysis} from "./class-hierarchy-analysis";
+import {ConstantFunctionEvaluator} from "./constant-function-evaluator";
 import {SpeedyJSCompilerOptions} from "./speedyjs-compiler-options";
 import {TypeChecker} from "./type-checker";
 
@@ -15,6 +17,11 @@ export interface CompilationContext {
      */
     readonly builtIns: BuiltInSymbols;
 
+    /**
+     * The class hierarchy of the whole program
+     */
+    readonly classHierarchy: ClassHierarchyAnalysis;
+
     /**
      * The compiler host
      */
@@ -25,6 +32,11 @@ export interface CompilationContext {
      */
     readonly compilerOptions: SpeedyJSCompilerOptions;
 
+    /**
+     * Evaluator for calls to pure functions with constant arguments
+     */
+    readonly constantFunctionEvaluator: ConstantFunctionEvaluator;
+
     /**
      * The llvm context for this compilation
      */
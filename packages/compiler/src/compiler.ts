@@ -1,12 +1,14 @@
 import * as debug from "debug";
 import * as llvm from "llvm-node";
 import * as ts from "typescript";
-import {BuiltInSymbols} from "./built-in-symbols";
+import {BuiltInSymbols, SPEEDYJS_LIB_FILE} from "./built-in-symbols";
+import {ClassHierarchyAnalysis} from "./class-hierarchy-analysis";
 import {CodeGenerationDiagnostics, isCodeGenerationDiagnostic} from "./code-generation-diagnostic";
 import {DefaultCodeGenerationContextFactory} from "./code-generation/default-code-generation-context-factory";
 import {NotYetImplementedCodeGenerator} from "./code-generation/not-yet-implemented-code-generator";
 import {PerFileCodeGenerator} from "./code-generation/per-file/per-file-code-generator";
 import {CompilationContext} from "./compilation-context";
+import {ConstantFunctionEvaluator} from "./constant-function-evaluator";
 import {SpeedyJSCompilerOptions} from "./speedyjs-compiler-options";
 import {LogUnknownTransformVisitor} from "./transform/log-unknown-transform-visitor";
 import {SpeedyJSTransformVisitor} from "./transform/speedyjs-transform-visitor";
@@ -37,7 +39,7 @@ export class Compiler {
     compile(rootFileNames: string[]): { exitStatus: ts.ExitStatus, diagnostics: ts.Diagnostic[] } {
         LOG("Start Compiling");
         Compiler.initLLVM();
-        const program: ts.Program = ts.createProgram(rootFileNames, this.compilerOptions, this.compilerHost);
+        const program: ts.Program = ts.createProgram([...rootFileNames, SPEEDYJS_LIB_FILE], this.compilerOptions, this.compilerHost);
         const diagnostics = [
             ...program.getSyntacticDiagnostics(),
             ...program.getOptionsDiagnostics(),
@@ -51,12 +53,15 @@ export class Compiler {
 
         const context = new llvm.LLVMContext();
         const builtIns = BuiltInSymbols.create(program, this.compilerHost);
+        const typeChecker = new TypeScriptTypeChecker(program.getTypeChecker());
         const compilationContext: CompilationContext = {
             builtIns,
+            classHierarchy: new ClassHierarchyAnalysis(program, typeChecker),
             compilerHost: this.compilerHost,
             compilerOptions: this.compilerOptions,
+            constantFunctionEvaluator: new ConstantFunctionEvaluator(typeChecker, builtIns),
             llvmContext: context,
-            typeChecker: new TypeScriptTypeChecker(program.getTypeChecker()),
+            typeChecker,
             rootDir: (program as any).getCommonSourceDirectory()
         };
 
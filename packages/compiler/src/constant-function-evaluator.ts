@@ -0,0 +1,634 @@
+import * as ts from "typescript";
+import {BuiltInSymbols} from "./built-in-symbols";
+import {isInt64Type, isUintType} from "./code-generation/util/types";
+import {TypeChecker} from "./type-checker";
+import {isSpeedyJSFunction} from "./util/speedyjs-function";
+
+/**
+ * Upper bound of the evaluated expressions and statements per call. Calls exceeding this limit are not evaluated at compile time
+ * to keep the compile time reasonable, e.g. for a recursive fib with a large argument.
+ */
+const MAX_EVALUATION_STEPS = 100000;
+
+/**
+ * Maximum depth of nested calls evaluated at compile time
+ */
+const MAX_CALL_DEPTH = 100;
+
+/**
+ * Math functions that are evaluated at compile time. Only functions that are exactly rounded are included, so that the
+ * result does not depend on the math library used by the runtime.
+ */
+const CONSTANT_MATH_FUNCTIONS: { [name: string]: (...args: number[]) => number } = {
+    abs: Math.abs,
+    ceil: Math.ceil,
+    clz32: Math.clz32,
+    floor: Math.floor,
+    fround: Math.fround,
+    imul: Math.imul,
+    max: Math.max,
+    min: Math.min,
+    sign: Math.sign,
+    sqrt: Math.sqrt,
+    trunc: Math.trunc
+};
+
+const CONSTANT_MATH_PROPERTIES: { [name: string]: number } = {
+    E: Math.E,
+    LN10: Math.LN10,
+    LN2: Math.LN2,
+    LOG10E: Math.LOG10E,
+    LOG2E: Math.LOG2E,
+    PI: Math.PI,
+    SQRT1_2: Math.SQRT1_2,
+    SQRT2: Math.SQRT2
+};
+
+export type ConstantValue = number | boolean;
+
+/**
+ * Thrown if an expression or statement cannot be evaluated at compile time
+ */
+class NotConstantError {
+    /**
+     * @param unsupportedSyntax true if the evaluation failed because the syntax is not supported by the evaluator
+     */
+    constructor(public unsupportedSyntax = false) {}
+}
+
+type Completion = { kind: "normal" } | { kind: "return", value: ConstantValue } | { kind: "break" } | { kind: "continue" };
+
+const NORMAL_COMPLETION: Completion = { kind: "normal" };
+
+/**
+ * Evaluates calls to pure speedy.js functions with constant arguments at compile time, e.g. solarMass() in
+ * this.vx = -px / solarMass() is replaced by the constant 39.47841760435743.
+ *
+ * The evaluator interprets the typescript AST of the called function. A function is pure if the executed statements
+ * and expressions are restricted to local variables, parameters, arithmetic, comparisons, control flow statements,
+ * calls to other pure functions and the exactly rounded functions and constants of the Math object. The evaluation of a call
+ * is aborted whenever the interpreter reaches code that might have side effects (objects, arrays, non speedy.js functions) or
+ * that might have a different result at runtime, in which case the call is generated as usual.
+ * The interpreter mirrors the semantics of the generated code, e.g. int arithmetic wraps around.
+ */
+export class ConstantFunctionEvaluator {
+    private unsupportedFunctions = new Set<ts.FunctionDeclaration>();
+    private evaluatedCalls = new Map<string, ConstantValue | undefined>();
+    private remainingSteps = 0;
+    private callDepth = 0;
+
+    constructor(private typeChecker: TypeChecker, private builtIns: BuiltInSymbols) {}
+
+    /**
+     * Evaluates the given call expression at compile time
+     * @param callExpression the call expression
+     * @return the result of the call or undefined if the call cannot be evaluated at compile time
+     */
+    evaluateCall(callExpression: ts.CallExpression): ConstantValue | undefined {
+        const declaration = this.getCalledFunction(callExpression);
+
+        if (!declaration || this.unsupportedFunctions.has(declaration)) {
+            return undefined;
+        }
+
+        this.remainingSteps = MAX_EVALUATION_STEPS;
+        this.callDepth = 0;
+
+        try {
+            const args = callExpression.arguments.map(argument => this.evaluateExpression(argument, new Map()));
+            const key = `${declaration.getSourceFile().fileName}:${declaration.pos}(${args.map(toKey).join(",")})`;
+
+            if (!this.evaluatedCalls.has(key)) {
+                this.evaluatedCalls.set(key, this.tryInvoke(declaration, callExpression, args));
+            }
+
+            return this.evaluatedCalls.get(key);
+        } catch (e) {
+            if (e instanceof NotConstantError) {
+                return undefined;
+            }
+
+            throw e;
+        }
+    }
+
+    private tryInvoke(declaration: ts.FunctionDeclaration, callExpression: ts.CallExpression, args: ConstantValue[]) {
+        try {
+            return this.invoke(declaration, callExpression, args);
+        } catch (e) {
+            if (e instanceof NotConstantError) {
+                // remember functions using unsupported syntax to avoid interpreting them for each call site again
+                if (e.unsupportedSyntax) {
+                    this.unsupportedFunctions.add(declaration);
+                }
+                return undefined;
+            }
+
+            throw e;
+        }
+    }
+
+    private getCalledFunction(callExpression: ts.CallExpression): ts.FunctionDeclaration | undefined {
+        if (callExpression.expression.kind !== ts.SyntaxKind.Identifier) {
+            return undefined;
+        }
+
+        let symbol = this.typeChecker.getSymbolAtLocation(callExpression.expression);
+        if (symbol && symbol.flags & ts.SymbolFlags.Alias) {
+            symbol = this.typeChecker.getAliasedSymbol(symbol);
+        }
+
+        if (!symbol || !symbol.declarations || symbol.declarations.length !== 1 || symbol.declarations[0].kind !== ts.SyntaxKind.FunctionDeclaration) {
+            return undefined;
+        }
+
+        const declaration = symbol.declarations[0] as ts.FunctionDeclaration;
+        const isAsync = !!declaration.modifiers && declaration.modifiers.some(modifier => modifier.kind === ts.SyntaxKind.AsyncKeyword);
+
+        if (isAsync || declaration.typeParameters || !isSpeedyJSFunction(declaration)) {
+            return undefined;
+        }
+
+        const hasSimpleParameters = declaration.parameters.every(parameter =>
+            parameter.name.kind === ts.SyntaxKind.Identifier && !parameter.questionToken && !parameter.initializer && !parameter.dotDotDotToken
+        );
+
+        return hasSimpleParameters && declaration.parameters.length === callExpression.arguments.length ? declaration : undefined;
+    }
+
+    private invoke(declaration: ts.FunctionDeclaration, callExpression: ts.CallExpression, args: ConstantValue[]): ConstantValue {
+        if (++this.callDepth > MAX_CALL_DEPTH) {
+            throw new NotConstantError();
+        }
+
+        const variables = new Map<ts.Symbol, ConstantValue>();
+        declaration.parameters.forEach((parameter, i) => {
+            this.assertSupportedType(this.typeChecker.getTypeAtLocation(parameter));
+            variables.set(this.typeChecker.getSymbolAtLocation(parameter.name), args[i]);
+        });
+
+        const completion = this.evaluateStatement(declaration.body!, variables);
+
+        if (completion.kind !== "return") {
+            throw new NotConstantError(true);
+        }
+
+        --this.callDepth;
+        return this.toType(completion.value, this.typeChecker.getTypeAtLocation(callExpression));
+    }
+
+    private evaluateStatement(statement: ts.Statement, variables: Map<ts.Symbol, ConstantValue>): Completion {
+        this.step();
+
+        switch (statement.kind) {
+            case ts.SyntaxKind.Block:
+                for (const child of (statement as ts.Block).statements) {
+                    const completion = this.evaluateStatement(child, variables);
+                    if (completion.kind !== "normal") {
+                        return completion;
+                    }
+                }
+                return NORMAL_COMPLETION;
+
+            case ts.SyntaxKind.ExpressionStatement: {
+                const expression = (statement as ts.ExpressionStatement).expression;
+
+                // prologue directive, e.g. "use speedyjs"
+                if (expression.kind !== ts.SyntaxKind.StringLiteral) {
+                    this.evaluateExpression(expression, variables);
+                }
+
+                return NORMAL_COMPLETION;
+            }
+
+            case ts.SyntaxKind.VariableStatement:
+                this.declareVariables((statement as ts.VariableStatement).declarationList, variables);
+                return NORMAL_COMPLETION;
+
+            case ts.SyntaxKind.ReturnStatement: {
+                const returnStatement = statement as ts.ReturnStatement;
+                if (!returnStatement.expression) {
+                    throw new NotConstantError(true);
+                }
+
+                return { kind: "return", value: this.evaluateExpression(returnStatement.expression, variables) };
+            }
+
+            case ts.SyntaxKind.IfStatement: {
+                const ifStatement = statement as ts.IfStatement;
+
+                if (this.evaluateCondition(ifStatement.expression, variables)) {
+                    return this.evaluateStatement(ifStatement.thenStatement, variables);
+                } else if (ifStatement.elseStatement) {
+                    return this.evaluateStatement(ifStatement.elseStatement, variables);
+                }
+
+                return NORMAL_COMPLETION;
+            }
+
+            case ts.SyntaxKind.WhileStatement: {
+                const whileStatement = statement as ts.WhileStatement;
+                return this.evaluateLoop(whileStatement.expression, undefined, whileStatement.statement, variables);
+            }
+
+            case ts.SyntaxKind.ForStatement: {
+                const forStatement = statement as ts.ForStatement;
+
+                if (forStatement.initializer) {
+                    if (forStatement.initializer.kind === ts.SyntaxKind.VariableDeclarationList) {
+                        this.declareVariables(forStatement.initializer as ts.VariableDeclarationList, variables);
+                    } else {
+                        this.evaluateExpression(forStatement.initializer as ts.Expression, variables);
+                    }
+                }
+
+                return this.evaluateLoop(forStatement.condition, forStatement.incrementor, forStatement.statement, variables);
+            }
+
+            case ts.SyntaxKind.BreakStatement:
+            case ts.SyntaxKind.ContinueStatement:
+                if ((statement as ts.BreakOrContinueStatement).label) {
+                    throw new NotConstantError(true);
+                }
+
+                return statement.kind === ts.SyntaxKind.BreakStatement ? { kind: "break" } : { kind: "continue" };
+
+            default:
+                throw new NotConstantError(true);
+        }
+    }
+
+    private evaluateLoop(condition: ts.Expression | undefined,
+                         incrementor: ts.Expression | undefined,
+                         body: ts.Statement,
+                         variables: Map<ts.Symbol, ConstantValue>): Completion {
+        while (!condition || this.evaluateCondition(condition, variables)) {
+            const completion = this.evaluateStatement(body, variables);
+
+            if (completion.kind === "return") {
+                return completion;
+            } else if (completion.kind === "break") {
+                break;
+            }
+
+            if (incrementor) {
+                this.evaluateExpression(incrementor, variables);
+            }
+        }
+
+        return NORMAL_COMPLETION;
+    }
+
+    private declareVariables(declarationList: ts.VariableDeclarationList, variables: Map<ts.Symbol, ConstantValue>) {
+        for (const declaration of declarationList.declarations) {
+            if (declaration.name.kind !== ts.SyntaxKind.Identifier || !declaration.initializer) {
+                throw new NotConstantError(true);
+            }
+
+            this.assertSupportedType(this.typeChecker.getTypeAtLocation(declaration));
+            const value = this.evaluateExpression(declaration.initializer, variables);
+            variables.set(this.typeChecker.getSymbolAtLocation(declaration.name), value);
+        }
+    }
+
+    private evaluateCondition(condition: ts.Expression, variables: Map<ts.Symbol, ConstantValue>) {
+        return !!this.evaluateExpression(condition, variables);
+    }
+
+    private evaluateExpression(expression: ts.Expression, variables: Map<ts.Symbol, ConstantValue>): ConstantValue {
+        this.step();
+        this.assertSupportedType(this.typeChecker.getTypeAtLocation(expression));
+
+        switch (expression.kind) {
+            case ts.SyntaxKind.NumericLiteral:
+                return +(expression as ts.NumericLiteral).text;
+
+            case ts.SyntaxKind.TrueKeyword:
+                return true;
+
+            case ts.SyntaxKind.FalseKeyword:
+                return false;
+
+            case ts.SyntaxKind.ParenthesizedExpression:
+                return this.evaluateExpression((expression as ts.ParenthesizedExpression).expression, variables);
+
+            case ts.SyntaxKind.Identifier: {
+                const value = variables.get(this.typeChecker.getSymbolAtLocation(expression));
+
+                if (typeof(value) === "undefined") {
+                    throw new NotConstantError();
+                }
+
+                return value;
+            }
+
+            case ts.SyntaxKind.PropertyAccessExpression: {
+                const propertyAccess = expression as ts.PropertyAccessExpression;
+                const name = propertyAccess.name.text;
+
+                if (this.isMathObject(propertyAccess.expression) && CONSTANT_MATH_PROPERTIES.hasOwnProperty(name)) {
+                    return CONSTANT_MATH_PROPERTIES[name];
+                }
+
+                throw new NotConstantError(true);
+            }
+
+            case ts.SyntaxKind.AsExpression:
+                return this.toType(
+                    this.evaluateExpression((expression as ts.AsExpression).expression, variables),
+                    this.typeChecker.getTypeAtLocation(expression),
+                    true
+                );
+
+            case ts.SyntaxKind.ConditionalExpression: {
+                const conditional = expression as ts.ConditionalExpression;
+                const branch = this.evaluateCondition(conditional.condition, variables) ? conditional.whenTrue : conditional.whenFalse;
+
+                return this.evaluateExpression(branch, variables);
+            }
+
+            case ts.SyntaxKind.PrefixUnaryExpression:
+                return this.evaluatePrefixUnaryExpression(expression as ts.PrefixUnaryExpression, variables);
+
+            case ts.SyntaxKind.PostfixUnaryExpression: {
+                const postfix = expression as ts.PostfixUnaryExpression;
+                const before = this.evaluateExpression(postfix.operand, variables);
+                const delta = postfix.operator === ts.SyntaxKind.PlusPlusToken ? 1 : -1;
+
+                this.assign(postfix.operand, this.add(before, delta, this.typeChecker.getTypeAtLocation(postfix.operand)), variables);
+                return before;
+            }
+
+            case ts.SyntaxKind.BinaryExpression:
+                return this.evaluateBinaryExpression(expression as ts.BinaryExpression, variables);
+
+            case ts.SyntaxKind.CallExpression:
+                return this.evaluateCallExpression(expression as ts.CallExpression, variables);
+
+            default:
+                throw new NotConstantError(true);
+        }
+    }
+
+    private evaluatePrefixUnaryExpression(expression: ts.PrefixUnaryExpression, variables: Map<ts.Symbol, ConstantValue>): ConstantValue {
+        const operand = this.evaluateExpression(expression.operand, variables);
+        const operandType = this.typeChecker.getTypeAtLocation(expression.operand);
+        const resultType = this.typeChecker.getTypeAtLocation(expression);
+
+        switch (expression.operator) {
+            case ts.SyntaxKind.ExclamationToken:
+                return !operand;
+            case ts.SyntaxKind.MinusToken:
+                return this.toType(-operand, operandType);
+            case ts.SyntaxKind.PlusToken:
+                return this.toType(+operand, resultType);
+            case ts.SyntaxKind.TildeToken:
+                return ~operand;
+            case ts.SyntaxKind.PlusPlusToken:
+            case ts.SyntaxKind.MinusMinusToken: {
+                const updated = this.add(operand, expression.operator === ts.SyntaxKind.PlusPlusToken ? 1 : -1, operandType);
+                this.assign(expression.operand, updated, variables);
+                return updated;
+            }
+            default:
+                throw new NotConstantError(true);
+        }
+    }
+
+    private evaluateBinaryExpression(expression: ts.BinaryExpression, variables: Map<ts.Symbol, ConstantValue>): ConstantValue {
+        const operator = expression.operatorToken.kind;
+
+        if (operator === ts.SyntaxKind.AmpersandAmpersandToken || operator === ts.SyntaxKind.BarBarToken) {
+            if (!(this.typeChecker.getTypeAtLocation(expression).flags & ts.TypeFlags.BooleanLike)) {
+                throw new NotConstantError(true);
+            }
+
+            const left = this.evaluateCondition(expression.left, variables);
+            return operator === ts.SyntaxKind.AmpersandAmpersandToken
+                ? left && this.evaluateCondition(expression.right, variables)
+                : left || this.evaluateCondition(expression.right, variables);
+        }
+
+        if (operator === ts.SyntaxKind.EqualsToken) {
+            const value = this.evaluateExpression(expression.right, variables);
+            this.assign(expression.left, value, variables);
+            return value;
+        }
+
+        const compoundOperator = toBinaryOperator(operator);
+        const left = this.evaluateExpression(expression.left, variables);
+        const right = this.evaluateExpression(expression.right, variables);
+        const result = this.applyBinaryOperator(compoundOperator || operator, left, right, expression);
+
+        if (compoundOperator) {
+            this.assign(expression.left, result, variables);
+        }
+
+        return result;
+    }
+
+    private applyBinaryOperator(operator: ts.SyntaxKind, left: ConstantValue, right: ConstantValue, expression: ts.BinaryExpression): ConstantValue {
+        const leftType = this.typeChecker.getTypeAtLocation(expression.left);
+        const rightType = this.typeChecker.getTypeAtLocation(expression.right);
+        const resultType = this.typeChecker.getTypeAtLocation(expression);
+        const numericOperands = typeof(left) === "number" && typeof(right) === "number";
+        // the same rule as used by the binary expression code generator: int operations only if the operands and result are ints
+        const intOperation = !!(leftType.flags & rightType.flags & resultType.flags & ts.TypeFlags.IntLike);
+        const l = left as number;
+        const r = right as number;
+
+        switch (operator) {
+            case ts.SyntaxKind.PlusToken:
+                return numericOperands ? (intOperation ? (l + r) | 0 : l + r) : this.notConstant();
+            case ts.SyntaxKind.MinusToken:
+                return numericOperands ? (intOperation ? (l - r) | 0 : l - r) : this.notConstant();
+            case ts.SyntaxKind.AsteriskToken:
+                return numericOperands ? (intOperation ? Math.imul(l, r) : l * r) : this.notConstant();
+            case ts.SyntaxKind.SlashToken:
+            case ts.SyntaxKind.PercentToken:
+                if (!numericOperands) {
+                    return this.notConstant();
+                }
+
+                if (intOperation) {
+                    // the division by zero and the overflow of the int division trap at runtime
+                    if (r === 0 || (l === -2147483648 && r === -1)) {
+                        return this.notConstant();
+                    }
+
+                    return (operator === ts.SyntaxKind.SlashToken ? l / r : l % r) | 0;
+                }
+
+                return operator === ts.SyntaxKind.SlashToken ? l / r : l % r;
+
+            case ts.SyntaxKind.AmpersandToken:
+                return l & r;
+            case ts.SyntaxKind.BarToken:
+                return l | r;
+            case ts.SyntaxKind.CaretToken:
+                return l ^ r;
+            case ts.SyntaxKind.LessThanLessThanToken:
+                return l << r;
+            case ts.SyntaxKind.GreaterThanGreaterThanToken:
+                return l >> r;
+            case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken:
+                return this.toType(l >>> r, resultType);
+
+            case ts.SyntaxKind.LessThanToken:
+                return left < right;
+            case ts.SyntaxKind.LessThanEqualsToken:
+                return left <= right;
+            case ts.SyntaxKind.GreaterThanToken:
+                return left > right;
+            case ts.SyntaxKind.GreaterThanEqualsToken:
+                return left >= right;
+            case ts.SyntaxKind.EqualsEqualsToken:
+            case ts.SyntaxKind.EqualsEqualsEqualsToken:
+                return left === right;
+            case ts.SyntaxKind.ExclamationEqualsToken:
+            case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+                return left !== right;
+
+            default:
+                // ** is computed by squaring or the runtime's pow function and might be off by an ulp compared to Math.pow
+                return this.notConstant(true);
+        }
+    }
+
+    private evaluateCallExpression(callExpression: ts.CallExpression, variables: Map<ts.Symbol, ConstantValue>): ConstantValue {
+        const callee = callExpression.expression;
+        const args = callExpression.arguments.map(argument => {
+            if (argument.kind === ts.SyntaxKind.SpreadElement) {
+                throw new NotConstantError(true);
+            }
+
+            return this.evaluateExpression(argument, variables);
+        });
+
+        if (callee.kind === ts.SyntaxKind.PropertyAccessExpression) {
+            const propertyAccess = callee as ts.PropertyAccessExpression;
+            const name = propertyAccess.name.text;
+
+            if (this.isMathObject(propertyAccess.expression) && CONSTANT_MATH_FUNCTIONS.hasOwnProperty(name)) {
+                const result = CONSTANT_MATH_FUNCTIONS[name].apply(Math, args);
+                return this.toType(result, this.typeChecker.getTypeAtLocation(callExpression));
+            }
+
+            throw new NotConstantError(true);
+        }
+
+        const declaration = this.getCalledFunction(callExpression);
+        if (!declaration || this.unsupportedFunctions.has(declaration)) {
+            throw new NotConstantError(true);
+        }
+
+        return this.invoke(declaration, callExpression, args);
+    }
+
+    private assign(target: ts.Expression, value: ConstantValue, variables: Map<ts.Symbol, ConstantValue>) {
+        if (target.kind !== ts.SyntaxKind.Identifier) {
+            throw new NotConstantError(true);
+        }
+
+        const symbol = this.typeChecker.getSymbolAtLocation(target);
+
+        // assignment to a variable declared outside of the evaluated functions
+        if (!variables.has(symbol)) {
+            throw new NotConstantError(true);
+        }
+
+        variables.set(symbol, value);
+    }
+
+    private add(value: ConstantValue, delta: number, type: ts.Type): number {
+        if (typeof(value) !== "number") {
+            return this.notConstant(true);
+        }
+
+        return type.flags & ts.TypeFlags.IntLike ? (value + delta) | 0 : value + delta;
+    }
+
+    /**
+     * Converts the value to the given type using the same semantics as the generated code
+     * @param value the value to convert
+     * @param type the target type
+     * @param explicit true if the value is converted explicitly using an as expression
+     */
+    private toType(value: ConstantValue, type: ts.Type, explicit = false): ConstantValue {
+        if (type.flags & ts.TypeFlags.BooleanLike) {
+            return explicit ? !!value : (typeof(value) === "boolean" ? value : this.notConstant());
+        }
+
+        if (type.flags & ts.TypeFlags.IntLike) {
+            // implicit conversions from number to int do not exist. Wrap around like the generated int arithmetic
+            return explicit || typeof(value) === "number" ? (+value) | 0 : this.notConstant();
+        }
+
+        if (type.flags & ts.TypeFlags.NumberLike) {
+            return typeof(value) === "number" || explicit ? +value : this.notConstant();
+        }
+
+        return this.notConstant(true);
+    }
+
+    /**
+     * The values are represented as JS numbers. Types whose arithmetic cannot be expressed with number operations are not evaluated,
+     * e.g. int64 values exceed the exactly representable integers and wrap around at 64 bits, uint values are compared and
+     * shifted unsigned and converting an int argument to a uint parameter reinterprets its bits
+     */
+    private assertSupportedType(type: ts.Type) {
+        if (isInt64Type(type) || isUintType(type)) {
+            this.notConstant(true);
+        }
+    }
+
+    private isMathObject(expression: ts.Expression) {
+        return expression.kind === ts.SyntaxKind.Identifier && this.typeChecker.getSymbolAtLocation(expression) === this.builtIns.get("Math");
+    }
+
+    private step() {
+        if (--this.remainingSteps < 0) {
+            throw new NotConstantError();
+        }
+    }
+
+    private notConstant(unsupportedSyntax = false): never {
+        throw new NotConstantError(unsupportedSyntax);
+    }
+}
+
+function toKey(value: ConstantValue) {
+    return Object.is(value, -0) ? "-0" : String(value);
+}
+
+/**
+ * Returns the binary operator of a compound assignment, e.g. + for +=
+ */
+function toBinaryOperator(operator: ts.SyntaxKind): ts.SyntaxKind | undefined {
+    switch (operator) {
+        case ts.SyntaxKind.PlusEqualsToken:
+            return ts.SyntaxKind.PlusToken;
+        case ts.SyntaxKind.MinusEqualsToken:
+            return ts.SyntaxKind.MinusToken;
+        case ts.SyntaxKind.AsteriskEqualsToken:
+            return ts.SyntaxKind.AsteriskToken;
+        case ts.SyntaxKind.SlashEqualsToken:
+            return ts.SyntaxKind.SlashToken;
+        case ts.SyntaxKind.PercentEqualsToken:
+            return ts.SyntaxKind.PercentToken;
+        case ts.SyntaxKind.AmpersandEqualsToken:
+            return ts.SyntaxKind.AmpersandToken;
+        case ts.SyntaxKind.BarEqualsToken:
+            return ts.SyntaxKind.BarToken;
+        case ts.SyntaxKind.CaretEqualsToken:
+            return ts.SyntaxKind.CaretToken;
+        case ts.SyntaxKind.LessThanLessThanEqualsToken:
+            return ts.SyntaxKind.LessThanLessThanToken;
+        case ts.SyntaxKind.GreaterThanGreaterThanEqualsToken:
+            return ts.SyntaxKind.GreaterThanGreaterThanToken;
+        case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanEqualsToken:
+            return ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken;
+        default:
+            return undefined;
+    }
+}
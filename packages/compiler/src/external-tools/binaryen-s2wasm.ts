@@ -13,7 +13,9 @@ const EXECUTABLE_NAME = "s2wasm";
  * @return the path to the .wast file. The caller is responsible for either deleting the working directory or the returned
  * file.
  */
-export function s2wasm(sFile: string, wastFile: string, { globalBase, initialMemory }: { globalBase: number, initialMemory: number}): string {
+export function s2wasm(sFile: string,
+                       wastFile: string,
+                       { globalBase, initialMemory, maximumMemory }: { globalBase: number, initialMemory: number, maximumMemory: number }): string {
     LOG(`Compile ${sFile} to wast file`);
 
     const args = [
@@ -22,6 +24,7 @@ export function s2wasm(sFile: string, wastFile: string, { globalBase, initialMem
         `--global-base=${globalBase}`,
         `--initial-memory=${initialMemory}`,
         "--allow-memory-growth",
+        ...(maximumMemory ? [`--max-memory=${maximumMemory}`] : []),
         "-o", wastFile,
         "-l", COMPILER_RT_FILE,
         "-l", LIBC_RT_FILE
@@ -0,0 +1,18 @@
+import * as debug from "debug";
+import {execLLVM} from "./tools";
+
+const LOG = debug("external-tools/llvm-as");
+const EXECUTABLE_NAME = "llvm-as";
+
+/**
+ * Assembles the given textual llvm IR file to a bitcode file
+ * @param llFileName the ll file to assemble
+ * @param bcFileName the file name of the generated bitcode file
+ * @returns the name of the bitcode file
+ */
+export function llvmAs(llFileName: string, bcFileName: string): string {
+    LOG(`Assemble ${llFileName} to bitcode ${bcFileName}`);
+
+    LOG(execLLVM(EXECUTABLE_NAME, [llFileName, "-o", bcFileName]));
+    return bcFileName;
+}
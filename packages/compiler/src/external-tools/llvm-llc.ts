@@ -1,6 +1,6 @@
 import * as debug from "debug";
 
-import {execLLVM} from "./tools";
+import {execLLVM, FAST_MATH_OPTIONS} from "./tools";
 
 const LOG = debug("external-tools/llvm-llc");
 const EXECUTABLE_NAME = "llc";
@@ -11,13 +11,14 @@ const DEFAULT_OPTIONS = ["-march=wasm32",  "-filetype=asm", "-asm-verbose=false"
  * Generates the static assembly using llc
  * @param input the input file name (absolute)
  * @param sFileName the name of the resulting s file
+ * @param fastMath indicator if the floating point operations may be lowered without preserving the strict IEEE semantics
  * @returns the name of the generated assembly file. The caller is responsible for deleting either the working directory
  * or the assembly file
  */
-export function llc(input: string, sFileName: string): string {
+export function llc(input: string, sFileName: string, fastMath = false): string {
     LOG(`Execute LLC for file ${input}`);
 
-    LOG(execLLVM(EXECUTABLE_NAME, DEFAULT_OPTIONS.concat([input, "-o", sFileName])));
+    LOG(execLLVM(EXECUTABLE_NAME, DEFAULT_OPTIONS.concat(fastMath ? FAST_MATH_OPTIONS : [], [input, "-o", sFileName])));
 
     return sFileName;
 }
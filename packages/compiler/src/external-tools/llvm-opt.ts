@@ -1,23 +1,26 @@
 import * as debug from "debug";
 import {OptimizationLevel} from "../speedyjs-compiler-options";
-import {execLLVM} from "./tools";
+import {execLLVM, FAST_MATH_OPTIONS} from "./tools";
 
 const LOG = debug("external-tools/llvm-opt");
 const EXECUTABLE_NAME = "opt";
 // tslint:disable-next-line:max-line-length
 const LINK_TIME_OPTIMIZATIONS = ["-strip-debug", "-internalize", "-globaldce", "-disable-loop-vectorization", "-disable-slp-vectorization", "-vectorize-loops=false", "-vectorize-slp=false"]; // Vectorization is not yet supported by the linker backend llc
-const DEFAULT_PUBLIC = "speedyJsGc,malloc,__errno_location";
+const DEFAULT_PUBLIC = "speedyJsGc,speedyJsSeedRandomi,malloc,__errno_location";
 
 /**
  * Executes the LLVM Optimizer on the given input file
  * @param filename the input file (absolute path)
  * @param optimizedFileName the name of the target file
  * @param level the optimization level
+ * @param fastMath indicator if the floating point operations may be optimized without preserving the strict IEEE semantics
  * @returns the name of the optimized file
  */
-export function optimize(filename: string, optimizedFileName: string, level: OptimizationLevel) {
+export function optimize(filename: string, optimizedFileName: string, level: OptimizationLevel, fastMath = false) {
+    const args = [filename, "-o", optimizedFileName, `-O${level}`, "-loop-unswitch", "-loop-unswitch", "-licm", "-irce"];
+
     LOG(`Optimization of file ${filename}`);
-    LOG(execLLVM(EXECUTABLE_NAME, [filename, "-o", optimizedFileName, `-O${level}`, "-loop-unswitch", "-loop-unswitch", "-licm", "-irce"]));
+    LOG(execLLVM(EXECUTABLE_NAME, fastMath ? args.concat(FAST_MATH_OPTIONS) : args));
     return optimizedFileName;
 }
 
@@ -27,12 +30,13 @@ export function optimize(filename: string, optimizedFileName: string, level: Opt
  * @param publicFunctions name of the public functions
  * @param optimizedFileName the name of the target file
  * @param level the used optimization level. If the level is at least 2, than link time optimizations are performed.
+ * @param fastMath indicator if the floating point operations may be optimized without preserving the strict IEEE semantics
  * @returns the name of the optimized file
  */
-export function optimizeLinked(filename: string, publicFunctions: string[], optimizedFileName: string, level: OptimizationLevel) {
+export function optimizeLinked(filename: string, publicFunctions: string[], optimizedFileName: string, level: OptimizationLevel, fastMath = false) {
     const publicApi = publicFunctions.concat(DEFAULT_PUBLIC).join(",");
     const linkTimeOpts = ["2", "3", "z", "s" ].indexOf(level) !== -1;
-    const optimizations = (linkTimeOpts ? ["-std-link-opts"] : []).concat(LINK_TIME_OPTIMIZATIONS);
+    const optimizations = (linkTimeOpts ? ["-std-link-opts"] : []).concat(LINK_TIME_OPTIMIZATIONS, fastMath ? FAST_MATH_OPTIONS : []);
     const args = [filename, "-o", optimizedFileName, `-internalize-public-api-list=${publicApi}`].concat(optimizations);
 
     LOG(`Link time optimization of file ${filename}`);
@@ -8,6 +8,12 @@ const CONFIGURATION_FILE = path.normalize(path.join(__dirname, "../../tools/conf
 const log = debug("external-tools/tools");
 let llvmBinDir: string | undefined;
 
+/**
+ * Options of opt and llc that relax the floating point semantics of all functions in the module (fast math). The options
+ * are applied as function attributes, the fast math flags of the instructions are set by the code generator.
+ */
+export const FAST_MATH_OPTIONS = ["-enable-unsafe-fp-math", "-enable-no-infs-fp-math", "-enable-no-nans-fp-math"];
+
 interface ToolsConfiguration {
     LLVM_CONFIG: string;
     BINARYEN: string;
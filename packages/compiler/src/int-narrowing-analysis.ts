@@ -0,0 +1,306 @@
+import * as ts from "typescript";
+
+/**
+ * Finds local variables that are declared as number but always hold an integral value in the int32 range.
+ * These variables can be stored as int without changing the semantics of the program, which avoids double arithmetic
+ * and the int conversions when the variable is used as array index, e.g. for the loop counter in
+ * for (let i: number = 0; i < array.length; ++i) { array[i]... }
+ *
+ * The analysis is intentionally conservative. A variable is narrowed if
+ * - it is declared with let or const, typed as number, and the initializer is of type int,
+ * - all assignments to the variable assign an int value,
+ * - it is only incremented (decremented) in the incrementor of the for statement declaring the variable and the condition of
+ *   the for statement is variable < bound (variable > bound) with an int bound. The condition guarantees that the
+ *   incremented value does not exceed the int32 range,
+ * - it is only read in expressions that have the same result for an int and a number operand (element access, comparison,
+ *   arithmetic, bitwise operations, assignments and call arguments) and it is not captured by a nested function,
+ * - it is used at least once where an int avoids a conversion (array index, increment, bitwise operation).
+ */
+export class IntNarrowingAnalysis {
+    private narrowedVariables = new Map<ts.Symbol, ts.Type | undefined>();
+
+    constructor(private tsTypeChecker: ts.TypeChecker) {}
+
+    /**
+     * Returns the int type if the variable referenced by the given node (identifier or variable declaration) can be narrowed to an int
+     * @param node the node referencing the variable
+     * @return the int type if the variable is narrowed or undefined otherwise
+     */
+    getNarrowedType(node: ts.Node): ts.Type | undefined {
+        if (node.kind !== ts.SyntaxKind.Identifier && node.kind !== ts.SyntaxKind.VariableDeclaration) {
+            return undefined;
+        }
+
+        const name = node.kind === ts.SyntaxKind.VariableDeclaration ? (node as ts.VariableDeclaration).name : node;
+        const symbol = this.tsTypeChecker.getSymbolAtLocation(name);
+
+        if (!symbol || !(symbol.flags & ts.SymbolFlags.BlockScopedVariable)) {
+            return undefined;
+        }
+
+        if (!this.narrowedVariables.has(symbol)) {
+            this.narrowedVariables.set(symbol, this.analyze(symbol));
+        }
+
+        return this.narrowedVariables.get(symbol);
+    }
+
+    private analyze(symbol: ts.Symbol): ts.Type | undefined {
+        const declarations = symbol.getDeclarations();
+        if (!declarations || declarations.length !== 1 || declarations[0].kind !== ts.SyntaxKind.VariableDeclaration) {
+            return undefined;
+        }
+
+        const declaration = declarations[0] as ts.VariableDeclaration;
+        if ((declaration.type && declaration.type.kind !== ts.SyntaxKind.NumberKeyword) ||
+            !declaration.initializer ||
+            declaration.name.kind !== ts.SyntaxKind.Identifier) {
+            return undefined;
+        }
+
+        const declaredType = this.tsTypeChecker.getTypeAtLocation(declaration);
+        const initializerType = this.getIntType(declaration.initializer);
+
+        if (!initializerType || !(declaredType.flags & ts.TypeFlags.NumberLike) || declaredType.flags & ts.TypeFlags.IntLike) {
+            return undefined;
+        }
+
+        const references = this.getReferences(symbol, declaration);
+        const increments = references.filter(reference => isIncrementOrDecrement(reference.parent!));
+        const assignments = references.filter(reference => isAssignmentTarget(reference));
+
+        if (increments.length > 0 && (assignments.length > 0 || !increments.every(increment => this.isBoundedIncrement(increment, declaration)))) {
+            return undefined;
+        }
+
+        for (const reference of references) {
+            if (!this.isIntCompatibleUsage(reference)) {
+                return undefined;
+            }
+        }
+
+        return references.some(reference => benefitsFromInt(reference)) ? initializerType : undefined;
+    }
+
+    /**
+     * Tests if the increment (decrement) is the incrementor of the for statement declaring the variable and the
+     * condition of the for statement guarantees that the updated value is in the int32 range.
+     */
+    private isBoundedIncrement(reference: ts.Identifier, declaration: ts.VariableDeclaration) {
+        const forStatement = declaration.parent!.parent!;
+        const unaryExpression = reference.parent as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+
+        if (forStatement.kind !== ts.SyntaxKind.ForStatement || (forStatement as ts.ForStatement).incrementor !== unaryExpression) {
+            return false;
+        }
+
+        const condition = (forStatement as ts.ForStatement).condition;
+        if (!condition || condition.kind !== ts.SyntaxKind.BinaryExpression) {
+            return false;
+        }
+
+        const comparison = condition as ts.BinaryExpression;
+        const symbol = this.tsTypeChecker.getSymbolAtLocation(reference);
+        const isVariable = (node: ts.Expression) => node.kind === ts.SyntaxKind.Identifier && this.tsTypeChecker.getSymbolAtLocation(node) === symbol;
+        const increment = unaryExpression.operator === ts.SyntaxKind.PlusPlusToken;
+
+        // i < bound or bound > i for increments, i > bound or bound < i for decrements
+        const variableOnLeftOperator = increment ? ts.SyntaxKind.LessThanToken : ts.SyntaxKind.GreaterThanToken;
+        const variableOnRightOperator = increment ? ts.SyntaxKind.GreaterThanToken : ts.SyntaxKind.LessThanToken;
+        let bound: ts.Expression | undefined;
+
+        if (isVariable(comparison.left) && comparison.operatorToken.kind === variableOnLeftOperator) {
+            bound = comparison.right;
+        } else if (isVariable(comparison.right) && comparison.operatorToken.kind === variableOnRightOperator) {
+            bound = comparison.left;
+        }
+
+        return !!bound && !!this.getIntType(bound);
+    }
+
+    private isIntCompatibleUsage(reference: ts.Identifier) {
+        const parent = reference.parent!;
+
+        switch (parent.kind) {
+            case ts.SyntaxKind.ElementAccessExpression:
+                return (parent as ts.ElementAccessExpression).argumentExpression === reference;
+
+            case ts.SyntaxKind.BinaryExpression: {
+                const binaryExpression = parent as ts.BinaryExpression;
+
+                if (binaryExpression.left === reference && isAssignmentTarget(reference)) {
+                    return binaryExpression.operatorToken.kind === ts.SyntaxKind.EqualsToken && !!this.getIntType(binaryExpression.right);
+                }
+
+                return isIntCompatibleOperator(binaryExpression.operatorToken.kind);
+            }
+
+            case ts.SyntaxKind.PrefixUnaryExpression:
+            case ts.SyntaxKind.PostfixUnaryExpression:
+                // bounded increments are verified separately
+                return isIncrementOrDecrement(parent);
+
+            case ts.SyntaxKind.VariableDeclaration:
+                return (parent as ts.VariableDeclaration).initializer === reference;
+
+            case ts.SyntaxKind.CallExpression:
+                return (parent as ts.CallExpression).expression !== reference;
+
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Returns all references of the variable in the scope of the variable. The declaration name is added as
+     * additional (incompatible) reference if the variable is referenced from a nested function.
+     */
+    private getReferences(symbol: ts.Symbol, declaration: ts.VariableDeclaration): ts.Identifier[] {
+        const references: ts.Identifier[] = [];
+        const scope = getBlockScope(declaration);
+        let capturedByFunction = false;
+
+        const visit = (node: ts.Node, inNestedFunction: boolean) => {
+            if (node.kind === ts.SyntaxKind.Identifier && node !== declaration.name && this.tsTypeChecker.getSymbolAtLocation(node) === symbol) {
+                capturedByFunction = capturedByFunction || inNestedFunction;
+                references.push(node as ts.Identifier);
+            }
+
+            const isFunction = isFunctionLikeDeclaration(node);
+            ts.forEachChild(node, child => visit(child, inNestedFunction || isFunction));
+        };
+
+        visit(scope, false);
+
+        // a nested function might be called when the variable is out of the int range, e.g. after the loop
+        if (capturedByFunction) {
+            references.push(declaration.name as ts.Identifier); // a declaration name is no int compatible usage
+        }
+
+        return references;
+    }
+
+    private getIntType(expression: ts.Expression): ts.Type | undefined {
+        let type = this.tsTypeChecker.getTypeAtLocation(expression);
+
+        if (type.flags & ts.TypeFlags.Literal) {
+            type = this.tsTypeChecker.getBaseTypeOfLiteralType(type);
+        }
+
+        return type.flags & ts.TypeFlags.IntLike ? type : undefined;
+    }
+}
+
+/**
+ * Returns the node that is the scope of a let or const variable
+ */
+function getBlockScope(declaration: ts.VariableDeclaration): ts.Node {
+    let scope = declaration.parent!.parent!; // variable declaration list -> variable statement or for statement
+
+    while (scope.kind === ts.SyntaxKind.VariableStatement) {
+        scope = scope.parent!;
+    }
+
+    return scope;
+}
+
+function isFunctionLikeDeclaration(node: ts.Node) {
+    switch (node.kind) {
+        case ts.SyntaxKind.FunctionDeclaration:
+        case ts.SyntaxKind.FunctionExpression:
+        case ts.SyntaxKind.ArrowFunction:
+        case ts.SyntaxKind.MethodDeclaration:
+        case ts.SyntaxKind.Constructor:
+        case ts.SyntaxKind.GetAccessor:
+        case ts.SyntaxKind.SetAccessor:
+            return true;
+        default:
+            return false;
+    }
+}
+
+function isIncrementOrDecrement(node: ts.Node) {
+    if (node.kind !== ts.SyntaxKind.PrefixUnaryExpression && node.kind !== ts.SyntaxKind.PostfixUnaryExpression) {
+        return false;
+    }
+
+    const operator = (node as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression).operator;
+    return operator === ts.SyntaxKind.PlusPlusToken || operator === ts.SyntaxKind.MinusMinusToken;
+}
+
+function isAssignmentTarget(reference: ts.Identifier) {
+    const parent = reference.parent!;
+
+    if (parent.kind !== ts.SyntaxKind.BinaryExpression || (parent as ts.BinaryExpression).left !== reference) {
+        return false;
+    }
+
+    const operator = (parent as ts.BinaryExpression).operatorToken.kind;
+    return operator >= ts.SyntaxKind.FirstAssignment && operator <= ts.SyntaxKind.LastAssignment;
+}
+
+/**
+ * Tests if the usage of the variable requires a conversion to int if the variable is a number
+ */
+function benefitsFromInt(reference: ts.Identifier) {
+    const parent = reference.parent!;
+
+    switch (parent.kind) {
+        case ts.SyntaxKind.ElementAccessExpression:
+            return true;
+        case ts.SyntaxKind.PrefixUnaryExpression:
+        case ts.SyntaxKind.PostfixUnaryExpression:
+            return isIncrementOrDecrement(parent);
+        case ts.SyntaxKind.BinaryExpression:
+            return isBitwiseOperator((parent as ts.BinaryExpression).operatorToken.kind);
+        default:
+            return false;
+    }
+}
+
+function isBitwiseOperator(operator: ts.SyntaxKind) {
+    switch (operator) {
+        case ts.SyntaxKind.AmpersandToken:
+        case ts.SyntaxKind.BarToken:
+        case ts.SyntaxKind.CaretToken:
+        case ts.SyntaxKind.LessThanLessThanToken:
+        case ts.SyntaxKind.GreaterThanGreaterThanToken:
+        case ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken:
+            return true;
+        default:
+            return false;
+    }
+}
+
+function isIntCompatibleOperator(operator: ts.SyntaxKind) {
+    if (isBitwiseOperator(operator)) {
+        return true;
+    }
+
+    switch (operator) {
+        case ts.SyntaxKind.LessThanToken:
+        case ts.SyntaxKind.LessThanEqualsToken:
+        case ts.SyntaxKind.GreaterThanToken:
+        case ts.SyntaxKind.GreaterThanEqualsToken:
+        case ts.SyntaxKind.EqualsEqualsToken:
+        case ts.SyntaxKind.EqualsEqualsEqualsToken:
+        case ts.SyntaxKind.ExclamationEqualsToken:
+        case ts.SyntaxKind.ExclamationEqualsEqualsToken:
+        case ts.SyntaxKind.PlusToken:
+        case ts.SyntaxKind.MinusToken:
+        case ts.SyntaxKind.AsteriskToken:
+        case ts.SyntaxKind.SlashToken:
+        case ts.SyntaxKind.PercentToken:
+        case ts.SyntaxKind.AsteriskAsteriskToken:
+        // the variable is the right hand side, e.g. sum += i. The left hand side is not narrowed
+        case ts.SyntaxKind.EqualsToken:
+        case ts.SyntaxKind.PlusEqualsToken:
+        case ts.SyntaxKind.MinusEqualsToken:
+        case ts.SyntaxKind.AsteriskEqualsToken:
+        case ts.SyntaxKind.SlashEqualsToken:
+        case ts.SyntaxKind.PercentEqualsToken:
+            return true;
+        default:
+            return false;
+    }
+}
@@ -47,6 +47,29 @@ export interface SpeedyJSCompilerOptions extends CompilerOptions {
      */
     initialMemory: number;
 
+    /**
+     * The maximum size of the memory (Heap + stack) in bytes. The module fails with an out of memory error if an allocation
+     * requires to grow the memory beyond this size. A value of 0 permits growing up to 2GB. Values up to 4GB are supported
+     * but require an engine that supports memories larger than 2GB.
+     * @default 0
+     */
+    maximumMemory: number;
+
+    /**
+     * The factor by which the memory is grown if an allocation requires more memory than is currently available.
+     * A factor of 1 grows the memory exactly by the requested size (rounded up to whole WebAssembly pages).
+     * @default 2
+     */
+    memoryGrowthFactor: number;
+
+    /**
+     * Memory in bytes that is allocated up-front when the module is loaded. Reserving the memory needed by the program
+     * avoids that the memory needs to be grown (and the heap views rebuilt) in the middle of a computation.
+     * A value of 0 (or less than the initial memory) only allocates the initial memory.
+     * @default 0
+     */
+    reserveMemory: number;
+
     /**
      * Total memory to be allocated for the stack in bytes. Needs to be less than total Memory.
      * The stack can not be resized during runtime. Therefore, the defined size needs to be large enough to hold of the program.
@@ -79,12 +102,30 @@ export interface SpeedyJSCompilerOptions extends CompilerOptions {
      */
     exportGc: boolean;
 
+    /**
+     * Indicator if objects should be allocated in a warm heap. The warm heap retains its memory when the heap is nuked
+     * at the exit of an entry function so that subsequent calls reuse the memory without allocator overhead.
+     * Intended for entry functions that are called repeatedly and allocate many short lived objects.
+     * @default false
+     */
+    warmHeap: boolean;
+
     /**
      * The optimization level passed to llvm
      * @default "3"
      */
     optimizationLevel: OptimizationLevel;
 
+    /**
+     * Indicator if floating point operations may be optimized without preserving the strict IEEE semantics, e.g. by
+     * reassociating a sum or by assuming that no NaN or infinite values occur. The floating point instructions of the
+     * compiled functions are emitted with the fast math flags and opt and llc are run with the unsafe fp math options.
+     * The runtime library is not affected. Single functions can opt in using the "use speedyjs fastmath" directive.
+     * The results may differ from the results of the same function executed as JavaScript.
+     * @default false
+     */
+    fastMath: boolean;
+
     /**
      * The implementation that writes the wasm file
      */
@@ -110,13 +151,18 @@ export function initializeCompilerOptions(compilerOptions: UninitializedSpeedyJS
         saveWast: false,
         binaryenOpt: false,
         initialMemory: 16 * 1024 * 1024,
+        maximumMemory: 0,
+        memoryGrowthFactor: 2,
+        reserveMemory: 0,
         totalStack: 5 * 1024 * 104,
         globalBase: 8,
         saveBc: false,
         disableHeapNukeOnExit: false,
         exposeGc: false,
         exportGc: false,
+        warmHeap: false,
         optimizationLevel: "2",
+        fastMath: false,
         wasmFileWriter: new DefaultWasmFileWriter()
     };
 
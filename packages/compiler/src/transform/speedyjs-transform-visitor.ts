@@ -2,6 +2,7 @@ import debug = require("debug");
 import * as ts from "typescript";
 import {CodeGenerationDiagnostics} from "../code-generation-diagnostic";
 import {CodeGenerator} from "../code-generation/code-generator";
+import {isClosure} from "../code-generation/util/closures";
 import {isFunctionType} from "../code-generation/util/types";
 import {CompilationContext} from "../compilation-context";
 import {TypeChecker} from "../type-checker";
@@ -150,6 +151,10 @@ function canBeCalledFromJs(declaration: ts.FunctionLikeDeclaration) {
         isSpeedyJSEntryFunction(declaration);
 }
 
+/**
+ * Speedy.js functions can call other Speedy.js functions, runtime functions (without a body) and the functions nested inside
+ * of the calling function, as these are compiled as part of the enclosing function.
+ */
 function canBeCalledFromSpeedyJs(declaration: ts.FunctionLikeDeclaration) {
-    return !declaration.body || isSpeedyJSFunction(declaration);
+    return !declaration.body || isSpeedyJSFunction(declaration) || isClosure(declaration);
 }
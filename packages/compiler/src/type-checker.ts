@@ -26,4 +26,20 @@ export interface TypeChecker {
      */
     toSupportedType(type: ts.Type): ts.Type;
     isUndefinedSymbol(symbol: ts.Symbol): boolean;
+
+    /**
+     * Returns the type arguments of an instantiated generic signature, e.g. number for the call min(1.0, 2.0) of min<T>.
+     * @param signature the instantiated signature
+     * @return map from the type parameters of the generic signature to their type arguments, empty if the signature is not generic
+     */
+    getTypeArgumentsOfSignature(signature: ts.Signature): Map<ts.TypeParameter, ts.Type>;
+
+    /**
+     * Substitutes the type parameters with the given type arguments in all types returned by this type checker while the callback is executed.
+     * Used to generate the code of the specialization of a generic function or class for specific type arguments.
+     * @param typeArguments map from the type parameters to the type arguments
+     * @param callback the callback to execute
+     * @return the result of the callback
+     */
+    withTypeArguments<T>(typeArguments: Map<ts.TypeParameter, ts.Type>, callback: () => T): T;
 }
@@ -1,4 +1,7 @@
 import * as ts from "typescript";
+import {CodeGenerationDiagnostics} from "./code-generation-diagnostic";
+import {isInt64Type, isUintType} from "./code-generation/util/types";
+import {IntNarrowingAnalysis} from "./int-narrowing-analysis";
 import {TypeChecker} from "./type-checker";
 
 /**
@@ -7,8 +10,12 @@ import {TypeChecker} from "./type-checker";
  * of nullable types should be removed.
  */
 export class TypeScriptTypeChecker implements TypeChecker {
+    private intNarrowingAnalysis: IntNarrowingAnalysis;
+    private typeArguments = new Map<ts.TypeParameter, ts.Type>();
 
-    constructor(private tsTypeChecker: ts.TypeChecker) {}
+    constructor(private tsTypeChecker: ts.TypeChecker) {
+        this.intNarrowingAnalysis = new IntNarrowingAnalysis(tsTypeChecker);
+    }
 
     getAliasedSymbol(symbol: ts.Symbol): ts.Symbol {
         return this.tsTypeChecker.getAliasedSymbol(symbol);
@@ -39,11 +46,25 @@ export class TypeScriptTypeChecker implements TypeChecker {
     }
 
     getSignatureFromDeclaration(functionDeclaration: ts.FunctionDeclaration): ts.Signature {
-        return new SignatureWrapper(this.tsTypeChecker.getSignatureFromDeclaration(functionDeclaration), this.tsTypeChecker);
+        return new SignatureWrapper(this.tsTypeChecker.getSignatureFromDeclaration(functionDeclaration), this);
     }
 
     getTypeAtLocation(node: ts.Node): ts.Type {
-        let type = this.toSupportedType(this.tsTypeChecker.getTypeAtLocation(node));
+        // number variables that only hold int values, e.g. loop counters, are stored as int
+        const narrowedType = this.intNarrowingAnalysis.getNarrowedType(node);
+        if (narrowedType) {
+            return narrowedType;
+        }
+
+        let type = this.toSupportedTypeAtLocation(this.tsTypeChecker.getTypeAtLocation(node), node);
+
+        // typescript types int64 and uint arithmetic and integer literals used as int64 or uint as number (or int)
+        if (type && type.flags & ts.TypeFlags.NumberLike) {
+            const integerType = this.getIntegerType(node);
+            if (integerType) {
+                return integerType;
+            }
+        }
 
         // e.g. when const x: int[] = [] then the type of [] is never[] that is quite unfortunate. Take the contextual
         // type information into consideration in this case (but do not otherwise. Otherwise let x: number = 3 returns unexpected results.
@@ -67,11 +88,11 @@ export class TypeScriptTypeChecker implements TypeChecker {
     }
 
     getTypeOfSymbolAtLocation(symbol: ts.Symbol, location: ts.Node): ts.Type {
-        return this.toSupportedType(this.tsTypeChecker.getTypeOfSymbolAtLocation(symbol, location));
+        return this.toSupportedTypeAtLocation(this.tsTypeChecker.getTypeOfSymbolAtLocation(symbol, location), location);
     }
 
     getResolvedSignature(callLikeExpression: ts.CallLikeExpression): ts.Signature {
-        return new SignatureWrapper(this.tsTypeChecker.getResolvedSignature(callLikeExpression), this.tsTypeChecker);
+        return new SignatureWrapper(this.tsTypeChecker.getResolvedSignature(callLikeExpression), this);
     }
 
     isImplementationOfOverload(fun: ts.FunctionLikeDeclaration): boolean {
@@ -79,12 +100,253 @@ export class TypeScriptTypeChecker implements TypeChecker {
     }
 
     toSupportedType(type: ts.Type): ts.Type {
-        return toSupportedType(type, this.tsTypeChecker);
+        return toSupportedType(this.substituteTypeParameters(type), this.tsTypeChecker);
+    }
+
+    private toSupportedTypeAtLocation(type: ts.Type, location: ts.Node): ts.Type {
+        return toSupportedType(this.substituteTypeParameters(type, location), this.tsTypeChecker);
     }
 
     isUndefinedSymbol(symbol: ts.Symbol) {
         return this.tsTypeChecker.isUndefinedSymbol(symbol);
     }
+
+    getTypeArgumentsOfSignature(signature: ts.Signature): Map<ts.TypeParameter, ts.Type> {
+        const instantiated = (signature instanceof SignatureWrapper ? signature.signature : signature) as InstantiatedSignature;
+        const typeArguments = new Map<ts.TypeParameter, ts.Type>();
+
+        if (instantiated.target && instantiated.target.typeParameters && instantiated.mapper) {
+            for (const typeParameter of instantiated.target.typeParameters) {
+                typeArguments.set(typeParameter, this.toSupportedType(instantiated.mapper(typeParameter)));
+            }
+        }
+
+        return typeArguments;
+    }
+
+    withTypeArguments<T>(typeArguments: Map<ts.TypeParameter, ts.Type>, callback: () => T): T {
+        const outerTypeArguments = this.typeArguments;
+        this.typeArguments = new Map([...Array.from(outerTypeArguments.entries()), ...Array.from(typeArguments.entries())]);
+
+        try {
+            return callback();
+        } finally {
+            this.typeArguments = outerTypeArguments;
+        }
+    }
+
+    /**
+     * Returns the int64 or uint type if the expression computes an int64 or uint value. This is the case for arithmetic, bitwise and
+     * unary operations with int64 or uint operands (and int operands) and for integer literals that are used as int64 or uint.
+     */
+    private getIntegerType(node: ts.Node): ts.Type | undefined {
+        switch (node.kind) {
+            case ts.SyntaxKind.ParenthesizedExpression: {
+                const type = this.getTypeAtLocation((node as ts.ParenthesizedExpression).expression);
+                return isInt64Type(type) || isUintType(type) ? type : undefined;
+            }
+
+            case ts.SyntaxKind.NumericLiteral: {
+                const contextualType = this.getContextualType(node as ts.NumericLiteral);
+                const isInteger = Number.isInteger(+(node as ts.NumericLiteral).text);
+                return contextualType && (isInt64Type(contextualType) || isUintType(contextualType)) && isInteger ? contextualType : undefined;
+            }
+
+            case ts.SyntaxKind.PrefixUnaryExpression:
+            case ts.SyntaxKind.PostfixUnaryExpression: {
+                const unary = node as ts.PrefixUnaryExpression | ts.PostfixUnaryExpression;
+                if (unary.operator === ts.SyntaxKind.PlusToken) {
+                    return undefined; // +x converts x to a number
+                }
+
+                const type = this.getTypeAtLocation(unary.operand);
+                return isInt64Type(type) || isUintType(type) ? type : undefined;
+            }
+
+            case ts.SyntaxKind.BinaryExpression: {
+                const binary = node as ts.BinaryExpression;
+                const operator = binary.operatorToken.kind;
+                const leftType = this.getTypeAtLocation(binary.left);
+                const rightType = this.getTypeAtLocation(binary.right);
+
+                // the result of a shift has the type of the shifted value, >>> is not defined for BigInts
+                if (SHIFT_OPERATORS.indexOf(operator) !== -1) {
+                    const shiftable = isUintType(leftType) || (isInt64Type(leftType) && UNSIGNED_SHIFT_OPERATORS.indexOf(operator) === -1);
+                    return shiftable && isWideningConversion(rightType, leftType) ? leftType : undefined;
+                }
+
+                if (INTEGER_OPERATORS.indexOf(operator) === -1) {
+                    return undefined;
+                }
+
+                if ((isInt64Type(leftType) || isUintType(leftType)) && isWideningConversion(rightType, leftType)) {
+                    return leftType;
+                }
+
+                return (isInt64Type(rightType) || isUintType(rightType)) && isWideningConversion(leftType, rightType) ? rightType : undefined;
+            }
+
+            default:
+                return undefined;
+        }
+    }
+
+    /**
+     * Substitutes the type parameters in the given type with the type arguments of the instantiation that is generated.
+     * The substitution relies on internals of the TypeScript type checker (the instantiations cache of generic types, the
+     * key computed by getTypeListId and getNullableType). Therefore, it can only return type references that the type checker
+     * has created when checking the program. This is not the case for a type that is only used inside of generic code,
+     * e.g. new Box<T>() in a generic function f<T> that is only called as f<int>() if Box<int> is not used elsewhere.
+     * @param type the type in which the type parameters are to be substituted
+     * @param location the node of which the type is substituted, the location of the diagnostic if the substitution fails
+     */
+    private substituteTypeParameters(type: ts.Type, location?: ts.Node): ts.Type {
+        if (this.typeArguments.size === 0 || typeof(type) === "undefined") {
+            return type;
+        }
+
+        if (type.flags & ts.TypeFlags.TypeParameter) {
+            return this.typeArguments.get(type as ts.TypeParameter) || type;
+        }
+
+        if (type.flags & ts.TypeFlags.Union) {
+            const unionType = type as ts.UnionType;
+            const types = unionType.types.map(constituent => this.substituteTypeParameters(constituent, location));
+
+            if (types.every((substituted, i) => substituted === unionType.types[i])) {
+                return type;
+            }
+
+            // T | undefined, e.g. for an optional field of type T
+            const nonUndefinedTypes = types.filter(constituent => !(constituent.flags & ts.TypeFlags.Undefined));
+            if (nonUndefinedTypes.length === 1) {
+                return (this.tsTypeChecker as any).getNullableType(nonUndefinedTypes[0], ts.TypeFlags.Undefined);
+            }
+
+            const typeName = this.typeToString(type);
+            if (location) {
+                throw CodeGenerationDiagnostics.unsupportedGenericUnionType(location, typeName);
+            }
+            throw new Error(`Substituting the type parameters of the union type ${typeName} is not supported`);
+        }
+
+        if (type.flags & ts.TypeFlags.Object && (type as ts.ObjectType).objectFlags & ts.ObjectFlags.Reference) {
+            const typeReference = type as ts.TypeReference;
+            const typeArguments = (typeReference.typeArguments || []).map(typeArgument => this.substituteTypeParameters(typeArgument, location));
+
+            if (typeArguments.every((substituted, i) => substituted === typeReference.typeArguments[i])) {
+                return type;
+            }
+
+            return getTypeReference(typeReference.target, typeArguments, this.tsTypeChecker, location);
+        }
+
+        return type;
+    }
+}
+
+/**
+ * The binary operators that have an int64 or uint result if the operands are int64 or uint values
+ */
+const INTEGER_OPERATORS = [
+    ts.SyntaxKind.PlusToken,
+    ts.SyntaxKind.PlusEqualsToken,
+    ts.SyntaxKind.MinusToken,
+    ts.SyntaxKind.MinusEqualsToken,
+    ts.SyntaxKind.AsteriskToken,
+    ts.SyntaxKind.AsteriskEqualsToken,
+    ts.SyntaxKind.SlashToken,
+    ts.SyntaxKind.SlashEqualsToken,
+    ts.SyntaxKind.PercentToken,
+    ts.SyntaxKind.PercentEqualsToken,
+    ts.SyntaxKind.AmpersandToken,
+    ts.SyntaxKind.AmpersandEqualsToken,
+    ts.SyntaxKind.BarToken,
+    ts.SyntaxKind.BarEqualsToken,
+    ts.SyntaxKind.CaretToken,
+    ts.SyntaxKind.CaretEqualsToken
+];
+
+const UNSIGNED_SHIFT_OPERATORS = [
+    ts.SyntaxKind.GreaterThanGreaterThanGreaterThanToken,
+    ts.SyntaxKind.GreaterThanGreaterThanGreaterThanEqualsToken
+];
+
+const SHIFT_OPERATORS = [
+    ts.SyntaxKind.LessThanLessThanToken,
+    ts.SyntaxKind.LessThanLessThanEqualsToken,
+    ts.SyntaxKind.GreaterThanGreaterThanToken,
+    ts.SyntaxKind.GreaterThanGreaterThanEqualsToken,
+    ...UNSIGNED_SHIFT_OPERATORS
+];
+
+/**
+ * Tests if a value of the source type is implicitly converted to the int64 or uint target type in a binary operation.
+ * int values are converted to int64 and uint, uint values are widened to int64.
+ */
+function isWideningConversion(source: ts.Type, target: ts.Type) {
+    return source === target || !!(source.flags & ts.TypeFlags.IntLike) || (isUintType(source) && isInt64Type(target));
+}
+
+/**
+ * Internal properties of a signature that is an instantiation of a generic signature
+ */
+interface InstantiatedSignature extends ts.Signature {
+    target?: ts.Signature;
+    mapper?: (type: ts.TypeParameter) => ts.Type;
+}
+
+/**
+ * Returns the instantiation of the generic type for the given type arguments. The type checker creates the type references
+ * when checking the program. The instantiations of a generic type are cached by the ids of the type arguments.
+ * A type reference that the type checker has not created cannot be created here as creating types requires the internal
+ * createTypeReference function of the type checker.
+ */
+function getTypeReference(target: ts.GenericType, typeArguments: ts.Type[], typeChecker: ts.TypeChecker, location?: ts.Node): ts.TypeReference {
+    const instantiations = (target as any).instantiations as Map<string, ts.TypeReference>;
+    const typeReference = instantiations.get(getTypeListId(typeArguments));
+
+    if (!typeReference) {
+        const typeArgumentNames = typeArguments.map(typeArgument => typeChecker.typeToString(typeArgument)).join(", ");
+        const typeName = `${target.getSymbol().name}<${typeArgumentNames}>`;
+
+        if (location) {
+            throw CodeGenerationDiagnostics.uninstantiatedGenericType(location, typeName);
+        }
+        throw new Error(`The type ${typeName} is not used outside of generic code and, therefore, cannot be instantiated`);
+    }
+
+    return typeReference;
+}
+
+/**
+ * Computes the key of a list of types as used by the type checker, consecutive ids are encoded as ranges
+ */
+function getTypeListId(types: ts.Type[]) {
+    let result = "";
+    let i = 0;
+
+    while (i < types.length) {
+        const startId = (types[i] as any).id as number;
+        let count = 1;
+
+        while (i + count < types.length && (types[i + count] as any).id === startId + count) {
+            ++count;
+        }
+
+        if (result.length) {
+            result += ",";
+        }
+
+        result += startId;
+        if (count > 1) {
+            result += ":" + count;
+        }
+
+        i += count;
+    }
+
+    return result;
 }
 
 function toSupportedType(type: ts.Type, typeChecker: ts.TypeChecker): ts.Type {
@@ -126,7 +388,7 @@ function toSupportedType(type: ts.Type, typeChecker: ts.TypeChecker): ts.Type {
 
 class SignatureWrapper implements ts.Signature {
 
-    constructor(private signature: ts.Signature, private typeChecker: ts.TypeChecker) {
+    constructor(readonly signature: ts.Signature, private typeChecker: TypeChecker) {
     }
 
     getJsDocTags(): ts.JSDocTagInfo[] {
@@ -170,7 +432,7 @@ class SignatureWrapper implements ts.Signature {
             returnType = typeReference.typeArguments && typeReference.typeArguments.length === 1 ? typeReference.typeArguments[0] : returnType;
         }
 
-        return toSupportedType(returnType, this.typeChecker);
+        return this.typeChecker.toSupportedType(returnType);
     }
 
     getDocumentationComment(): ts.SymbolDisplayPart[] {
@@ -1,4 +1,40 @@
 import * as ts from "typescript";
+import {OptimizationLevel} from "../speedyjs-compiler-options";
+
+/**
+ * The "use speedyjs" directive of a function and the options following it, e.g. "use speedyjs unsafe O3"
+ */
+export interface SpeedyJSDirective {
+    /**
+     * The directive statement
+     */
+    node: ts.ExpressionStatement;
+
+    /**
+     * Indicator if the function is compiled without memory safety checks (e.g. array bounds checks)
+     */
+    unsafe: boolean;
+
+    /**
+     * Indicator if the function is always inlined into its callers
+     */
+    inline: boolean;
+
+    /**
+     * Indicator if the floating point instructions of the function are emitted with the fast math flags
+     */
+    fastMath: boolean;
+
+    /**
+     * The optimization level for the function or undefined if the optimization level of the module applies
+     */
+    optimizationLevel?: OptimizationLevel;
+
+    /**
+     * The options that are not understood
+     */
+    unsupportedOptions: string[];
+}
 
 /**
  * tests if the passed function is a speedy js function
@@ -6,20 +42,44 @@ import * as ts from "typescript";
  * @return {boolean} true if the function is a speedy js function
  */
 export function isSpeedyJSFunction(fun: ts.FunctionLikeDeclaration) {
+    return !!getSpeedyJSDirective(fun);
+}
+
+/**
+ * Returns the "use speedyjs" directive of the passed function
+ * @param fun the function
+ * @return {SpeedyJSDirective} the parsed directive or undefined if the function is not a speedy js function
+ */
+export function getSpeedyJSDirective(fun: ts.FunctionLikeDeclaration): SpeedyJSDirective | undefined {
     if (!fun.body || !isBlock(fun.body)) {
-        return false;
+        return undefined;
     }
 
-    for (const statement of fun.body.statements) {
-        if (isPrologueDirective(statement)) {
-            if (statement.expression.text === "use speedyjs") {
-                return true;
+    for (const statement of getPrologueDirectives(fun.body)) {
+        const [use, speedyjs, ...options] = statement.expression.text.trim().split(/\s+/);
+        if (use !== "use" || speedyjs !== "speedyjs") {
+            continue;
+        }
+
+        const directive: SpeedyJSDirective = { node: statement, unsafe: false, inline: false, fastMath: false, unsupportedOptions: [] };
+        for (const option of options) {
+            if (option === "unsafe") {
+                directive.unsafe = true;
+            } else if (option === "inline") {
+                directive.inline = true;
+            } else if (option === "fastmath") {
+                directive.fastMath = true;
+            } else if (/^O[0-3sz]$/.test(option)) {
+                directive.optimizationLevel = option.substr(1) as OptimizationLevel;
+            } else {
+                directive.unsupportedOptions.push(option);
             }
-        } else {
-            break;
         }
+
+        return directive;
     }
-    return false;
+
+    return undefined;
 }
 
 /**
@@ -34,6 +94,35 @@ export function isSpeedyJSEntryFunction(fun: ts.FunctionLikeDeclaration): fun is
         !!fun.modifiers.find(modifier => modifier.kind === ts.SyntaxKind.AsyncKeyword);
 }
 
+/**
+ * Tests if the passed class is a value class. The constructor of a value class contains the "use value" directive.
+ * Instances of value classes are stored inline in variables and fields and are copied on assignment.
+ * @param classDeclaration the class to test
+ * @return {boolean} true if it is a value class
+ */
+export function isValueClass(classDeclaration: ts.ClassDeclaration): boolean {
+    const constructorDeclaration = classDeclaration.members.find(member => member.kind === ts.SyntaxKind.Constructor) as ts.ConstructorDeclaration | undefined;
+    return !!constructorDeclaration && !!constructorDeclaration.body && hasDirective(constructorDeclaration.body, "use value");
+}
+
+function hasDirective(body: ts.Block, directive: string) {
+    return getPrologueDirectives(body).some(statement => statement.expression.text === directive);
+}
+
+function getPrologueDirectives(body: ts.Block): PrologueDirective[] {
+    const directives: PrologueDirective[] = [];
+
+    for (const statement of body.statements) {
+        if (!isPrologueDirective(statement)) {
+            break;
+        }
+
+        directives.push(statement);
+    }
+
+    return directives;
+}
+
 interface PrologueDirective extends ts.ExpressionStatement {
     expression: ts.StringLiteral;
 }
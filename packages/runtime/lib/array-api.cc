@@ -32,6 +32,22 @@ DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_constructorPiu(int32_t* const e
     return new Array<int32_t> { elements, elementsCount};
 }
 
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_constructori(int32_t size) {
+    return new Array<int64_t> { size };
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_constructori(int32_t size) {
+    return new Array<uint32_t> { size };
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_constructorPlu(int64_t* const elements, size_t elementsCount) {
+    return new Array<int64_t> { elements, elementsCount};
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_constructorPju(uint32_t* const elements, size_t elementsCount) {
+    return new Array<uint32_t> { elements, elementsCount};
+}
+
 DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_constructori(const int32_t size) {
     return new Array<double> { size };
 }
@@ -60,6 +76,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_geti(const Array<int32_t>& array, int32
     return array.get(index);
 }
 
+DLL_PUBLIC ALWAYS_INLINE int64_t ArrayIl_geti(const Array<int64_t>& array, int32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE uint32_t ArrayIj_geti(const Array<uint32_t>& array, int32_t index) {
+    return array.get(index);
+}
+
 DLL_PUBLIC ALWAYS_INLINE double ArrayId_geti(const Array<double>& array, int32_t index) {
     return array.get(index);
 }
@@ -68,6 +92,31 @@ DLL_PUBLIC ALWAYS_INLINE void* ArrayIPv_geti(const Array<void*>& array, int32_t
     return array.get(index);
 }
 
+// uint indices, array[index] with an index of type uint
+DLL_PUBLIC ALWAYS_INLINE bool ArrayIb_getj(const Array<bool>& array, uint32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_getj(const Array<int32_t>& array, uint32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE int64_t ArrayIl_getj(const Array<int64_t>& array, uint32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE uint32_t ArrayIj_getj(const Array<uint32_t>& array, uint32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE double ArrayId_getj(const Array<double>& array, uint32_t index) {
+    return array.get(index);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void* ArrayIPv_getj(const Array<void*>& array, uint32_t index) {
+    return array.get(index);
+}
+
 //---------------------------------------------------------------------------------
 // set
 //---------------------------------------------------------------------------------
@@ -80,6 +129,14 @@ DLL_PUBLIC ALWAYS_INLINE void ArrayIi_setii(Array<int32_t>& array, int32_t index
     array.set(index, value);
 }
 
+DLL_PUBLIC ALWAYS_INLINE void ArrayIl_setil(Array<int64_t>& array, int32_t index, int64_t value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIj_setij(Array<uint32_t>& array, int32_t index, uint32_t value) {
+    array.set(index, value);
+}
+
 DLL_PUBLIC ALWAYS_INLINE void ArrayId_setid(Array<double>& array, int32_t index, double value) {
     array.set(index, value);
 }
@@ -88,6 +145,31 @@ DLL_PUBLIC ALWAYS_INLINE void ArrayIPv_setiPv(Array<void*>& array, int32_t index
     array.set(index, value);
 }
 
+// uint indices, array[index] = value with an index of type uint
+DLL_PUBLIC ALWAYS_INLINE void ArrayIb_setjb(Array<bool>& array, uint32_t index, bool value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIi_setji(Array<int32_t>& array, uint32_t index, int32_t value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIl_setjl(Array<int64_t>& array, uint32_t index, int64_t value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIj_setjj(Array<uint32_t>& array, uint32_t index, uint32_t value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayId_setjd(Array<double>& array, uint32_t index, double value) {
+    array.set(index, value);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIPv_setjPv(Array<void*>& array, uint32_t index, void* value) {
+    array.set(index, value);
+}
+
 //---------------------------------------------------------------------------------
 // fill
 //---------------------------------------------------------------------------------
@@ -122,6 +204,36 @@ DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_filliii(Array<int32_t>& array,
     return &array;
 }
 
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_filll(Array<int64_t>& array, int64_t value) {
+    array.fill(value);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_fillj(Array<uint32_t>& array, uint32_t value) {
+    array.fill(value);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_fillli(Array<int64_t>& array, int64_t value, int32_t start) {
+    array.fill(value, start);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_fillji(Array<uint32_t>& array, uint32_t value, int32_t start) {
+    array.fill(value, start);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_filllii(Array<int64_t>& array, int64_t value, int32_t start, int32_t end) {
+    array.fill(value, start, end);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_filljii(Array<uint32_t>& array, uint32_t value, int32_t start, int32_t end) {
+    array.fill(value, start, end);
+    return &array;
+}
+
 DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_filld(Array<double>& array, double value) {
     array.fill(value);
     return &array;
@@ -164,6 +276,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_pushPiu(Array<int32_t>& array, int32_t*
     return array.push(elements, numElements);
 }
 
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIl_pushPlu(Array<int64_t>& array, int64_t* elements, size_t numElements) {
+    return array.push(elements, numElements);
+}
+
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIj_pushPju(Array<uint32_t>& array, uint32_t* elements, size_t numElements) {
+    return array.push(elements, numElements);
+}
+
 DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_pushPdu(Array<double>& array, double* elements, size_t numElements) {
     return array.push(elements, numElements);
 }
@@ -184,6 +304,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_unshiftPiu(Array<int32_t>& array, int32
     return array.unshift(elements, numElements);
 }
 
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIl_unshiftPlu(Array<int64_t>& array, int64_t* elements, size_t numElements) {
+    return array.unshift(elements, numElements);
+}
+
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIj_unshiftPju(Array<uint32_t>& array, uint32_t* elements, size_t numElements) {
+    return array.unshift(elements, numElements);
+}
+
 DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_unshiftPdu(Array<double>& array, double* elements, size_t numElements)  {
     return array.unshift(elements, numElements);
 }
@@ -204,6 +332,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_pop(Array<int32_t>& array) {
     return array.pop();
 }
 
+DLL_PUBLIC ALWAYS_INLINE int64_t ArrayIl_pop(Array<int64_t>& array) {
+    return array.pop();
+}
+
+DLL_PUBLIC ALWAYS_INLINE uint32_t ArrayIj_pop(Array<uint32_t>& array) {
+    return array.pop();
+}
+
 DLL_PUBLIC ALWAYS_INLINE double ArrayId_pop(Array<double>& array) {
     return array.pop();
 }
@@ -224,6 +360,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_shift(Array<int32_t>& array) {
     return array.shift();
 }
 
+DLL_PUBLIC ALWAYS_INLINE int64_t ArrayIl_shift(Array<int64_t>& array) {
+    return array.shift();
+}
+
+DLL_PUBLIC ALWAYS_INLINE uint32_t ArrayIj_shift(Array<uint32_t>& array) {
+    return array.shift();
+}
+
 DLL_PUBLIC ALWAYS_INLINE double ArrayId_shift(Array<double>& array) {
     return array.shift();
 }
@@ -259,6 +403,30 @@ DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sliceii(const Array<int32_t>& a
     return array.slice(start, end);
 }
 
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_slice(const Array<int64_t>& array) {
+    return array.slice();
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_slice(const Array<uint32_t>& array) {
+    return array.slice();
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_slicei(const Array<int64_t>& array, int32_t start) {
+    return array.slice(start);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_slicei(const Array<uint32_t>& array, int32_t start) {
+    return array.slice(start);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_sliceii(const Array<int64_t>& array, int32_t start, int32_t end) {
+    return array.slice(start, end);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_sliceii(const Array<uint32_t>& array, int32_t start, int32_t end) {
+    return array.slice(start, end);
+}
+
 DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_slice(const Array<double>& array) {
     return array.slice();
 }
@@ -311,6 +479,30 @@ DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_spliceiiPiu(Array<int32_t>& arr
     return array.splice(index, deleteCount, elements, elementsCount);
 }
 
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_splicei(Array<int64_t>& array, int32_t index) {
+    return array.splice(index, array.length());
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_splicei(Array<uint32_t>& array, int32_t index) {
+    return array.splice(index, array.length());
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_spliceii(Array<int64_t>& array, int32_t index, int32_t deleteCount) {
+    return array.splice(index, deleteCount);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_spliceii(Array<uint32_t>& array, int32_t index, int32_t deleteCount) {
+    return array.splice(index, deleteCount);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_spliceiiPlu(Array<int64_t>& array, int32_t index, int32_t deleteCount, int64_t* elements, size_t elementsCount) {
+    return array.splice(index, deleteCount, elements, elementsCount);
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_spliceiiPju(Array<uint32_t>& array, int32_t index, int32_t deleteCount, uint32_t* elements, size_t elementsCount) {
+    return array.splice(index, deleteCount, elements, elementsCount);
+}
+
 DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_splicei(Array<double>& array, int32_t index) {
     return array.splice(index, array.length());
 }
@@ -347,6 +539,14 @@ DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIi_length(const Array<int32_t>& array) {
     return array.length();
 }
 
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIl_length(const Array<int64_t>& array) {
+    return array.length();
+}
+
+DLL_PUBLIC ALWAYS_INLINE int32_t ArrayIj_length(const Array<uint32_t>& array) {
+    return array.length();
+}
+
 DLL_PUBLIC ALWAYS_INLINE int32_t ArrayId_length(const Array<double>& array) {
     return array.length();
 }
@@ -363,6 +563,14 @@ DLL_PUBLIC ALWAYS_INLINE void ArrayIi_lengthi(Array<int32_t>& array, int32_t siz
     array.resize(size);
 }
 
+DLL_PUBLIC ALWAYS_INLINE void ArrayIl_lengthi(Array<int64_t>& array, int32_t size) {
+    array.resize(size);
+}
+
+DLL_PUBLIC ALWAYS_INLINE void ArrayIj_lengthi(Array<uint32_t>& array, int32_t size) {
+    array.resize(size);
+}
+
 DLL_PUBLIC ALWAYS_INLINE void ArrayId_lengthi(Array<double>& array, int32_t size) {
     array.resize(size);
 }
@@ -380,8 +588,8 @@ DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sort(Array<bool>& array) {
     return &array;
 }
 
-typedef double (*BoolComparator)(const bool a, const bool b);
-DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sortPFdbb(Array<bool>& array, BoolComparator comparator) {
+typedef Closure<double, bool, bool> BoolComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<bool>* ArrayIb_sortPFdbb(Array<bool>& array, BoolComparator& comparator) {
     array.sort(comparator);
     return &array;
 }
@@ -391,8 +599,30 @@ DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sort(Array<int32_t>& array) {
     return &array;
 }
 
-typedef double (*IntComparator)(const int32_t a, const int32_t b);
-DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sortPFdii(Array<int32_t>& array, IntComparator comparator) {
+typedef Closure<double, int32_t, int32_t> IntComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<int32_t>* ArrayIi_sortPFdii(Array<int32_t>& array, IntComparator& comparator) {
+    array.sort(comparator);
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_sort(Array<int64_t>& array) {
+    array.sort();
+    return &array;
+}
+
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_sort(Array<uint32_t>& array) {
+    array.sort();
+    return &array;
+}
+
+typedef Closure<double, int64_t, int64_t> LongComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<int64_t>* ArrayIl_sortPFdll(Array<int64_t>& array, LongComparator& comparator) {
+    array.sort(comparator);
+    return &array;
+}
+
+typedef Closure<double, uint32_t, uint32_t> UintComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<uint32_t>* ArrayIj_sortPFdjj(Array<uint32_t>& array, UintComparator& comparator) {
     array.sort(comparator);
     return &array;
 }
@@ -402,8 +632,8 @@ DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sort(Array<double>& array) {
     return &array;
 }
 
-typedef double (*DoubleComparator)(const double a, const double b);
-DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sortPFddd(Array<double>& array, DoubleComparator comparator) {
+typedef Closure<double, double, double> DoubleComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<double>* ArrayId_sortPFddd(Array<double>& array, DoubleComparator& comparator) {
     array.sort(comparator);
     return &array;
 }
@@ -413,8 +643,8 @@ DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sort(Array<void*>& array) {
     return &array;
 }
 
-typedef double (*ObjectComparator)(void* const a, void* const b);
-DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sortPFdPvPv(Array<void*>& array, ObjectComparator comparator) {
+typedef Closure<double, void*, void*> ObjectComparator;
+DLL_PUBLIC ALWAYS_INLINE Array<void*>* ArrayIPv_sortPFdPvPv(Array<void*>& array, ObjectComparator& comparator) {
     array.sort(comparator);
     return &array;
 }
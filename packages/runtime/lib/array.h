@@ -10,6 +10,7 @@
 #include <cstdlib>
 #include <algorithm>
 #include <functional>
+#include "closure.h"
 #include "macros.h"
 
 const int32_t CAPACITY_GROW_FACTOR = 2;
@@ -23,7 +24,8 @@ const int32_t DEFAULT_CAPACITY = 16;
 
 /**
  * Implementation of the JS Array. Grows when more elements are added.
- * int32_t is used as there is no uint32_t in speedyjs.
+ * int32_t is used for lengths and indices as JS allows negative indices for some functions (e.g. slice). get and set
+ * are also provided for uint32_t indices (speedyjs uint) that require no check for negative values.
  *
  * Differences to vector:
  * This Class does use memset to default initialize the elements and not the allocator.
@@ -109,6 +111,21 @@ public:
         return *position;
     }
 
+    /**
+     * Returns the element at the given unsigned index
+     * @param index the index of the element to return
+     * @return the element at the given index or the default value for T if the index is out of bound (only in safe mode)
+     */
+    inline T get(uint32_t index) const {
+ #ifdef SAFE
+        if (index >= size()) {
+            return T {};
+        }
+ #endif
+
+        return begin[index];
+    }
+
     /**
      * Sets the value at the given index position. The array is resized to a length of the index + 1 if index >= length.
      * @param index the index of the element where the value is to be set
@@ -129,6 +146,21 @@ public:
         *position = value;
     }
 
+    /**
+     * Sets the value at the given unsigned index position
+     * @param index the index of the element where the value is to be set
+     * @param value the value to set at the given index
+     */
+    inline void set(uint32_t index, T value) const {
+ #ifdef SAFE
+        if (index >= size()) {
+            throw std::out_of_range("Invalid array index");
+        }
+ #endif
+
+        begin[index] = value;
+    }
+
     inline void fill(const T value, int32_t start=0) const {
         fill(value, start, length());
     }
@@ -159,8 +191,13 @@ public:
         std::sort(begin, back);
     }
 
-    typedef double (*Comparator)(const T a, const T b);
-    inline void sort(Comparator comparator) {
+    typedef Closure<double, T, T> Comparator;
+
+    /**
+     * Sorts the array elements using the given comparator. A negative result of the comparator orders the first
+     * argument before the second.
+     */
+    inline void sort(const Comparator& comparator) {
         std::sort(begin, back, [&comparator](T a, T b) {
             return comparator(a, b) < 0;
         });
@@ -0,0 +1,20 @@
+#ifndef SPEEDYJS_RUNTIME_CLOSURE_H
+#define SPEEDYJS_RUNTIME_CLOSURE_H
+
+/**
+ * A function value passed from Speedy.js code. The record starts with the pointer to the function, the variables
+ * captured by the function are stored after it (the layout is only known to the compiled function).
+ * The function is called with the record itself as first argument to access its captured variables.
+ * @tparam R the return type of the function
+ * @tparam Args the types of the arguments of the function
+ */
+template<typename R, typename... Args>
+struct Closure {
+    R (*fn)(void* environment, Args... args);
+
+    inline R operator()(Args... args) const {
+        return fn(const_cast<Closure*>(this), args...);
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_CLOSURE_H
@@ -1,9 +1,33 @@
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include "macros.h"
 
-const long long TWO_TO_THE_POWER_OF_32 = 4294967296;
-const uint32_t TWO_TO_THE_POWER_OF_31 = 2147483648;
+#ifdef SAFE
+const double TWO_TO_THE_POWER_OF_63 = 9223372036854775808.0;
+
+/**
+ * Slow path of toInt32d and toInt64d for values outside of the int64 range, NaN and +-Infinity.
+ * The values are integers that are a multiple of 2^11, therefore, the low 64 bits can be extracted from the mantissa.
+ */
+static uint64_t lowBitsOutOfRange(double value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(double));
+
+    // value = mantissa * 2^exponent
+    const int32_t exponent = static_cast<int32_t>(bits >> 52 & 0x7ff) - 1075;
+
+    // multiples of 2^64 as well as NaN and +-Infinity (maximum exponent) are converted to 0
+    if (exponent >= 64) {
+        return 0;
+    }
+
+    const uint64_t mantissa = (bits & ((1ULL << 52) - 1)) | (1ULL << 52);
+    const uint64_t low = mantissa << exponent;
+
+    return bits >> 63 ? 0ULL - low : low;
+}
+#endif
 
 extern "C" {
 
@@ -14,20 +38,33 @@ extern "C" {
  */
 DLL_PUBLIC ALWAYS_INLINE int32_t toInt32d(double value) {
 #ifdef SAFE
-    if (std::isnan(value) || std::isinf(value)) {
-        return 0;
+    // Values in the int64 range are truncated to int64 and wrapped to the lower 32 bits, the comparison is false for NaN
+    if (std::abs(value) < TWO_TO_THE_POWER_OF_63) {
+        return static_cast<int32_t>(static_cast<uint32_t>(static_cast<int64_t>(value)));
     }
 
-    int64_t posInt = static_cast<int64_t>(std::copysign(std::floor(std::abs(value)), value));
-    uint32_t int32bit = static_cast<uint32_t>(posInt - (TWO_TO_THE_POWER_OF_32 * (posInt/TWO_TO_THE_POWER_OF_32)));
+    return static_cast<int32_t>(static_cast<uint32_t>(lowBitsOutOfRange(value)));
+#else
+    return static_cast<int32_t>(value);
+#endif
+}
 
-    if (int32bit >= TWO_TO_THE_POWER_OF_31) {
-        return static_cast<int32_t>(int32bit - TWO_TO_THE_POWER_OF_32);
+/**
+ * Converts the double to an int64 by truncating the fraction and wrapping the integer to the int64 range,
+ * the same as BigInt.asIntN(64, BigInt(Math.trunc(value))). NaN and +-Infinity are converted to 0.
+ * @param the value to convert
+ * @returns the double as int64_t
+ */
+DLL_PUBLIC ALWAYS_INLINE int64_t toInt64d(double value) {
+#ifdef SAFE
+    if (std::abs(value) < TWO_TO_THE_POWER_OF_63) {
+        return static_cast<int64_t>(value);
     }
-    return int32bit;
+
+    return static_cast<int64_t>(lowBitsOutOfRange(value));
 #else
-    return static_cast<int32_t>(value);
+    return static_cast<int64_t>(value);
 #endif
 }
 
-}
\ No newline at end of file
+}
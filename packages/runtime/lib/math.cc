@@ -1,10 +1,84 @@
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <algorithm>
 #include "macros.h"
 
+/**
+ * State of the xorshift128+ generator used by Math.random. The state is stored in the linear memory and therefore, each
+ * module instance has its own generator.
+ */
+struct RandomState {
+    uint64_t state0;
+    uint64_t state1;
+};
+
+static RandomState randomState { 0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL };
+
+static inline uint64_t splitMix64(uint64_t& x) {
+    uint64_t z = (x += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+/**
+ * Reduces the values to a single value by keeping the preferred one of each pair. Four independent accumulators are
+ * used so that the iterations do not depend on each other and the loop can be vectorized (two f64 or four i32 per lane)
+ * and pipelined. The preferred function needs to be associative and commutative.
+ */
+template<typename T, typename Preferred>
+static inline T reduce(const T* values, size_t valueCount, T initial, Preferred preferred) {
+    T accumulator0 = initial;
+    T accumulator1 = initial;
+    T accumulator2 = initial;
+    T accumulator3 = initial;
+    size_t i = 0;
+
+    for (; i + 4 <= valueCount; i += 4) {
+        accumulator0 = preferred(values[i], accumulator0);
+        accumulator1 = preferred(values[i + 1], accumulator1);
+        accumulator2 = preferred(values[i + 2], accumulator2);
+        accumulator3 = preferred(values[i + 3], accumulator3);
+    }
+
+    for (; i < valueCount; ++i) {
+        accumulator0 = preferred(values[i], accumulator0);
+    }
+
+    return preferred(preferred(accumulator0, accumulator1), preferred(accumulator2, accumulator3));
+}
+
+/**
+ * Returns the larger of the two values. A NaN value is sticky, once an accumulator is NaN, it remains NaN.
+ */
+static inline double maxOrNaN(double value, double accumulator) {
+    return value > accumulator || value != value ? value : accumulator;
+}
+
+static inline double minOrNaN(double value, double accumulator) {
+    return value < accumulator || value != value ? value : accumulator;
+}
+
+/**
+ * Tests if the values contain a zero with the given sign. The comparison used in the reduction considers -0 and +0 as
+ * equal, this check is only needed in the rare case that the result of the reduction is zero.
+ */
+static inline bool containsZero(const double* values, size_t valueCount, bool negative) {
+    for (size_t i = 0; i < valueCount; ++i) {
+        if (values[i] == 0 && std::signbit(values[i]) == negative) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 extern "C" {
 
+// Defined in conversion.cc
+int32_t toInt32d(double value);
+
 // The math ptr is passed so that Math does not require a different call semantics than other objects (that this is
 // not used is an implementation internal that should not be known by the compiler). As all functions are inlined,
 // the unneeded load of the math object is removed
@@ -13,11 +87,130 @@ ALWAYS_INLINE DLL_PUBLIC bool isNaNd(double value) {
     return std::isnan(value);
 }
 
+/**
+ * Computes the remainder of x / y with the semantics of the JavaScript % operator (equal to C's fmod).
+ * Implemented using integer operations on the IEEE 754 representation as web assembly has no remainder instruction
+ * for floating point numbers and the libc fmod would be imported from JavaScript.
+ */
+ALWAYS_INLINE DLL_PUBLIC double fmoddd(double x, double y) {
+    uint64_t xBits;
+    uint64_t yBits;
+    std::memcpy(&xBits, &x, sizeof(double));
+    std::memcpy(&yBits, &y, sizeof(double));
+
+    int32_t xExponent = static_cast<int32_t>(xBits >> 52 & 0x7ff);
+    int32_t yExponent = static_cast<int32_t>(yBits >> 52 & 0x7ff);
+    const uint64_t sign = xBits & (1ULL << 63);
+
+    if (yBits << 1 == 0 || std::isnan(y) || xExponent == 0x7ff) {
+        return (x * y) / (x * y);
+    }
+
+    if (xBits << 1 <= yBits << 1) {
+        return xBits << 1 == yBits << 1 ? 0 * x : x;
+    }
+
+    // normalize the mantissas (and the exponents of subnormal numbers)
+    if (xExponent == 0) {
+        for (uint64_t i = xBits << 12; i >> 63 == 0; --xExponent, i <<= 1) {}
+        xBits <<= -xExponent + 1;
+    } else {
+        xBits &= -1ULL >> 12;
+        xBits |= 1ULL << 52;
+    }
+
+    if (yExponent == 0) {
+        for (uint64_t i = yBits << 12; i >> 63 == 0; --yExponent, i <<= 1) {}
+        yBits <<= -yExponent + 1;
+    } else {
+        yBits &= -1ULL >> 12;
+        yBits |= 1ULL << 52;
+    }
+
+    // long division of the mantissas
+    for (; xExponent > yExponent; --xExponent) {
+        const uint64_t difference = xBits - yBits;
+        if (difference >> 63 == 0) {
+            if (difference == 0) {
+                return 0 * x;
+            }
+            xBits = difference;
+        }
+        xBits <<= 1;
+    }
+
+    const uint64_t difference = xBits - yBits;
+    if (difference >> 63 == 0) {
+        if (difference == 0) {
+            return 0 * x;
+        }
+        xBits = difference;
+    }
+
+    for (; xBits >> 52 == 0; xBits <<= 1, --xExponent) {}
+
+    // scale the result
+    if (xExponent > 0) {
+        xBits -= 1ULL << 52;
+        xBits |= static_cast<uint64_t>(xExponent) << 52;
+    } else {
+        xBits >>= -xExponent + 1;
+    }
+
+    xBits |= sign;
+
+    double result;
+    std::memcpy(&result, &xBits, sizeof(double));
+    return result;
+}
+
 ALWAYS_INLINE DLL_PUBLIC double Math_PI(__attribute__((unused)) void* math) {
     return M_PI;
 }
 
+ALWAYS_INLINE DLL_PUBLIC double Math_E(__attribute__((unused)) void* math) {
+    return M_E;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_LN10(__attribute__((unused)) void* math) {
+    return M_LN10;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_LN2(__attribute__((unused)) void* math) {
+    return M_LN2;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_LOG10E(__attribute__((unused)) void* math) {
+    return M_LOG10E;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_LOG2E(__attribute__((unused)) void* math) {
+    return M_LOG2E;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_SQRT1_2(__attribute__((unused)) void* math) {
+    return M_SQRT1_2;
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_SQRT2(__attribute__((unused)) void* math) {
+    return M_SQRT2;
+}
+
 ALWAYS_INLINE DLL_PUBLIC double Math_powdd(__attribute__((unused)) void* math, double base, double power) {
+    // Only the powers that are exact or correctly rounded (base * base) are computed in module. Repeated squaring
+    // accumulates rounding errors for other exponents, these call the imported pow function to match JavaScript
+    if (power == 0.0) {
+        return 1.0;
+    }
+
+    if (power == 1.0) {
+        return base;
+    }
+
+    if (power == 2.0) {
+        return base * base;
+    }
+
     return std::pow(base, power);
 }
 
@@ -38,50 +231,205 @@ ALWAYS_INLINE DLL_PUBLIC double_t Math_logd(__attribute__((unused)) void* math,
 }
 
 ALWAYS_INLINE DLL_PUBLIC double Math_maxPdu(__attribute__((unused)) void* math, double* values, size_t valueCount) {
-    double max = -INFINITY;
+    const double max = reduce<double>(values, valueCount, -INFINITY, maxOrNaN);
 
-    for (size_t i = 0; i < valueCount; ++i) {
-        max = std::max(values[i], max);
+    if (max == 0 && std::signbit(max) && containsZero(values, valueCount, false)) {
+        return 0.0;
     }
 
     return max;
 }
 
 ALWAYS_INLINE DLL_PUBLIC int32_t Math_maxPiu(__attribute__((unused)) void* math, int32_t* values, size_t valueCount) {
-    int32_t max = -2147483648;
-
-    for (size_t i = 0; i < valueCount; ++i) {
-        max = std::max(values[i], max);
-    }
-
-    return max;
+    return reduce(values, valueCount, INT32_MIN, [](int32_t value, int32_t accumulator) {
+        return std::max(value, accumulator);
+    });
 }
 
 ALWAYS_INLINE DLL_PUBLIC double Math_minPdu(__attribute__((unused)) void* math, double* values, size_t valueCount) {
-    double min = INFINITY;
+    const double min = reduce<double>(values, valueCount, INFINITY, minOrNaN);
 
-    for (size_t i = 0; i < valueCount; ++i) {
-        min = std::min(values[i], min);
+    if (min == 0 && !std::signbit(min) && containsZero(values, valueCount, true)) {
+        return -0.0;
     }
 
     return min;
 }
 
 ALWAYS_INLINE DLL_PUBLIC int32_t Math_minPiu(__attribute__((unused)) void* math, int32_t* values, size_t valueCount) {
-    int32_t min = 2147483647;
+    return reduce(values, valueCount, INT32_MAX, [](int32_t value, int32_t accumulator) {
+        return std::min(value, accumulator);
+    });
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_floord(__attribute__((unused)) void* math, double value) {
+    return std::floor(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_roundd(__attribute__((unused)) void* math, double value) {
+    // rint maps to f64.nearest that rounds ties to even, whereas JavaScript rounds ties towards +Infinity
+    const double nearest = std::rint(value);
+    return value - nearest == 0.5 ? nearest + 1.0 : nearest;
+}
+
+// Functions with a web assembly instruction (abs, ceil, trunc, copysign, clz) are compiled to the llvm intrinsics
+// and, therefore, are inlined as a single instruction. The transcendental functions are provided by the musl libc
+// that is linked with the runtime.
+
+ALWAYS_INLINE DLL_PUBLIC double Math_absd(__attribute__((unused)) void* math, double value) {
+    return std::fabs(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_ceild(__attribute__((unused)) void* math, double value) {
+    return std::ceil(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_truncd(__attribute__((unused)) void* math, double value) {
+    return std::trunc(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_signd(__attribute__((unused)) void* math, double value) {
+    // returns NaN for NaN and preserves the sign of +-0
+    return value > 0 ? 1.0 : (value < 0 ? -1.0 : value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_froundd(__attribute__((unused)) void* math, double value) {
+    return static_cast<double>(static_cast<float>(value));
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_clz32d(__attribute__((unused)) void* math, double value) {
+    const uint32_t bits = static_cast<uint32_t>(toInt32d(value));
+    return bits == 0 ? 32 : __builtin_clz(bits);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_imuldd(__attribute__((unused)) void* math, double a, double b) {
+    const uint32_t product = static_cast<uint32_t>(toInt32d(a)) * static_cast<uint32_t>(toInt32d(b));
+    return static_cast<int32_t>(product);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_hypotPdu(__attribute__((unused)) void* math, double* values, size_t valueCount) {
+    // Scale by the largest magnitude to avoid an overflow or underflow of the intermediate sum
+    double max = 0;
+    bool hasNaN = false;
 
     for (size_t i = 0; i < valueCount; ++i) {
-        min = std::min(values[i], min);
+        const double magnitude = std::fabs(values[i]);
+        if (std::isinf(magnitude)) {
+            return INFINITY;
+        }
+
+        hasNaN = hasNaN || std::isnan(magnitude);
+        max = std::max(max, magnitude);
     }
 
-    return min;
+    if (hasNaN) {
+        return NAN;
+    }
+
+    if (max == 0) {
+        return 0;
+    }
+
+    double sum = 0;
+    for (size_t i = 0; i < valueCount; ++i) {
+        const double scaled = values[i] / max;
+        sum += scaled * scaled;
+    }
+
+    return max * std::sqrt(sum);
 }
 
-ALWAYS_INLINE DLL_PUBLIC double Math_floord(__attribute__((unused)) void* math, double value) {
-    return std::floor(value);
+/**
+ * Returns a random number in the range [0, 1) using the xorshift128+ generator
+ */
+ALWAYS_INLINE DLL_PUBLIC double Math_randomd(__attribute__((unused)) void* math) {
+    uint64_t s1 = randomState.state0;
+    const uint64_t s0 = randomState.state1;
+
+    randomState.state0 = s0;
+    s1 ^= s1 << 23;
+    randomState.state1 = s1 ^ s0 ^ (s1 >> 17) ^ (s0 >> 26);
+
+    // use the upper 53 bits as the mantissa
+    return static_cast<double>((randomState.state1 + s0) >> 11) * (1.0 / 9007199254740992.0);
 }
 
-ALWAYS_INLINE DLL_PUBLIC double Math_roundd(__attribute__((unused)) void* math, double value) {
-    return std::round(value);
+/**
+ * Seeds the generator used by Math.random. The generator returns the same sequence of numbers for the same seed.
+ * @param seed the seed
+ */
+ALWAYS_INLINE DLL_PUBLIC void speedyJsSeedRandomi(int32_t seed) {
+    // Use splitmix64 to derive the state from the seed, it never returns zero for both state values
+    uint64_t x = static_cast<uint32_t>(seed);
+    randomState.state0 = splitMix64(x);
+    randomState.state1 = splitMix64(x);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_expd(__attribute__((unused)) void* math, double value) {
+    return std::exp(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_expm1d(__attribute__((unused)) void* math, double value) {
+    return std::expm1(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_log1pd(__attribute__((unused)) void* math, double value) {
+    return std::log1p(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_log10d(__attribute__((unused)) void* math, double value) {
+    return std::log10(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_log2d(__attribute__((unused)) void* math, double value) {
+    return std::log2(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_cbrtd(__attribute__((unused)) void* math, double value) {
+    return std::cbrt(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_tand(__attribute__((unused)) void* math, double value) {
+    return std::tan(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_asind(__attribute__((unused)) void* math, double value) {
+    return std::asin(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_acosd(__attribute__((unused)) void* math, double value) {
+    return std::acos(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_atand(__attribute__((unused)) void* math, double value) {
+    return std::atan(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_atan2dd(__attribute__((unused)) void* math, double y, double x) {
+    return std::atan2(y, x);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_sinhd(__attribute__((unused)) void* math, double value) {
+    return std::sinh(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_coshd(__attribute__((unused)) void* math, double value) {
+    return std::cosh(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_tanhd(__attribute__((unused)) void* math, double value) {
+    return std::tanh(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_asinhd(__attribute__((unused)) void* math, double value) {
+    return std::asinh(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_acoshd(__attribute__((unused)) void* math, double value) {
+    return std::acosh(value);
+}
+
+ALWAYS_INLINE DLL_PUBLIC double Math_atanhd(__attribute__((unused)) void* math, double value) {
+    return std::atanh(value);
 }
 }
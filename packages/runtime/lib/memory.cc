@@ -6,6 +6,7 @@
 #include <array>
 #include <cassert>
 #include "macros.h"
+#include "scratch-arena.h"
 
 struct CollectedPointers {
     std::array<void*, 10000> pointers;
@@ -15,6 +16,8 @@ struct CollectedPointers {
     {}
 };
 
+static ScratchArena scratchArena {};
+
 extern "C" {
 
 extern void malloc_inspect_all(void(*handler)(void*, void *, size_t, void*), void* arg);
@@ -23,7 +26,7 @@ extern size_t bulk_free(void**, size_t n_elements);
 ALWAYS_INLINE void collectPointers(void* start, void*, size_t used_bytes, void* callback_arg) {
     auto collectedPointers = static_cast<CollectedPointers*>(callback_arg);
 
-    if (used_bytes > 0 && collectedPointers->count < collectedPointers->pointers.size()) {
+    if (used_bytes > 0 && collectedPointers->count < collectedPointers->pointers.size() && !ScratchArena::isSlab(start, used_bytes)) {
         collectedPointers->pointers[collectedPointers->count++] = start;
     }
 }
@@ -41,6 +44,19 @@ DLL_PUBLIC ALWAYS_INLINE void speedyJsGc() {
         auto released = bulk_free(collectedPointers.pointers.data(), collectedPointers.count);
         assert(released == 0 && "Not all pointers freed by bulk_free");
     } while (collectedPointers.count >= collectedPointers.pointers.size());
+
+    // Recycle the slabs of the scratch arena for the next call
+    scratchArena.reset();
+}
+
+/**
+ * Allocates an object in the scratch arena (warm heap). The memory is released by the next call to speedyJsGc, however,
+ * the slabs are not returned to malloc but are reused by the subsequent allocations.
+ * @param size the size of the object in bytes
+ * @return pointer to the allocated memory
+ */
+DLL_PUBLIC ALWAYS_INLINE void* speedyJsScratchAlloc(size_t size) {
+    return scratchArena.allocate(size);
 }
 
 // Probably malloc can be overriden and use emscripten_builtin_malloc to have a custom malloc version
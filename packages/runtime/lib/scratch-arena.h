@@ -0,0 +1,117 @@
+#ifndef SPEEDYJS_RUNTIME_SCRATCH_ARENA_H
+#define SPEEDYJS_RUNTIME_SCRATCH_ARENA_H
+
+#include <cstdlib>
+#include <cstdint>
+#include <algorithm>
+
+const size_t SCRATCH_SLAB_SIZE = 64 * 1024;
+const size_t SCRATCH_ALIGNMENT = 16;
+const uintptr_t SCRATCH_SLAB_TAG = static_cast<uintptr_t>(0x5c7a7c4a5c7a7c4aULL);
+
+/**
+ * A slab of the scratch arena. The memory used for allocations follows the slab header, aligned to SCRATCH_ALIGNMENT.
+ * The tag is derived from the address and size of the slab and identifies a malloc chunk as slab without walking the
+ * slab list.
+ */
+struct ScratchSlab {
+    ScratchSlab* next;
+    size_t size;
+    uintptr_t tag;
+
+    inline char* begin() {
+        auto address = reinterpret_cast<uintptr_t>(this) + sizeof(ScratchSlab);
+        return reinterpret_cast<char*>((address + SCRATCH_ALIGNMENT - 1) & ~(SCRATCH_ALIGNMENT - 1));
+    }
+
+    inline char* end() {
+        return begin() + size;
+    }
+
+    static inline uintptr_t tagOf(const ScratchSlab* slab) {
+        return reinterpret_cast<uintptr_t>(slab) ^ slab->size ^ SCRATCH_SLAB_TAG;
+    }
+};
+
+/**
+ * Arena used for objects allocated by speedy.js code if the warm heap is enabled. The slabs are allocated once and are
+ * retained when the arena is reset. Only the bump pointer is reset, so that the objects allocated by the next call
+ * reuse the slabs without going through malloc.
+ */
+struct ScratchArena {
+    ScratchSlab* first;
+    ScratchSlab* current;
+    char* top;
+
+    ScratchArena() : first { nullptr }, current { nullptr }, top { nullptr }
+    {}
+
+    /**
+     * Allocates size bytes aligned to SCRATCH_ALIGNMENT
+     * @param size the size of the object in bytes
+     * @return pointer to the allocated memory or the nullptr if no new slab could be allocated
+     */
+    void* allocate(size_t size) {
+        size = (size + SCRATCH_ALIGNMENT - 1) & ~(SCRATCH_ALIGNMENT - 1);
+
+        ScratchSlab* slab = current;
+        while (slab == nullptr || top + size > slab->end()) {
+            ScratchSlab* next = slab == nullptr ? first : slab->next;
+
+            if (next == nullptr || next->size < size) {
+                // Allocate a new slab and insert it after the current one. Large objects get a slab of their own
+                const size_t slabSize = std::max(SCRATCH_SLAB_SIZE, size);
+                auto newSlab = static_cast<ScratchSlab*>(std::malloc(sizeof(ScratchSlab) + SCRATCH_ALIGNMENT - 1 + slabSize));
+
+                if (newSlab == nullptr) {
+                    return nullptr;
+                }
+
+                newSlab->size = slabSize;
+                newSlab->next = next;
+                newSlab->tag = ScratchSlab::tagOf(newSlab);
+
+                if (slab == nullptr) {
+                    first = newSlab;
+                } else {
+                    slab->next = newSlab;
+                }
+
+                next = newSlab;
+            }
+
+            slab = next;
+            current = slab;
+            top = slab->begin();
+        }
+
+        void* result = top;
+        top += size;
+        return result;
+    }
+
+    /**
+     * Releases all objects allocated in the arena but keeps the slabs for the subsequent allocations
+     */
+    void reset() {
+        current = first;
+        top = first == nullptr ? nullptr : first->begin();
+    }
+
+    /**
+     * Tests if the malloc chunk starting at the given address is a slab of a scratch arena in constant time.
+     * A chunk is only taken for a slab if its first words hold the size of the chunk and the tag of its own address.
+     * @param pointer the start of the chunk
+     * @param chunkSize the usable size of the chunk
+     */
+    static bool isSlab(void* pointer, size_t chunkSize) {
+        if (chunkSize < sizeof(ScratchSlab)) {
+            return false;
+        }
+
+        auto slab = static_cast<ScratchSlab*>(pointer);
+        return slab->tag == ScratchSlab::tagOf(slab) && chunkSize >= sizeof(ScratchSlab) + SCRATCH_ALIGNMENT - 1 + slab->size;
+    }
+};
+
+#endif //SPEEDYJS_RUNTIME_SCRATCH_ARENA_H
@@ -103,6 +103,15 @@ TEST_F(ArrayTests, get_for_object_array) {
     delete array3;
 }
 
+TEST_F(ArrayTests, get_with_an_unsigned_index_returns_the_default_value_if_the_index_is_out_of_bound) {
+    double elements[2] = { 1.5, 2.5 };
+    array = new Array<double>(elements, 2);
+
+    EXPECT_EQ(array->get(1U), 2.5);
+    EXPECT_EQ(array->get(2U), 0);
+    EXPECT_EQ(array->get(4294967295U), 0);
+}
+
 // -----------------------------------------
 // SET
 // -----------------------------------------
@@ -132,6 +141,16 @@ TEST_F(ArrayTests, set_throws_if_the_index_is_negative) {
     EXPECT_THROW(array->set(-3, 34), std::out_of_range);
 }
 
+TEST_F(ArrayTests, set_with_an_unsigned_index_throws_if_the_index_is_out_of_range) {
+    array = new Array<double>(5);
+
+    array->set(4U, 34);
+
+    EXPECT_EQ(array->get(4), 34);
+    EXPECT_THROW(array->set(5U, 34), std::out_of_range);
+    EXPECT_THROW(array->set(4294967295U, 34), std::out_of_range);
+}
+
 // -----------------------------------------
 // resize
 // -----------------------------------------
@@ -740,10 +759,12 @@ TEST_F(ArrayTests, sort_uses_the_given_comparator) {
     double elements[5] = { 8.3, 2.3, 48.53, 28.4, 21.2 };
     array = new Array<double>(elements, 5);
 
-    // act
-    array->sort([](double a, double b) {
+    Closure<double, double, double> comparator = { [](void*, double a, double b) {
         return b - a;
-    });
+    } };
+
+    // act
+    array->sort(comparator);
 
     // expect
     EXPECT_EQ(array->get(0), 48.53);
@@ -751,4 +772,17 @@ TEST_F(ArrayTests, sort_uses_the_given_comparator) {
     EXPECT_EQ(array->get(2), 21.2);
     EXPECT_EQ(array->get(3), 8.3);
     EXPECT_EQ(array->get(4), 2.3);
-}
\ No newline at end of file
+}
+TEST_F(ArrayTests, sort_compares_int64_elements_exactly) {
+    // 2^53 + 1 and 2^53 are equal when converted to double
+    int64_t elements[3] = { 9007199254740993, -3, 9007199254740992 };
+    Array<int64_t> longArray { elements, 3 };
+
+    // act
+    longArray.sort();
+
+    // expect
+    EXPECT_EQ(longArray.get(0), -3);
+    EXPECT_EQ(longArray.get(1), 9007199254740992);
+    EXPECT_EQ(longArray.get(2), 9007199254740993);
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include "gtest/gtest.h"
+
+extern "C" {
+int32_t toInt32d(double value);
+int64_t toInt64d(double value);
+}
+
+// -----------------------------------------
+// toInt32d, expected values are the results of JavaScript's ToInt32 (value | 0)
+// -----------------------------------------
+
+TEST(ConversionTests, toInt32d_converts_nan_to_zero) {
+    EXPECT_EQ(toInt32d(std::numeric_limits<double>::quiet_NaN()), 0);
+}
+
+TEST(ConversionTests, toInt32d_converts_infinity_to_zero) {
+    EXPECT_EQ(toInt32d(std::numeric_limits<double>::infinity()), 0);
+    EXPECT_EQ(toInt32d(-std::numeric_limits<double>::infinity()), 0);
+}
+
+TEST(ConversionTests, toInt32d_converts_signed_zero_to_zero) {
+    EXPECT_EQ(toInt32d(0.0), 0);
+    EXPECT_EQ(toInt32d(-0.0), 0);
+}
+
+TEST(ConversionTests, toInt32d_truncates_the_fraction) {
+    EXPECT_EQ(toInt32d(1.5), 1);
+    EXPECT_EQ(toInt32d(-1.5), -1);
+}
+
+TEST(ConversionTests, toInt32d_wraps_two_to_the_power_of_31) {
+    EXPECT_EQ(toInt32d(2147483648.0), -2147483647 - 1);
+    EXPECT_EQ(toInt32d(-2147483648.0), -2147483647 - 1);
+}
+
+TEST(ConversionTests, toInt32d_wraps_two_to_the_power_of_32) {
+    EXPECT_EQ(toInt32d(4294967296.0), 0);
+    EXPECT_EQ(toInt32d(-4294967296.0), 0);
+    EXPECT_EQ(toInt32d(4294967297.5), 1);
+}
+
+TEST(ConversionTests, toInt32d_wraps_values_beyond_the_safe_integer_range) {
+    // 2^53 + 1 is not representable and rounds to 2^53
+    EXPECT_EQ(toInt32d(9007199254740993.0), 0);
+    EXPECT_EQ(toInt32d(9007199254740994.0), 2);
+}
+
+TEST(ConversionTests, toInt32d_wraps_values_outside_of_the_int64_range) {
+    EXPECT_EQ(toInt32d(9223372036854775808.0), 0);
+    EXPECT_EQ(toInt32d(1e300), 0);
+    EXPECT_EQ(toInt32d(-1e300), 0);
+    EXPECT_EQ(toInt32d(1e20), 1661992960);
+    EXPECT_EQ(toInt32d(-1e20), -1661992960);
+}
+
+// -----------------------------------------
+// toInt64d
+// -----------------------------------------
+
+TEST(ConversionTests, toInt64d_converts_nan_and_infinity_to_zero) {
+    EXPECT_EQ(toInt64d(std::numeric_limits<double>::quiet_NaN()), 0);
+    EXPECT_EQ(toInt64d(std::numeric_limits<double>::infinity()), 0);
+    EXPECT_EQ(toInt64d(-std::numeric_limits<double>::infinity()), 0);
+}
+
+TEST(ConversionTests, toInt64d_truncates_values_in_the_int64_range) {
+    EXPECT_EQ(toInt64d(-1.5), -1);
+    EXPECT_EQ(toInt64d(9007199254740992.0), 9007199254740992LL);
+    EXPECT_EQ(toInt64d(-9223372036854775808.0), INT64_MIN);
+}
+
+TEST(ConversionTests, toInt64d_wraps_values_outside_of_the_int64_range) {
+    EXPECT_EQ(toInt64d(9223372036854775808.0), INT64_MIN);
+    EXPECT_EQ(toInt64d(18446744073709551616.0), 0);
+    EXPECT_EQ(toInt64d(1e20), 7766279631452241920LL);
+    EXPECT_EQ(toInt64d(-1e20), -7766279631452241920LL);
+    EXPECT_EQ(toInt64d(1e300), 0);
+}
@@ -0,0 +1,156 @@
+#include <vector>
+#include "gtest/gtest.h"
+#include "../lib/scratch-arena.h"
+
+class ScratchArenaTests: public ::testing::Test {
+public:
+    ScratchArena arena;
+
+    void TearDown() {
+        ScratchSlab* slab = arena.first;
+        while (slab != nullptr) {
+            ScratchSlab* next = slab->next;
+            std::free(slab);
+            slab = next;
+        }
+    }
+
+    size_t slabCount() {
+        size_t count = 0;
+        for (ScratchSlab* slab = arena.first; slab != nullptr; slab = slab->next) {
+            ++count;
+        }
+        return count;
+    }
+};
+
+static bool isAligned(void* pointer) {
+    return reinterpret_cast<uintptr_t>(pointer) % SCRATCH_ALIGNMENT == 0;
+}
+
+// -----------------------------------------
+// allocate
+// -----------------------------------------
+
+TEST_F(ScratchArenaTests, allocate_aligns_the_allocations) {
+    for (size_t size : { 1, 3, 8, 12, 16, 17, 100 }) {
+        void* allocation = arena.allocate(size);
+
+        ASSERT_NE(allocation, nullptr);
+        EXPECT_TRUE(isAligned(allocation)) << "allocation of " << size << " bytes is not aligned";
+    }
+}
+
+TEST_F(ScratchArenaTests, allocate_aligns_the_first_allocation_of_a_slab) {
+    void* first = arena.allocate(8);
+
+    EXPECT_TRUE(isAligned(first));
+    EXPECT_EQ(static_cast<char*>(first), arena.first->begin());
+    EXPECT_GE(static_cast<char*>(first), reinterpret_cast<char*>(arena.first) + sizeof(ScratchSlab));
+}
+
+TEST_F(ScratchArenaTests, allocate_does_not_overlap_allocations) {
+    auto first = static_cast<char*>(arena.allocate(20));
+    auto second = static_cast<char*>(arena.allocate(20));
+
+    EXPECT_GE(second, first + 20);
+}
+
+TEST_F(ScratchArenaTests, allocate_allocates_a_new_slab_if_the_current_slab_is_full) {
+    arena.allocate(SCRATCH_SLAB_SIZE - SCRATCH_ALIGNMENT);
+    void* allocation = arena.allocate(2 * SCRATCH_ALIGNMENT);
+
+    EXPECT_EQ(slabCount(), 2u);
+    EXPECT_EQ(static_cast<char*>(allocation), arena.current->begin());
+    EXPECT_TRUE(isAligned(allocation));
+}
+
+TEST_F(ScratchArenaTests, allocate_allocates_a_slab_of_its_own_for_large_objects) {
+    void* allocation = arena.allocate(SCRATCH_SLAB_SIZE * 3);
+
+    ASSERT_NE(allocation, nullptr);
+    EXPECT_TRUE(isAligned(allocation));
+    EXPECT_EQ(arena.current->size, SCRATCH_SLAB_SIZE * 3);
+    EXPECT_LE(static_cast<char*>(allocation) + SCRATCH_SLAB_SIZE * 3, arena.current->end());
+}
+
+// -----------------------------------------
+// reset (warm heap)
+// -----------------------------------------
+
+TEST_F(ScratchArenaTests, reset_reuses_the_memory_of_the_previous_allocations) {
+    void* first = arena.allocate(32);
+    void* second = arena.allocate(48);
+
+    arena.reset();
+
+    EXPECT_EQ(arena.allocate(32), first);
+    EXPECT_EQ(arena.allocate(48), second);
+    EXPECT_EQ(slabCount(), 1u);
+}
+
+TEST_F(ScratchArenaTests, reset_keeps_the_slabs_for_the_subsequent_calls) {
+    std::vector<void*> allocations;
+    for (int i = 0; i < 3; ++i) {
+        allocations.push_back(arena.allocate(SCRATCH_SLAB_SIZE / 2 + SCRATCH_ALIGNMENT));
+    }
+    ASSERT_EQ(slabCount(), 3u);
+
+    for (int call = 0; call < 5; ++call) {
+        arena.reset();
+
+        for (int i = 0; i < 3; ++i) {
+            EXPECT_EQ(arena.allocate(SCRATCH_SLAB_SIZE / 2 + SCRATCH_ALIGNMENT), allocations[i]);
+        }
+    }
+
+    EXPECT_EQ(slabCount(), 3u);
+}
+
+TEST_F(ScratchArenaTests, reset_inserts_a_larger_slab_if_a_retained_slab_is_too_small) {
+    arena.allocate(16);
+    ScratchSlab* small = arena.first;
+    arena.reset();
+
+    void* large = arena.allocate(SCRATCH_SLAB_SIZE * 2);
+
+    EXPECT_EQ(slabCount(), 2u);
+    EXPECT_EQ(arena.first, small);
+    EXPECT_EQ(arena.first->next, arena.current);
+    EXPECT_EQ(static_cast<char*>(large), arena.current->begin());
+}
+
+TEST_F(ScratchArenaTests, reset_an_empty_arena) {
+    arena.reset();
+
+    EXPECT_EQ(arena.current, nullptr);
+    EXPECT_TRUE(isAligned(arena.allocate(8)));
+}
+
+// -----------------------------------------
+// isSlab
+// -----------------------------------------
+
+TEST_F(ScratchArenaTests, isSlab_returns_true_for_slabs) {
+    arena.allocate(16);
+    arena.allocate(SCRATCH_SLAB_SIZE * 2);
+
+    for (ScratchSlab* slab = arena.first; slab != nullptr; slab = slab->next) {
+        EXPECT_TRUE(ScratchArena::isSlab(slab, sizeof(ScratchSlab) + SCRATCH_ALIGNMENT - 1 + slab->size));
+    }
+}
+
+TEST_F(ScratchArenaTests, isSlab_returns_false_for_other_chunks) {
+    ScratchSlab chunk[2] {};
+    EXPECT_FALSE(ScratchArena::isSlab(chunk, sizeof(chunk)));
+
+    EXPECT_FALSE(ScratchArena::isSlab(chunk, sizeof(ScratchSlab) - 1));
+}
+
+TEST_F(ScratchArenaTests, isSlab_returns_false_if_the_chunk_is_smaller_than_the_slab) {
+    ScratchSlab chunk[2] {};
+    chunk[0].size = SCRATCH_SLAB_SIZE;
+    chunk[0].tag = ScratchSlab::tagOf(&chunk[0]);
+
+    EXPECT_FALSE(ScratchArena::isSlab(chunk, sizeof(chunk)));
+}